@@ -0,0 +1,78 @@
+// allocation_hook.cpp
+// 替换全局 operator new / delete，把每次分配记入 AllocationTracker
+// 只链接进需要分配计数的程序（fwa_baseline），不进入动态库：替换是整个程序范围的
+#include "allocation_tracker.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+    struct HookInstaller {
+        HookInstaller() { AllocationTracker::install(); }
+    } g_hook_installer;
+
+    void* allocate(size_t size) {
+        if (size == 0) size = 1;
+        for (;;) {
+            void* p = std::malloc(size);
+            if (p) {
+                AllocationTracker::record(size);
+                return p;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+
+    void* allocateAligned(size_t size, std::align_val_t alignment) {
+        size_t align = static_cast<size_t>(alignment);
+        if (size == 0) size = 1;
+        // aligned_alloc 要求大小是对齐的整数倍
+        size_t rounded = (size + align - 1) / align * align;
+        for (;;) {
+            void* p = std::aligned_alloc(align, rounded);
+            if (p) {
+                AllocationTracker::record(size);
+                return p;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler) throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void* operator new(size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateAligned(size, alignment); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); }
+    catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return allocate(size); }
+    catch (...) { return nullptr; }
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(size, alignment); }
+    catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try { return allocateAligned(size, alignment); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { std::free(p); }
@@ -0,0 +1,26 @@
+// allocation_tracker.cpp
+#include "allocation_tracker.h"
+#include <atomic>
+
+namespace {
+    std::atomic<bool> g_installed(false);
+    // 普通数据成员的 thread_local 是常量初始化的，operator new 在线程早期调用也不依赖动态初始化
+    thread_local AllocationTracker::Counts t_counts;
+}
+
+bool AllocationTracker::installed() {
+    return g_installed.load(std::memory_order_relaxed);
+}
+
+AllocationTracker::Counts AllocationTracker::snapshot() {
+    return t_counts;
+}
+
+void AllocationTracker::install() {
+    g_installed.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTracker::record(size_t bytes) {
+    t_counts.allocations++;
+    t_counts.bytes += static_cast<int64_t>(bytes);
+}
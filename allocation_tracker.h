@@ -0,0 +1,24 @@
+#pragma once
+// allocation_tracker.h
+#include <cstddef>
+#include <cstdint>
+
+// 堆分配计数：按线程累计 operator new 的调用次数与字节数
+// 计数由替换的全局 operator new（allocation_hook.cpp）调用 record 产生，只有链接了该文件的程序才会计数；
+// 未链接时 installed() 为 false，调用方应把分配计数视为不可用
+// 计数是线程局部的，计量一个区间时只统计当前线程，不受并发运行的其他优化影响
+class AllocationTracker {
+public:
+    struct Counts {
+        int64_t allocations = 0;
+        int64_t bytes = 0;
+    };
+
+    static bool installed();
+    // 当前线程自创建以来的累计值
+    static Counts snapshot();
+
+    // 由替换的 operator new 调用
+    static void install();
+    static void record(size_t bytes);
+};
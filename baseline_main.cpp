@@ -0,0 +1,107 @@
+// baseline_main.cpp
+// 用法: fwa_baseline record|compare <基线文件> [--dir 时间窗口目录] [--mesh-dir 网格目录]
+//                   [--satellites 卫星数] [--scenarios 场景文件] [--seed 种子] [--corpus 语料数]
+//                   [--repeats 重复次数] [--tolerance 目标值容差] [--hv-tolerance 超体积容差]
+//                   [--threshold 计时阈值] [--report 报告文件] [--verbose]
+// record 运行并写出基线；compare 运行并与基线对比，存在正确性漂移时返回 1
+#include "perf_baseline.h"
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+namespace {
+    // 静默期间 std::cout 指向未打开的文件缓冲区；离开作用域前必须恢复，否则退出时刷新会访问已析构的缓冲区
+    class CoutSilencer {
+    public:
+        explicit CoutSilencer(bool enabled) : saved_(std::cout.rdbuf()) {
+            if (enabled) std::cout.rdbuf(null_stream_.rdbuf());
+        }
+        ~CoutSilencer() { restore(); }
+        void restore() {
+            std::cout.rdbuf(saved_);
+            std::cout.clear();
+        }
+
+    private:
+        std::ofstream null_stream_;
+        std::streambuf* saved_;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "用法: fwa_baseline record|compare <基线文件> [选项]" << std::endl;
+        return 2;
+    }
+
+    std::string mode = argv[1];
+    std::string baseline_path = argv[2];
+    if (mode != "record" && mode != "compare") {
+        std::cerr << "未知模式: " << mode << std::endl;
+        return 2;
+    }
+
+    BaselineOptions options;
+    std::string scenario_file;
+    std::string report_path;
+    bool verbose = false;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--dir" && has_value) options.directory_path = argv[++i];
+        else if (arg == "--mesh-dir" && has_value) options.mesh_dir = argv[++i];
+        else if (arg == "--satellites" && has_value) options.num_satellites = std::atoi(argv[++i]);
+        else if (arg == "--scenarios" && has_value) scenario_file = argv[++i];
+        else if (arg == "--seed" && has_value) options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--corpus" && has_value) options.corpus_size = std::atoi(argv[++i]);
+        else if (arg == "--repeats" && has_value) options.repeats = std::atoi(argv[++i]);
+        else if (arg == "--tolerance" && has_value) options.objective_tolerance = std::atof(argv[++i]);
+        else if (arg == "--hv-tolerance" && has_value) options.hypervolume_tolerance = std::atof(argv[++i]);
+        else if (arg == "--threshold" && has_value) options.timing_threshold = std::atof(argv[++i]);
+        else if (arg == "--report" && has_value) report_path = argv[++i];
+        else if (arg == "--verbose") verbose = true;
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    if (!scenario_file.empty() && !ScenarioRunner::loadScenarios(scenario_file, options.scenarios)) {
+        return 2;
+    }
+
+    BaselineRecord baseline;
+    if (mode == "compare" && !baseline.load(baseline_path)) {
+        return 2;
+    }
+
+    // 数据加载与优化的逐代输出默认丢弃，只保留结论
+    CoutSilencer silencer(!verbose);
+
+    PerfBaseline runner(options);
+    BaselineRecord current;
+    if (!runner.run(current, mode == "compare" ? &baseline : nullptr)) {
+        return 2;
+    }
+
+    silencer.restore();
+    if (mode == "record") {
+        if (!current.save(baseline_path)) {
+            return 2;
+        }
+        std::cout << "已写入基线 " << baseline_path << ": 语料 " << current.corpus.size() << " 个调度";
+        for (const auto& phase : current.phases) {
+            std::cout << ", " << phase.name << " " << phase.ms << " ms";
+        }
+        std::cout << std::endl;
+        return 0;
+    }
+
+    bool consistent = runner.compare(baseline, current, std::cout);
+    if (!report_path.empty()) {
+        std::ofstream report(report_path);
+        runner.compare(baseline, current, report);
+    }
+    return consistent ? 0 : 1;
+}
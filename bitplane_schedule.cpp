@@ -0,0 +1,119 @@
+// bitplane_schedule.cpp
+#include "bitplane_schedule.h"
+#include <algorithm>
+
+void BitPlaneLayout::build(const std::vector<std::vector<int>>& compressed) {
+    rows_ = static_cast<int>(compressed.size());
+    cols_ = compressed.empty() ? 0 : static_cast<int>(compressed[0].size());
+    words_ = (cols_ + 63) / 64;
+
+    visible_.assign(static_cast<size_t>(rows_) * words_, 0);
+    adjacent_.assign(static_cast<size_t>(rows_) * words_, 0);
+    segments_.assign(rows_, {});
+    longest_.assign(rows_, 0);
+
+    for (int sat = 0; sat < rows_; ++sat) {
+        uint64_t* vis = visible_.data() + static_cast<size_t>(sat) * words_;
+        uint64_t* adj = adjacent_.data() + static_cast<size_t>(sat) * words_;
+        const auto& row = compressed[sat];
+
+        int start = -1;
+        for (int j = 0; j < cols_; ++j) {
+            if (row[j] != -1) {
+                vis[j >> 6] |= 1ULL << (j & 63);
+                if (j + 1 < cols_ && row[j + 1] != -1) {
+                    adj[j >> 6] |= 1ULL << (j & 63);
+                }
+                if (start == -1) start = j;
+            }
+            else if (start != -1) {
+                segments_[sat].emplace_back(start, j - 1);
+                start = -1;
+            }
+        }
+        if (start != -1) {
+            segments_[sat].emplace_back(start, cols_ - 1);
+        }
+
+        for (const auto& seg : segments_[sat]) {
+            longest_[sat] = std::max(longest_[sat], seg.second - seg.first + 1);
+        }
+    }
+}
+
+BitPlaneSchedule::BitPlaneSchedule(const BitPlaneLayout& layout)
+    : words_(layout.words()), on_(static_cast<size_t>(layout.rows()) * layout.words(), 0) {
+}
+
+BitPlaneSchedule BitPlaneSchedule::encode(const BitPlaneLayout& layout,
+    const std::vector<std::vector<int>>& solution) {
+
+    BitPlaneSchedule bp(layout);
+    for (int sat = 0; sat < layout.rows(); ++sat) {
+        uint64_t* bits = bp.on(sat);
+        const auto& row = solution[sat];
+        for (int j = 0; j < layout.cols(); ++j) {
+            if (row[j] == 1) {
+                bits[j >> 6] |= 1ULL << (j & 63);
+            }
+        }
+    }
+    return bp;
+}
+
+int BitPlaneSchedule::switchCount(const BitPlaneLayout& layout, int sat) const {
+    const uint64_t* bits = on(sat);
+    const uint64_t* adj = layout.adjacent(sat);
+
+    // 相邻掩码已排除跨越不可见列的位置，整行直接计数即可
+    int count = 0;
+    for (int w = 0; w < words_; ++w) {
+        uint64_t next = (w + 1 < words_) ? (bits[w + 1] << 63) : 0ULL;
+        count += popcount64((bits[w] ^ ((bits[w] >> 1) | next)) & adj[w]);
+    }
+    return count;
+}
+
+int BitPlaneSchedule::activeCount(int sat) const {
+    const uint64_t* bits = on(sat);
+    int count = 0;
+    for (int w = 0; w < words_; ++w) {
+        count += popcount64(bits[w]);
+    }
+    return count;
+}
+
+bool BitPlaneSchedule::anyActive(int sat) const {
+    const uint64_t* bits = on(sat);
+    for (int w = 0; w < words_; ++w) {
+        if (bits[w]) return true;
+    }
+    return false;
+}
+
+int BitPlaneSchedule::switchesWithin(int sat, int first, int last) const {
+    const uint64_t* bits = on(sat);
+    int count = 0;
+    // 第 j 位表示列 j 与 j+1 是否不同，取 j ∈ [first, last - 1]
+    for (int w = first >> 6; first < last && w <= ((last - 1) >> 6); ++w) {
+        uint64_t next = (w + 1 < words_) ? (bits[w + 1] << 63) : 0ULL;
+        uint64_t diff = bits[w] ^ ((bits[w] >> 1) | next);
+        if (w == (first >> 6)) diff &= ~0ULL << (first & 63);
+        if (w == ((last - 1) >> 6)) diff &= ~0ULL >> (63 - ((last - 1) & 63));
+        count += popcount64(diff);
+    }
+    return count;
+}
+
+bool BitPlaneSchedule::withinSwitchLimit(const BitPlaneLayout& layout, int max_switches) const {
+    for (int sat = 0; sat < layout.rows(); ++sat) {
+        // 整行总数不超限时各段必然不超限，多数卫星只需这一遍
+        if (switchCount(layout, sat) <= max_switches) continue;
+        for (const auto& seg : layout.segments(sat)) {
+            if (switchesWithin(sat, seg.first, seg.second) > max_switches) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
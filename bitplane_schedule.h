@@ -0,0 +1,109 @@
+#pragma once
+// bitplane_schedule.h
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+inline int popcount64(uint64_t x) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// 最低位 1 的位置，x 不能为 0
+inline int ctz64(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// 位平面布局：按压缩列排列的可见性掩码（对同一问题固定）及各卫星的连续可见段
+class BitPlaneLayout {
+public:
+    void build(const std::vector<std::vector<int>>& compressed);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int words() const { return words_; }
+
+    const uint64_t* visible(int sat) const { return visible_.data() + static_cast<size_t>(sat) * words_; }
+    // 相邻两列均可见的位置（第 j 位表示列 j 与 j+1）
+    const uint64_t* adjacent(int sat) const { return adjacent_.data() + static_cast<size_t>(sat) * words_; }
+
+    // 连续可见段 [first, last]，与 findValidIntervals 的结果一致
+    const std::vector<std::pair<int, int>>& segments(int sat) const { return segments_[sat]; }
+    int longestSegment(int sat) const { return longest_[sat]; }
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    int words_ = 0;
+    std::vector<uint64_t> visible_;
+    std::vector<uint64_t> adjacent_;
+    std::vector<std::vector<std::pair<int, int>>> segments_;
+    std::vector<int> longest_;
+};
+
+// 位平面调度：每颗卫星一条开关掩码，不可见列恒为 0
+// explode 把原解编码一次，各火花带着副本经 setCell 与整数矩阵同步修改；
+// 约束检查、活跃卫星数与负载方差、切换次数与重访间隔目标都直接在掩码上逐字计算
+class BitPlaneSchedule {
+public:
+    BitPlaneSchedule() = default;
+    explicit BitPlaneSchedule(const BitPlaneLayout& layout);
+
+    static BitPlaneSchedule encode(const BitPlaneLayout& layout, const std::vector<std::vector<int>>& solution);
+
+    void set(int sat, int col, bool value) {
+        uint64_t bit = 1ULL << (col & 63);
+        uint64_t& word = on(sat)[col >> 6];
+        word = value ? (word | bit) : (word & ~bit);
+    }
+
+    // 将卫星 sat 的 [first, last] 列置为 value（置 1 时调用方保证这些列均可见），对取值改变的列依次调用 changed(col)
+    template <typename Changed>
+    void assignRange(int sat, int first, int last, bool value, Changed&& changed) {
+        uint64_t* bits = on(sat);
+        for (int w = first >> 6; w <= (last >> 6); ++w) {
+            uint64_t mask = ~0ULL;
+            if (w == (first >> 6)) mask &= ~0ULL << (first & 63);
+            if (w == (last >> 6)) mask &= ~0ULL >> (63 - (last & 63));
+            uint64_t diff = (value ? ~bits[w] : bits[w]) & mask;
+            bits[w] ^= diff;
+            while (diff) {
+                changed((w << 6) + ctz64(diff));
+                diff &= diff - 1;
+            }
+        }
+    }
+
+    // 单颗卫星的开机列数 / 是否有开机列
+    int activeCount(int sat) const;
+    bool anyActive(int sat) const;
+
+    // 单颗卫星在所有可见段内的切换总数
+    int switchCount(const BitPlaneLayout& layout, int sat) const;
+
+    // 每颗卫星在每个可见段内的切换次数均不超过 max_switches，与 checkSwitches 的整数矩阵版本等价
+    bool withinSwitchLimit(const BitPlaneLayout& layout, int max_switches) const;
+
+    uint64_t* on(int sat) { return on_.data() + static_cast<size_t>(sat) * words_; }
+    const uint64_t* on(int sat) const { return on_.data() + static_cast<size_t>(sat) * words_; }
+
+private:
+    // 列 first..last 之间（共 last - first 对相邻列）的切换次数
+    int switchesWithin(int sat, int first, int last) const;
+
+    int words_ = 0;
+    std::vector<uint64_t> on_;
+};
@@ -0,0 +1,521 @@
+// coverage_kernels.cpp
+#include "coverage_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+    // 字数和活跃数均固定：内外层循环次数在编译期已知，可完全展开并向量化
+    template <int W, int K>
+    int unionPopcountFixed(const uint64_t* const* meshes, int, int) {
+        int count = 0;
+        for (int w = 0; w < W; ++w) {
+            uint64_t bits = meshes[0][w];
+            for (int k = 1; k < K; ++k) {
+                bits |= meshes[k][w];
+            }
+            count += popcount64(bits);
+        }
+        return count;
+    }
+
+    // 仅活跃数固定
+    template <int K>
+    int unionPopcountActive(const uint64_t* const* meshes, int, int words) {
+        int count = 0;
+        for (int w = 0; w < words; ++w) {
+            uint64_t bits = meshes[0][w];
+            for (int k = 1; k < K; ++k) {
+                bits |= meshes[k][w];
+            }
+            count += popcount64(bits);
+        }
+        return count;
+    }
+
+    int unionPopcountGeneric(const uint64_t* const* meshes, int count, int words) {
+        int total = 0;
+        for (int w = 0; w < words; ++w) {
+            uint64_t bits = 0;
+            for (int k = 0; k < count; ++k) {
+                bits |= meshes[k][w];
+            }
+            total += popcount64(bits);
+        }
+        return total;
+    }
+
+    struct KernelEntry {
+        int words;      // 0 表示任意字数
+        int active;
+        MeshUnionKernel kernel;
+    };
+
+    // 已注册的特化形状：q = 6665 对应 105 个字，重叠列通常有 2~3 颗卫星同时开机
+    const KernelEntry kSpecializedKernels[] = {
+        { 105, 2, &unionPopcountFixed<105, 2> },
+        { 105, 3, &unionPopcountFixed<105, 3> },
+        { 105, 4, &unionPopcountFixed<105, 4> },
+        { 0, 2, &unionPopcountActive<2> },
+        { 0, 3, &unionPopcountActive<3> },
+        { 0, 4, &unionPopcountActive<4> },
+    };
+
+    MeshUnionKernel findKernel(int words, int active) {
+        MeshUnionKernel fallback = nullptr;
+        for (const auto& entry : kSpecializedKernels) {
+            if (entry.active != active) continue;
+            if (entry.words == words) return entry.kernel;
+            if (entry.words == 0) fallback = entry.kernel;
+        }
+        return fallback;
+    }
+
+    const int kStackMeshes = 16;
+}
+
+void CoverageKernelTable::build(int words, int max_active) {
+    words_ = words;
+    generic_ = &unionPopcountGeneric;
+    kernels_.assign(std::max(max_active, 0) + 1, generic_);
+
+    for (int active = 2; active <= max_active; ++active) {
+        MeshUnionKernel kernel = findKernel(words, active);
+        if (kernel) {
+            kernels_[active] = kernel;
+        }
+    }
+}
+
+bool CoverageKernelTable::specialized(int active) const {
+    return get(active) != generic_;
+}
+
+void PackedCoverage::setMeshStorage(MeshStorage storage) {
+    storage_ = storage;
+    compressed_ = storage_ == MeshStorage::Compressed ||
+        (storage_ == MeshStorage::Auto && q_ >= MeshContainer::kChunkPoints);
+}
+
+void PackedCoverage::reset(int rows, int cols, int q) {
+    rows_ = rows;
+    cols_ = cols;
+    q_ = q;
+    words_ = (q + 63) / 64;
+    ready_ = false;
+
+    single_.assign(static_cast<size_t>(rows) * cols, 0.0);
+    mesh_offset_.assign(static_cast<size_t>(rows) * cols, -1);
+    mesh_pool_.clear();
+    mesh_sets_.clear();
+    setMeshStorage(storage_);
+}
+
+void PackedCoverage::setSingle(int sat, int col, double coverage) {
+    single_[cell(sat, col)] = coverage;
+}
+
+void PackedCoverage::setMesh(int sat, int col, const std::vector<bool>& mesh) {
+    if (compressed_) {
+        setMesh(sat, col, MeshContainer::fromBits(mesh, q_));
+        return;
+    }
+
+    int offset = static_cast<int>(mesh_pool_.size());
+    mesh_pool_.resize(mesh_pool_.size() + words_, 0);
+
+    uint64_t* bits = mesh_pool_.data() + offset;
+    int n = std::min(static_cast<int>(mesh.size()), q_);
+    for (int i = 0; i < n; ++i) {
+        if (mesh[i]) {
+            bits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+    mesh_offset_[cell(sat, col)] = offset;
+}
+
+void PackedCoverage::setMesh(int sat, int col, const MeshContainer& mesh) {
+    if (compressed_) {
+        mesh_offset_[cell(sat, col)] = static_cast<int>(mesh_sets_.size());
+        mesh_sets_.push_back(mesh);
+        return;
+    }
+
+    int offset = static_cast<int>(mesh_pool_.size());
+    mesh_pool_.resize(mesh_pool_.size() + words_, 0);
+    mesh.orInto(mesh_pool_.data() + offset);
+    mesh_offset_[cell(sat, col)] = offset;
+}
+
+void PackedCoverage::copyColumn(const PackedCoverage& from, int from_col, int to_col) {
+    for (int sat = 0; sat < rows_ && sat < from.rows_; ++sat) {
+        single_[cell(sat, to_col)] = from.single_[from.cell(sat, from_col)];
+
+        int source = from.mesh_offset_[from.cell(sat, from_col)];
+        if (source < 0) continue;
+        if (from.compressed_) {
+            setMesh(sat, to_col, from.mesh_sets_[source]);
+            continue;
+        }
+        if (compressed_) {
+            setMesh(sat, to_col, MeshContainer::fromWords(from.mesh_pool_.data() + source, q_));
+            continue;
+        }
+        int offset = static_cast<int>(mesh_pool_.size());
+        mesh_pool_.insert(mesh_pool_.end(), from.mesh_pool_.begin() + source,
+            from.mesh_pool_.begin() + source + words_);
+        mesh_offset_[cell(sat, to_col)] = offset;
+    }
+}
+
+void PackedCoverage::setWeights(const std::vector<double>& weights) {
+    weights_.clear();
+    if (weights.empty()) {
+        return;
+    }
+    if (static_cast<int>(weights.size()) != q_) {
+        throw std::invalid_argument("网格点权重个数与网格点数不一致");
+    }
+
+    double sum = 0.0;
+    for (double w : weights) {
+        if (!(w >= 0.0)) {
+            throw std::invalid_argument("网格点权重不能为负");
+        }
+        sum += w;
+    }
+    if (sum <= 0.0) {
+        throw std::invalid_argument("网格点权重之和必须为正");
+    }
+
+    weights_.resize(q_);
+    for (int i = 0; i < q_; ++i) {
+        weights_[i] = weights[i] / sum;
+    }
+}
+
+void PackedCoverage::buildWeightTables() {
+    word_low_.assign(words_, 0.0);
+    word_high_.assign(words_, 0.0);
+    word_mask_.assign(words_, 0);
+    word_table_.assign(words_, -1);
+    nibble_sums_.clear();
+    table_words_ = 0;
+
+    for (int w = 0; w < words_; ++w) {
+        int first = w * 64;
+        int last = std::min(first + 64, q_);
+
+        // 末字的填充位在网格中恒为 0，不影响结果
+        double low = weights_[first];
+        double high = low;
+        uint64_t mask = 0;
+        bool two_level = true;
+        for (int i = first + 1; i < last; ++i) {
+            if (weights_[i] == low) continue;
+            if (mask == 0) {
+                high = weights_[i];
+            }
+            else if (weights_[i] != high) {
+                two_level = false;
+                break;
+            }
+            mask |= 1ULL << (i - first);
+        }
+        if (two_level) {
+            word_low_[w] = low;
+            word_high_[w] = high;
+            word_mask_[w] = mask;
+            continue;
+        }
+
+        word_table_[w] = static_cast<int>(nibble_sums_.size());
+        nibble_sums_.resize(nibble_sums_.size() + 256, 0.0f);
+        float* table = nibble_sums_.data() + word_table_[w];
+        for (int n = 0; n < 16; ++n) {
+            for (int value = 1; value < 16; ++value) {
+                double sum = 0.0;
+                for (int b = 0; b < 4; ++b) {
+                    int i = first + n * 4 + b;
+                    if ((value >> b & 1) && i < last) {
+                        sum += weights_[i];
+                    }
+                }
+                table[n * 16 + value] = static_cast<float>(sum);
+            }
+        }
+        table_words_++;
+    }
+
+    weight_prefix_.clear();
+    if (compressed_) {
+        weight_prefix_.assign(q_ + 1, 0.0);
+        for (int i = 0; i < q_; ++i) {
+            weight_prefix_[i + 1] = weight_prefix_[i] + weights_[i];
+        }
+    }
+}
+
+void PackedCoverage::finalize() {
+    kernels_.build(words_, rows_);
+
+    if (weighted()) {
+        // 单星覆盖率沿用 satellite_*.csv 的单位（网格点的百分比），有网格的单元换成加权百分比，
+        // 与没有网格、只能保留文件取值的单元单位相同；等权时两者一致
+        buildWeightTables();
+        for (size_t c = 0; c < mesh_offset_.size(); ++c) {
+            if (mesh_offset_[c] >= 0 && compressed_) {
+                const MeshContainer* mesh = &mesh_sets_[mesh_offset_[c]];
+                single_[c] = 100.0 * weightedSets(&mesh, 1);
+            }
+            else if (mesh_offset_[c] >= 0) {
+                const uint64_t* mesh = mesh_pool_.data() + mesh_offset_[c];
+                single_[c] = 100.0 * weightedUnion(&mesh, 1);
+            }
+        }
+    }
+    ready_ = true;
+}
+
+double PackedCoverage::weightedUnion(const uint64_t* const* meshes, int count) const {
+    double sum = 0.0;
+    for (int w = 0; w < words_; ++w) {
+        uint64_t bits = meshes[0][w];
+        for (int k = 1; k < count; ++k) {
+            bits |= meshes[k][w];
+        }
+        if (bits == 0) continue;
+        sum += weightedWord(w, bits);
+    }
+    return sum;
+}
+
+double PackedCoverage::weightedWord(int w, uint64_t bits) const {
+    int table_offset = word_table_[w];
+    if (table_offset < 0) {
+        uint64_t mask = word_mask_[w];
+        return word_low_[w] * popcount64(bits & ~mask) + word_high_[w] * popcount64(bits & mask);
+    }
+
+    const float* table = nibble_sums_.data() + table_offset;
+    float word_sum = 0.0f;
+    for (int n = 0; n < 16; ++n) {
+        word_sum += table[n * 16 + static_cast<int>(bits >> (4 * n) & 15)];
+    }
+    return word_sum;
+}
+
+class PackedCoverage::WeightSum : public MeshContainer::ChunkVisitor {
+public:
+    explicit WeightSum(const PackedCoverage& model) : model_(model) {}
+
+    void visit(const MeshContainer::ChunkView& chunk) override {
+        switch (chunk.encoding) {
+        case MeshContainer::Encoding::Array:
+            for (int i = 0; i < chunk.count; ++i) {
+                sum += model_.weights_[chunk.base + chunk.values[i]];
+            }
+            break;
+        case MeshContainer::Encoding::Run:
+            for (int i = 0; i < chunk.count; ++i) {
+                int first = chunk.base + chunk.values[2 * i];
+                int last = first + chunk.values[2 * i + 1];
+                sum += model_.weight_prefix_[last + 1] - model_.weight_prefix_[first];
+            }
+            break;
+        case MeshContainer::Encoding::Bitmap: {
+            int first_word = chunk.base >> 6;
+            for (int w = 0; w < chunk.word_count; ++w) {
+                if (chunk.words[w] != 0) {
+                    sum += model_.weightedWord(first_word + w, chunk.words[w]);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    double sum = 0.0;
+
+private:
+    const PackedCoverage& model_;
+};
+
+double PackedCoverage::weightedSets(const MeshContainer* const* meshes, int count) const {
+    WeightSum visitor(*this);
+    MeshContainer::unionChunks(meshes, count, visitor);
+    return visitor.sum;
+}
+
+bool PackedCoverage::meshBit(int offset, int point) const {
+    if (compressed_) {
+        return mesh_sets_[offset].contains(point);
+    }
+    return mesh_pool_[offset + (point >> 6)] >> (point & 63) & 1ULL;
+}
+
+size_t PackedCoverage::meshBytes() const {
+    if (!compressed_) {
+        return mesh_pool_.size() * sizeof(uint64_t);
+    }
+    size_t bytes = 0;
+    for (const MeshContainer& mesh : mesh_sets_) {
+        bytes += mesh.bytes();
+    }
+    return bytes;
+}
+
+int PackedCoverage::meshCount() const {
+    return static_cast<int>(compressed_ ? mesh_sets_.size() : mesh_pool_.size() / std::max(words_, 1));
+}
+
+double PackedCoverage::column(const std::vector<std::vector<int>>& solution, int col, int* active_out) const {
+    int active = 0;
+    int last_sat = -1;
+    for (int sat = 0; sat < rows_; ++sat) {
+        if (solution[sat][col] == 1) {
+            active++;
+            last_sat = sat;
+        }
+    }
+    if (active_out) {
+        *active_out = active;
+    }
+
+    // 当前时间点没有卫星调度 / 只有1个卫星调度
+    if (active == 0) {
+        return 0.0;
+    }
+    if (active == 1) {
+        return single_[cell(last_sat, col)];
+    }
+
+    // 2个及以上卫星调度：网格取并集后计数
+    if (compressed_) {
+        const MeshContainer* stack_sets[kStackMeshes];
+        std::vector<const MeshContainer*> heap_sets;
+        const MeshContainer** sets = stack_sets;
+        if (active > kStackMeshes) {
+            heap_sets.resize(active);
+            sets = heap_sets.data();
+        }
+
+        int k = 0;
+        for (int sat = 0; sat < rows_; ++sat) {
+            if (solution[sat][col] == 1) {
+                int offset = mesh_offset_[cell(sat, col)];
+                if (offset < 0) {
+                    throw std::runtime_error("缺少重叠时间点的网格数据");
+                }
+                sets[k++] = &mesh_sets_[offset];
+            }
+        }
+
+        if (weighted()) {
+            return weightedSets(sets, active);
+        }
+        return static_cast<double>(MeshContainer::unionCardinality(sets, active)) / q_;
+    }
+
+    const uint64_t* stack_meshes[kStackMeshes];
+    std::vector<const uint64_t*> heap_meshes;
+    const uint64_t** meshes = stack_meshes;
+    if (active > kStackMeshes) {
+        heap_meshes.resize(active);
+        meshes = heap_meshes.data();
+    }
+
+    int k = 0;
+    for (int sat = 0; sat < rows_; ++sat) {
+        if (solution[sat][col] == 1) {
+            int offset = mesh_offset_[cell(sat, col)];
+            if (offset < 0) {
+                throw std::runtime_error("缺少重叠时间点的网格数据");
+            }
+            meshes[k++] = mesh_pool_.data() + offset;
+        }
+    }
+
+    if (weighted()) {
+        return weightedUnion(meshes, active);
+    }
+    int covered = kernels_.get(active)(meshes, active, words_);
+    return static_cast<double>(covered) / q_;
+}
+
+double PackedCoverage::total(const std::vector<std::vector<int>>& solution, int* overlap_columns) const {
+    double coverage = 0.0;
+    int overlaps = 0;
+    for (int col = 0; col < cols_; ++col) {
+        int active = 0;
+        coverage += column(solution, col, &active);
+        overlaps += active >= 2;
+    }
+    if (overlap_columns) {
+        *overlap_columns = overlaps;
+    }
+    return coverage;
+}
+
+std::shared_ptr<const PackedCoverage> PackedCoverage::subsample(int samples, uint32_t seed) const {
+    samples = std::max(1, std::min(samples, q_));
+
+    // 第 h 层为 [h*q/n, (h+1)*q/n)，层大小最多相差 1；相邻编号的网格点空间上相近，分层后方差远小于简单随机抽样
+    std::mt19937 gen(seed);
+    std::vector<int> points(samples);
+    for (int h = 0; h < samples; ++h) {
+        int begin = static_cast<int>(static_cast<int64_t>(h) * q_ / samples);
+        int end = static_cast<int>(static_cast<int64_t>(h + 1) * q_ / samples);
+        points[h] = std::uniform_int_distribution<int>(begin, end - 1)(gen);
+    }
+
+    auto model = std::make_shared<PackedCoverage>();
+    model->rows_ = rows_;
+    model->cols_ = cols_;
+    model->q_ = samples;
+    model->words_ = (samples + 63) / 64;
+    // 抽样网格点数很少，总是稠密存储
+    model->setMeshStorage(MeshStorage::Dense);
+    model->single_ = single_;
+    model->mesh_offset_.assign(mesh_offset_.size(), -1);
+    model->column_error_std_ = 0.5 / std::sqrt(static_cast<double>(samples));
+
+    // 加权时每个抽样点代表其所在层的总权重 W_h，估计量方差 sum(W_h^2 p_h(1-p_h)) <= sum(W_h^2)/4
+    std::vector<double> stratum_weights;
+    if (weighted()) {
+        stratum_weights.assign(samples, 0.0);
+        double squares = 0.0;
+        for (int h = 0; h < samples; ++h) {
+            int begin = static_cast<int>(static_cast<int64_t>(h) * q_ / samples);
+            int end = static_cast<int>(static_cast<int64_t>(h + 1) * q_ / samples);
+            for (int i = begin; i < end; ++i) {
+                stratum_weights[h] += weights_[i];
+            }
+            squares += stratum_weights[h] * stratum_weights[h];
+        }
+        model->column_error_std_ = 0.5 * std::sqrt(squares);
+    }
+
+    for (size_t c = 0; c < mesh_offset_.size(); ++c) {
+        if (mesh_offset_[c] < 0) continue;
+
+        int offset = static_cast<int>(model->mesh_pool_.size());
+        model->mesh_pool_.resize(model->mesh_pool_.size() + model->words_, 0);
+        uint64_t* bits = model->mesh_pool_.data() + offset;
+        for (int h = 0; h < samples; ++h) {
+            if (meshBit(mesh_offset_[c], points[h])) {
+                bits[h >> 6] |= 1ULL << (h & 63);
+            }
+        }
+        model->mesh_offset_[c] = offset;
+    }
+
+    if (weighted()) {
+        model->setWeights(stratum_weights);
+    }
+    model->finalize();
+    // 单星列保持完整模型的精确值，finalize 按抽样网格重算的结果只用于多星列
+    model->single_ = single_;
+    return model;
+}
@@ -0,0 +1,117 @@
+#pragma once
+// coverage_kernels.h
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include "bitplane_schedule.h"
+#include "mesh_container.h"
+
+// 网格并集计数内核：count 个按 64 位打包的网格按位或后统计 1 的个数
+using MeshUnionKernel = int (*)(const uint64_t* const* meshes, int count, int words);
+
+// 内核分派表：按 (网格字数, 活跃卫星数) 选择内核
+// 常见形状使用编译期固定循环次数的特化版本，其余使用通用内核
+class CoverageKernelTable {
+public:
+    void build(int words, int max_active);
+
+    MeshUnionKernel get(int active) const {
+        return active < static_cast<int>(kernels_.size()) ? kernels_[active] : generic_;
+    }
+    // 该活跃数是否命中了特化内核（而非通用内核）
+    bool specialized(int active) const;
+    int words() const { return words_; }
+
+private:
+    int words_ = 0;
+    std::vector<MeshUnionKernel> kernels_;
+    MeshUnionKernel generic_ = nullptr;
+};
+
+// 打包后的覆盖率模型：每个问题构建一次
+// 单星列直接查表，多星列对预先打包的网格调用分派表中的内核
+class PackedCoverage {
+public:
+    // 网格的存储方式：Dense 为每网格 words() 个字的连续位图；Compressed 为分块压缩的 MeshContainer，
+    // 并集直接在压缩形式上计算；Auto 在网格点数不少于一个压缩块（65536）时选 Compressed
+    enum class MeshStorage { Dense, Compressed, Auto };
+
+    // 需在 reset 之前或第一个 setMesh 之前设置
+    void setMeshStorage(MeshStorage storage);
+    bool compressed() const { return compressed_; }
+
+    void reset(int rows, int cols, int q);
+    void setSingle(int sat, int col, double coverage);
+    void setMesh(int sat, int col, const std::vector<bool>& mesh);
+    void setMesh(int sat, int col, const MeshContainer& mesh);
+    // 从另一个（卫星数相同的）模型复制整列的单星覆盖率和网格
+    void copyColumn(const PackedCoverage& from, int from_col, int to_col);
+    // 网格点权重（面积、优先级等），长度为 q，为空表示等权；需在 finalize 之前设置
+    // 加权时多星列取并集网格点的权重和占总权重的比例；有网格的单星覆盖率按网格的加权百分比重新计算
+    // （与 satellite_*.csv 中的单星覆盖率同为百分比，没有网格的单元保留文件取值）
+    void setWeights(const std::vector<double>& weights);
+    void finalize();
+
+    bool ready() const { return ready_; }
+    void invalidate() { ready_ = false; }
+
+    // 单列 / 全部列的覆盖率，与 calculateCoverage 的定义一致
+    // active 非空时返回该列开机的卫星数；overlap_columns 非空时返回多星列的个数
+    double column(const std::vector<std::vector<int>>& solution, int col, int* active = nullptr) const;
+    double total(const std::vector<std::vector<int>>& solution, int* overlap_columns = nullptr) const;
+
+    // 分层抽样的代理模型：网格点按编号等分为 samples 层，每层随机取一个点（seed 固定，结果可复现）
+    // 单星列仍取精确值，多星列取抽样点上的并集比例
+    std::shared_ptr<const PackedCoverage> subsample(int samples, uint32_t seed) const;
+    // 多星列估计值的标准差上界：每层一个点时方差为 sum(p_h(1-p_h))/n^2 <= 1/(4n)；完整模型为 0
+    double columnErrorStd() const { return column_error_std_; }
+
+    int q() const { return q_; }
+    int words() const { return words_; }
+    bool weighted() const { return !weights_.empty(); }
+    // 加权时走查表路径（字内多于两种权重）的字数
+    int tableWords() const { return table_words_; }
+    // 网格数据占用的字节数与网格个数
+    size_t meshBytes() const;
+    int meshCount() const;
+    const CoverageKernelTable& kernels() const { return kernels_; }
+
+private:
+    size_t cell(int sat, int col) const { return static_cast<size_t>(col) * rows_ + sat; }
+
+    // 加权并集：字内至多两种权重时为两次带掩码的 权重 x popcount，否则按 16 个半字节查预先计算的权重和
+    double weightedUnion(const uint64_t* const* meshes, int count) const;
+    double weightedWord(int w, uint64_t bits) const;
+    void buildWeightTables();
+
+    // 压缩存储时逐块累加并集的权重：数组块逐点、游程块查前缀和、位图块按字走 weightedWord
+    class WeightSum;
+    double weightedSets(const MeshContainer* const* meshes, int count) const;
+    bool meshBit(int offset, int point) const;
+
+    int rows_ = 0;
+    int cols_ = 0;
+    int q_ = 0;
+    int words_ = 0;
+    bool ready_ = false;
+    double column_error_std_ = 0.0;
+
+    std::vector<double> single_;        // [列][卫星] 单星覆盖率
+    MeshStorage storage_ = MeshStorage::Auto;
+    bool compressed_ = false;
+    std::vector<int> mesh_offset_;      // [列][卫星] 在 mesh_pool_ 中的起始字（压缩存储时为 mesh_sets_ 下标），-1 表示无网格
+    std::vector<uint64_t> mesh_pool_;
+    std::vector<MeshContainer> mesh_sets_;
+    CoverageKernelTable kernels_;
+
+    std::vector<double> weights_;       // 归一化后的权重（和为 1）
+    // 字内至多两种权重时：掩码外的位取 word_low_，掩码内的位取 word_high_（经纬度网格跨行的字即如此）
+    std::vector<double> word_low_;
+    std::vector<double> word_high_;
+    std::vector<uint64_t> word_mask_;
+    std::vector<int> word_table_;       // 字内多于两种权重时在 nibble_sums_ 中的起点，-1 表示用掩码路径
+    std::vector<float> nibble_sums_;    // [字][半字节位置 16][半字节取值 16] 的权重和
+    std::vector<double> weight_prefix_; // 压缩存储时的权重前缀和（q+1 项）
+    int table_words_ = 0;
+};
@@ -1,102 +1,198 @@
-// coverage_loader.cpp
-#include "coverage_loader.h"
-#include <iostream>
-#include <filesystem>
-#include "csv_reader_optimized.h"
-
-CoverageDataLoader::CoverageDataLoader(const std::string& data_dir)
-    : data_dir_(data_dir), gen_(rd_()), dist_(0.5) {}
-
-void CoverageDataLoader::preloadAllData(const std::vector<int>& satellites,
-    const std::vector<int>& special_times) {
-    std::cout << "ʼԤ..." << std::endl;
-
-    int loaded_count = 0;
-    int error_count = 0;
-
-    for (int sat : satellites) {
-        for (int time : special_times) {
-            std::string filename = makeFilename(sat, time);
-            std::string filepath = filename;
-
-            CacheKey key{ sat, time };
-
-            // ļǷ
-            if (std::filesystem::exists(filepath)) {
-                try {
-                    auto mesh_data = loadMeshFromCSV(filepath);
-                    mesh_cache_[key] = mesh_data;
-                    loaded_count++;
-                }
-                catch (const std::exception& e) {
-                    std::cerr << "ļ " << filename << " : " << e.what() << std::endl;
-                    mesh_cache_[key] = generateRandomMesh(q_);
-                    error_count++;
-                }
-            }
-            else {
-                // ļڣ
-                mesh_cache_[key] = generateRandomMesh(q_);
-                std::cout << "ļڣ: " << filename << std::endl;
-            }
-        }
-    }
-
-    std::cout << "Ԥɣ " << mesh_cache_.size() << " " << std::endl;
-    std::cout << "ɹ: " << loaded_count << ", /ȱʧ: " << error_count << std::endl;
-}
-
-std::vector<bool> CoverageDataLoader::getMeshData(int sat, int time, int q) {
-    CacheKey key{ sat, time };
-    auto it = mesh_cache_.find(key);
-
-    if (it != mesh_cache_.end()) {
-        return it->second;
-    }
-
-    // ûУ
-    return generateRandomMesh(q);
-}
-
-std::vector<bool> CoverageDataLoader::loadMeshFromCSV(const std::string& filepath) {
-    try {
-        // ʹŻCSVȡ
-        auto mesh_data = OptimizedCSVReader::readSingleColumnCSV(filepath, q_);
-
-        // ȷȷ
-        if (mesh_data.size() < q_) {
-            std::cout << ": ļ " << filepath << " ֻ " << mesh_data.size()
-                << " ݣҪ " << q_ << " У" << std::endl;
-
-            while (mesh_data.size() < q_) {
-                mesh_data.push_back(dist_(gen_));
-            }
-        }
-        else if (mesh_data.size() > q_) {
-            mesh_data.resize(q_);
-            std::cout << ": ļ " << filepath << "  " << mesh_data.size()
-                << " ݣҪ " << q_ << " Уѽض" << std::endl;
-        }
-
-        return mesh_data;
-
-    }
-    catch (const std::exception& e) {
-        std::cerr << "CSVļ: " << filepath << " - " << e.what() << std::endl;
-        throw; // ׳쳣
-    }
-}
-std::vector<bool> CoverageDataLoader::generateRandomMesh(int q) {
-    std::vector<bool> random_data;
-    random_data.reserve(q);
-
-    for (int i = 0; i < q; ++i) {
-        random_data.push_back(dist_(gen_));
-    }
-
-    return random_data;
-}
-
-std::string CoverageDataLoader::makeFilename(int sat, int time) const {
-    return "s" + std::to_string(sat) + "_" + std::to_string(time) + ".csv";
+// coverage_loader.cpp
+#include "coverage_loader.h"
+#include <iostream>
+#include <filesystem>
+#include <cmath>
+#include <cstdlib>
+#include "csv_reader_optimized.h"
+
+CoverageDataLoader::CoverageDataLoader(const std::string& data_dir, int q)
+    : data_dir_(data_dir), q_(q), gen_(rd_()), dist_(0.5) {}
+
+void CoverageDataLoader::preloadAllData(const std::vector<int>& satellites,
+    const std::vector<int>& special_times) {
+    std::cout << "开始预加载网格数据..." << std::endl;
+
+    int loaded_count = 0;
+    int error_count = 0;
+
+    for (int sat : satellites) {
+        for (int time : special_times) {
+            std::string filename = makeFilename(sat, time);
+            std::string filepath = makeFilepath(sat, time);
+
+            CacheKey key{ sat, time };
+            reseedFill(sat, time);
+
+            // 检查文件是否存在
+            if (std::filesystem::exists(filepath)) {
+                try {
+                    auto mesh_data = loadMeshFromCSV(filepath);
+                    mesh_cache_[key] = MeshContainer::fromBits(mesh_data, q_);
+                    loaded_count++;
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "加载文件 " << filename << " 出错: " << e.what() << std::endl;
+                    mesh_cache_[key] = MeshContainer::fromBits(generateRandomMesh(q_), q_);
+                    error_count++;
+                }
+            }
+            else {
+                // 文件不存在，生成随机数据
+                mesh_cache_[key] = MeshContainer::fromBits(generateRandomMesh(q_), q_);
+                std::cout << "文件不存在，生成随机数据: " << filename << std::endl;
+            }
+        }
+    }
+
+    std::cout << "预加载完成，共缓存 " << mesh_cache_.size() << " 个网格数据" << std::endl;
+    std::cout << "成功加载: " << loaded_count << ", 错误/缺失: " << error_count << std::endl;
+    std::cout << "网格缓存占用 " << cacheBytes() / 1024 << " KB（按位打包需 "
+        << mesh_cache_.size() * ((q_ + 63) / 64) * 8 / 1024 << " KB）" << std::endl;
+}
+
+size_t CoverageDataLoader::cacheBytes() const {
+    size_t bytes = 0;
+    for (const auto& entry : mesh_cache_) {
+        bytes += entry.second.bytes();
+    }
+    return bytes;
+}
+
+std::vector<bool> CoverageDataLoader::getMeshData(int sat, int time, int q) {
+    CacheKey key{ sat, time };
+    auto it = mesh_cache_.find(key);
+
+    if (it != mesh_cache_.end()) {
+        return it->second.toBits();
+    }
+
+    // 如果缓存中没有，生成随机数据
+    reseedFill(sat, time);
+    return generateRandomMesh(q);
+}
+
+MeshContainer CoverageDataLoader::getMesh(int sat, int time, int q) {
+    CacheKey key{ sat, time };
+    auto it = mesh_cache_.find(key);
+
+    if (it != mesh_cache_.end()) {
+        return it->second;
+    }
+
+    reseedFill(sat, time);
+    return MeshContainer::fromBits(generateRandomMesh(q), q);
+}
+
+std::vector<bool> CoverageDataLoader::loadMeshFromCSV(const std::string& filepath) {
+    try {
+        // 使用优化的CSV读取器
+        auto mesh_data = OptimizedCSVReader::readSingleColumnCSV(filepath, q_);
+
+        // 确保数据量正确
+        if (mesh_data.size() < q_) {
+            std::cout << "警告: 文件 " << filepath << " 只有 " << mesh_data.size()
+                << " 行数据，需要 " << q_ << " 行，用随机数据填充" << std::endl;
+
+            while (mesh_data.size() < q_) {
+                mesh_data.push_back(dist_(gen_));
+            }
+        }
+        else if (mesh_data.size() > q_) {
+            mesh_data.resize(q_);
+            std::cout << "警告: 文件 " << filepath << " 有 " << mesh_data.size()
+                << " 行数据，超过需要的 " << q_ << " 行，已截断" << std::endl;
+        }
+
+        return mesh_data;
+
+    }
+    catch (const std::exception& e) {
+        std::cerr << "加载CSV文件错误: " << filepath << " - " << e.what() << std::endl;
+        throw; // 重新抛出异常
+    }
+}
+std::vector<bool> CoverageDataLoader::generateRandomMesh(int q) {
+    std::vector<bool> random_data;
+    random_data.reserve(q);
+
+    for (int i = 0; i < q; ++i) {
+        random_data.push_back(dist_(gen_));
+    }
+
+    return random_data;
+}
+
+void CoverageDataLoader::reseedFill(int sat, int time) {
+    if (fill_seed_ == 0) {
+        return;
+    }
+    std::seed_seq seq{ fill_seed_, static_cast<uint32_t>(sat), static_cast<uint32_t>(time) };
+    gen_.seed(seq);
+    dist_.reset();
+}
+
+bool CoverageDataLoader::loadGridWeights(const std::string& filename) {
+    std::error_code ec;
+    std::string filepath = filename;
+    if (!data_dir_.empty() && std::filesystem::is_directory(data_dir_, ec)) {
+        filepath = (std::filesystem::path(data_dir_) / filename).string();
+    }
+
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "无法打开网格点权重文件: " << filepath << std::endl;
+        return false;
+    }
+
+    std::vector<double> weights;
+    weights.reserve(q_);
+    std::string line;
+    while (std::getline(file, line)) {
+        size_t first = line.find_first_not_of(" \t\r\"");
+        if (first == std::string::npos) continue;
+
+        char* end = nullptr;
+        double w = std::strtod(line.c_str() + first, &end);
+        if (end == line.c_str() + first) {
+            // 首行可以是表头
+            if (weights.empty()) continue;
+            std::cerr << "网格点权重文件格式错误: " << filepath << " 第 " << weights.size() + 1 << " 个值" << std::endl;
+            return false;
+        }
+        weights.push_back(w);
+    }
+
+    if (static_cast<int>(weights.size()) != q_) {
+        std::cerr << "网格点权重文件有 " << weights.size() << " 个值，需要 " << q_ << " 个: " << filepath << std::endl;
+        return false;
+    }
+
+    grid_weights_ = std::move(weights);
+    std::cout << "已加载网格点权重: " << filepath << std::endl;
+    return true;
+}
+
+std::vector<double> CoverageDataLoader::latitudeWeights(int lat_rows, int lon_cols, double north, double south) {
+    const double kDegree = 3.14159265358979323846 / 180.0;
+    std::vector<double> weights;
+    weights.reserve(static_cast<size_t>(lat_rows) * lon_cols);
+    for (int r = 0; r < lat_rows; ++r) {
+        double latitude = north + (south - north) * (r + 0.5) / lat_rows;
+        double w = std::max(0.0, std::cos(latitude * kDegree));
+        weights.insert(weights.end(), lon_cols, w);
+    }
+    return weights;
+}
+
+std::string CoverageDataLoader::makeFilename(int sat, int time) const {
+    return "s" + std::to_string(sat) + "_" + std::to_string(time) + ".csv";
+}
+
+std::string CoverageDataLoader::makeFilepath(int sat, int time) const {
+    std::error_code ec;
+    if (!data_dir_.empty() && std::filesystem::is_directory(data_dir_, ec)) {
+        return (std::filesystem::path(data_dir_) / makeFilename(sat, time)).string();
+    }
+    return makeFilename(sat, time);
 }
\ No newline at end of file
@@ -1,49 +1,75 @@
-#pragma once
-// coverage_loader.h
-#pragma once
-#include <vector>
-#include <string>
-#include <unordered_map>
-#include <memory>
-#include <fstream>
-#include <sstream>
-#include <random>
-
-class CoverageDataLoader {
-private:
-    struct CacheKey {
-        int satellite;
-        int time_point;
-
-        bool operator==(const CacheKey& other) const {
-            return satellite == other.satellite && time_point == other.time_point;
-        }
-    };
-
-    struct CacheKeyHash {
-        std::size_t operator()(const CacheKey& key) const {
-            return std::hash<int>()(key.satellite) ^ (std::hash<int>()(key.time_point) << 1);
-        }
-    };
-
-public:
-    CoverageDataLoader(const std::string& data_dir = "mesh_data");
-    void preloadAllData(const std::vector<int>& satellites, const std::vector<int>& special_times);
-    std::vector<bool> getMeshData(int sat, int time, int q);
-
-    int getQ() const { return q_; }
-
-private:
-    std::vector<bool> loadMeshFromCSV(const std::string& filepath);
-    std::vector<bool> generateRandomMesh(int q);
-    std::string makeFilename(int sat, int time) const;
-
-    std::string data_dir_;
-    std::unordered_map<CacheKey, std::vector<bool>, CacheKeyHash> mesh_cache_;
-    const int q_ = 6665;
-
-    // 
-    std::random_device rd_;
-    std::mt19937 gen_;
-    std::bernoulli_distribution dist_;
+#pragma once
+// coverage_loader.h
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include "mesh_container.h"
+
+class CoverageDataLoader {
+private:
+    struct CacheKey {
+        int satellite;
+        int time_point;
+
+        bool operator==(const CacheKey& other) const {
+            return satellite == other.satellite && time_point == other.time_point;
+        }
+    };
+
+    struct CacheKeyHash {
+        std::size_t operator()(const CacheKey& key) const {
+            return std::hash<int>()(key.satellite) ^ (std::hash<int>()(key.time_point) << 1);
+        }
+    };
+
+public:
+    // data_dir 存在时从该目录读取网格文件，否则从当前目录读取
+    CoverageDataLoader(const std::string& data_dir = "mesh_data", int q = 6665);
+    void preloadAllData(const std::vector<int>& satellites, const std::vector<int>& special_times);
+    std::vector<bool> getMeshData(int sat, int time, int q);
+    // 与 getMeshData 相同的网格，以压缩容器形式返回（缓存本身即按此形式保存，不需要展开）
+    MeshContainer getMesh(int sat, int time, int q);
+    // 缓存的网格个数与占用字节数
+    size_t cachedMeshes() const { return mesh_cache_.size(); }
+    size_t cacheBytes() const;
+
+    int getQ() const { return q_; }
+    // 缺失网格的填充数据改为由 (seed, 卫星, 时间点) 决定，便于复现；seed 为 0 时恢复随机填充
+    // 需在 preloadAllData 之前设置
+    void setFillSeed(uint32_t seed) { fill_seed_ = seed; }
+    // 网格文件的实际读取路径
+    std::string makeFilepath(int sat, int time) const;
+
+    // 网格点权重（见 PackedCoverage::setWeights）：从网格目录（或当前目录）下的单列 CSV 读取，
+    // 每行一个非负权重，顺序与网格文件相同；文件不存在或行数不等于 q 时返回 false 且权重不变
+    bool loadGridWeights(const std::string& filename = "grid_weights.csv");
+    void setGridWeights(const std::vector<double>& weights) { grid_weights_ = weights; }
+    const std::vector<double>& getGridWeights() const { return grid_weights_; }
+
+    // 经纬度网格的面积权重：lat_rows 行、lon_cols 列，自北向南、自西向东排列（与网格文件一致），
+    // 每行的权重为该行中心纬度的余弦；north / south 为首行上沿与末行下沿的纬度（度）
+    static std::vector<double> latitudeWeights(int lat_rows, int lon_cols, double north, double south);
+
+private:
+    std::vector<bool> loadMeshFromCSV(const std::string& filepath);
+    std::vector<bool> generateRandomMesh(int q);
+    // 固定填充种子时，为 (sat, time) 的网格重新播种
+    void reseedFill(int sat, int time);
+    std::string makeFilename(int sat, int time) const;
+
+    std::string data_dir_;
+    std::unordered_map<CacheKey, MeshContainer, CacheKeyHash> mesh_cache_;
+    int q_ = 6665;
+
+    // 随机数生成器
+    std::random_device rd_;
+    std::mt19937 gen_;
+    std::bernoulli_distribution dist_;
+    uint32_t fill_seed_ = 0;
+    std::vector<double> grid_weights_;
 };
\ No newline at end of file
@@ -0,0 +1,150 @@
+// fast_rng.cpp
+#include "fast_rng.h"
+
+namespace {
+    uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    const uint32_t kPhiloxM0 = 0xD2511F53u;
+    const uint32_t kPhiloxM1 = 0xCD9E8D57u;
+    const uint32_t kPhiloxW0 = 0x9E3779B9u;
+    const uint32_t kPhiloxW1 = 0xBB67AE85u;
+    const uint32_t kStateTag = 0x52574631u;    // "1FWR"
+}
+
+void Xoshiro256::seed_state(uint64_t seed) {
+    uint64_t x = seed;
+    for (uint64_t& word : s_) {
+        word = splitmix64(x);
+    }
+}
+
+void Xoshiro256::setState(const uint64_t* state) {
+    for (int i = 0; i < 4; ++i) {
+        s_[i] = state[i];
+    }
+}
+
+void Philox4x32::reset(uint64_t seed, uint32_t generation, uint32_t firework, uint32_t spark) {
+    key_[0] = static_cast<uint32_t>(seed);
+    key_[1] = static_cast<uint32_t>(seed >> 32);
+    counter_[0] = 0;
+    counter_[1] = spark;
+    counter_[2] = firework;
+    counter_[3] = generation;
+    used_ = 2 * kBlocks;
+}
+
+void Philox4x32::refill() {
+    uint32_t c0[kBlocks], c1[kBlocks], c2[kBlocks], c3[kBlocks];
+    for (int b = 0; b < kBlocks; ++b) {
+        c0[b] = counter_[0] + static_cast<uint32_t>(b);
+        c1[b] = counter_[1];
+        c2[b] = counter_[2];
+        c3[b] = counter_[3];
+    }
+
+    uint32_t k0 = key_[0];
+    uint32_t k1 = key_[1];
+    for (int round = 0; round < 10; ++round) {
+        for (int b = 0; b < kBlocks; ++b) {
+            uint64_t p0 = static_cast<uint64_t>(kPhiloxM0) * c0[b];
+            uint64_t p1 = static_cast<uint64_t>(kPhiloxM1) * c2[b];
+            uint32_t next0 = static_cast<uint32_t>(p1 >> 32) ^ c1[b] ^ k0;
+            uint32_t next2 = static_cast<uint32_t>(p0 >> 32) ^ c3[b] ^ k1;
+            c1[b] = static_cast<uint32_t>(p1);
+            c3[b] = static_cast<uint32_t>(p0);
+            c0[b] = next0;
+            c2[b] = next2;
+        }
+        k0 += kPhiloxW0;
+        k1 += kPhiloxW1;
+    }
+
+    for (int b = 0; b < kBlocks; ++b) {
+        output_[2 * b] = (static_cast<uint64_t>(c1[b]) << 32) | c0[b];
+        output_[2 * b + 1] = (static_cast<uint64_t>(c3[b]) << 32) | c2[b];
+    }
+    used_ = 0;
+
+    // 块序号只占计数器第一个字：单个火花最多 2^35 次抽取，远超实际需要
+    counter_[0] += kBlocks;
+}
+
+void RandomSource::seed(uint64_t seed, Engine engine) {
+    seed_ = seed;
+    engine_ = engine;
+    xoshiro_.seed_state(seed);
+    in_stream_ = false;
+}
+
+void RandomSource::beginStream(uint32_t generation, uint32_t firework, uint32_t spark) {
+    if (engine_ != Engine::Philox) {
+        return;
+    }
+    philox_.reset(seed_, generation, firework, spark);
+    in_stream_ = true;
+}
+
+void RandomSource::fillInts(int lo, int hi, int* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = uniformInt(lo, hi);
+    }
+}
+
+void RandomSource::fillBernoulli(double probability, uint64_t* bits, size_t n) {
+    size_t words = (n + 63) / 64;
+    if (probability == 0.5) {
+        for (size_t w = 0; w < words; ++w) {
+            bits[w] = (*this)();
+        }
+    }
+    else {
+        // 每次 64 位抽取拆成两个 32 位均匀数，与阈值比较
+        uint64_t threshold = probability <= 0.0 ? 0 :
+            probability >= 1.0 ? (1ULL << 32) : static_cast<uint64_t>(probability * 4294967296.0);
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t word = 0;
+            for (int b = 0; b < 64; b += 2) {
+                uint64_t x = (*this)();
+                word |= static_cast<uint64_t>((x & 0xFFFFFFFFu) < threshold) << b;
+                word |= static_cast<uint64_t>((x >> 32) < threshold) << (b + 1);
+            }
+            bits[w] = word;
+        }
+    }
+
+    if (n % 64 != 0) {
+        bits[words - 1] &= (1ULL << (n % 64)) - 1;
+    }
+}
+
+std::vector<uint32_t> RandomSource::saveState() const {
+    std::vector<uint32_t> state = { kStateTag, static_cast<uint32_t>(engine_),
+        static_cast<uint32_t>(seed_), static_cast<uint32_t>(seed_ >> 32) };
+    for (int i = 0; i < 4; ++i) {
+        uint64_t word = xoshiro_.state()[i];
+        state.push_back(static_cast<uint32_t>(word));
+        state.push_back(static_cast<uint32_t>(word >> 32));
+    }
+    return state;
+}
+
+bool RandomSource::restoreState(const std::vector<uint32_t>& state) {
+    if (state.size() != 12 || state[0] != kStateTag || state[1] > static_cast<uint32_t>(Engine::Philox)) {
+        return false;
+    }
+    engine_ = static_cast<Engine>(state[1]);
+    seed_ = (static_cast<uint64_t>(state[3]) << 32) | state[2];
+    uint64_t words[4];
+    for (int i = 0; i < 4; ++i) {
+        words[i] = (static_cast<uint64_t>(state[5 + 2 * i]) << 32) | state[4 + 2 * i];
+    }
+    xoshiro_.setState(words);
+    in_stream_ = false;
+    return true;
+}
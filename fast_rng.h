@@ -0,0 +1,139 @@
+#pragma once
+// fast_rng.h
+// 优化器使用的随机数层：小状态的 xoshiro256** 与计数器型的 Philox4x32-10，
+// 以及在二者之间切换、提供有界整数 / 伯努利批量抽样的 RandomSource
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// xoshiro256**：32 字节状态，周期 2^256-1，满足 UniformRandomBitGenerator，可直接用于 std::shuffle
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seed = 0) { seed_state(seed); }
+
+    // 由 splitmix64 展开种子，保证状态不全为 0
+    void seed_state(uint64_t seed);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    const uint64_t* state() const { return s_; }
+    void setState(const uint64_t* state);
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s_[4];
+};
+
+// Philox4x32-10：输出是 (密钥, 计数器) 的纯函数，不同计数器的序列互相独立，可以跳到任意位置
+// 计数器的四个字依次为：块序号、火花、烟花、代
+class Philox4x32 {
+public:
+    using result_type = uint64_t;
+
+    Philox4x32() = default;
+    Philox4x32(uint64_t seed, uint32_t generation, uint32_t firework, uint32_t spark) {
+        reset(seed, generation, firework, spark);
+    }
+
+    void reset(uint64_t seed, uint32_t generation, uint32_t firework, uint32_t spark);
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    // 每个块产生 4 个 32 位字，即 2 次 64 位输出；一次连续计算 kBlocks 个块以便编译器向量化
+    result_type operator()() {
+        if (used_ == 2 * kBlocks) {
+            refill();
+        }
+        return output_[used_++];
+    }
+
+private:
+    static constexpr int kBlocks = 4;
+
+    void refill();
+
+    uint32_t key_[2] = { 0, 0 };
+    uint32_t counter_[4] = { 0, 0, 0, 0 };
+    uint64_t output_[2 * kBlocks] = {};
+    int used_ = 2 * kBlocks;
+};
+
+// 优化器的随机数来源：默认从 xoshiro256** 抽取；beginStream 后切换到由 (种子, 代, 烟花, 火花)
+// 决定的 Philox 序列，endStream 后回到 xoshiro 序列（其状态不受影响）
+class RandomSource {
+public:
+    using result_type = uint64_t;
+
+    enum class Engine { Xoshiro, Philox };
+
+    explicit RandomSource(uint64_t seed = 0) : seed_(seed), xoshiro_(seed) {}
+
+    void seed(uint64_t seed, Engine engine);
+    uint64_t seedValue() const { return seed_; }
+    Engine engine() const { return engine_; }
+
+    // 仅 Philox 模式下生效；Xoshiro 模式下火花继续使用主序列
+    void beginStream(uint32_t generation, uint32_t firework, uint32_t spark);
+    void endStream() { in_stream_ = false; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() { return in_stream_ ? philox_() : xoshiro_(); }
+
+    // [lo, hi] 上的均匀整数（Lemire 乘法映射，拒绝采样保证无偏）
+    int uniformInt(int lo, int hi) {
+        uint32_t range = static_cast<uint32_t>(hi - lo) + 1u;
+        if (range == 0) {
+            return static_cast<int>(static_cast<uint32_t>((*this)() >> 32));
+        }
+        uint64_t m = ((*this)() >> 32) * range;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                m = ((*this)() >> 32) * range;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return lo + static_cast<int>(m >> 32);
+    }
+
+    // [0, 1) 上的均匀实数（53 位精度）
+    double uniform01() { return static_cast<double>((*this)() >> 11) * (1.0 / 9007199254740992.0); }
+    bool bernoulli(double probability) { return uniform01() < probability; }
+
+    // 批量抽样：n 个 [lo, hi] 上的整数
+    void fillInts(int lo, int hi, int* out, size_t n);
+    // n 个伯努利位，按 64 位一字打包到 bits（需至少 (n+63)/64 个字）；p 为 0.5 时每次抽取直接提供 64 位
+    void fillBernoulli(double probability, uint64_t* bits, size_t n);
+
+    // 断点用的状态字：引擎、种子和 xoshiro 状态（Philox 序列只由计数器决定，无需保存）
+    std::vector<uint32_t> saveState() const;
+    bool restoreState(const std::vector<uint32_t>& state);
+
+private:
+    uint64_t seed_;
+    Engine engine_ = Engine::Xoshiro;
+    Xoshiro256 xoshiro_;
+    Philox4x32 philox_;
+    bool in_stream_ = false;
+};
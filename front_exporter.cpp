@@ -0,0 +1,395 @@
+// front_exporter.cpp
+#include "front_exporter.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char kFrontMagic[4] = { 'F', 'W', 'F', 'R' };
+    const uint32_t kFrontVersion = 1;
+    const size_t kHeaderSize = 64;
+
+    struct FrontHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t objectives;
+        uint32_t solutions;
+        uint32_t satellites;
+        uint32_t columns;
+        int32_t start_minute;
+        uint32_t reserved;
+        uint64_t names_offset;
+        uint64_t objectives_offset;
+        uint64_t windows_offset;
+        uint64_t schedules_offset;
+    };
+    static_assert(sizeof(FrontHeader) == kHeaderSize, "前沿文件头部应为 64 字节");
+    static_assert(sizeof(FrontInterval) == 8, "区间应为两个 int32");
+
+    size_t align8(size_t offset) {
+        return (offset + 7) & ~static_cast<size_t>(7);
+    }
+
+    void pad(std::ofstream& out, size_t& offset) {
+        static const char zeros[8] = {};
+        size_t aligned = align8(offset);
+        out.write(zeros, aligned - offset);
+        offset = aligned;
+    }
+
+    // 区间段：L、T、L+1 个前缀下标，对齐后是区间数组；offset 随写入推进
+    void writeIntervals(std::ofstream& out, size_t& offset, const std::vector<uint32_t>& index,
+        const std::vector<FrontInterval>& intervals) {
+
+        uint32_t lists = static_cast<uint32_t>(index.size() - 1);
+        uint32_t total = static_cast<uint32_t>(intervals.size());
+        out.write(reinterpret_cast<const char*>(&lists), sizeof(lists));
+        out.write(reinterpret_cast<const char*>(&total), sizeof(total));
+        out.write(reinterpret_cast<const char*>(index.data()), sizeof(uint32_t) * index.size());
+        offset += 2 * sizeof(uint32_t) + sizeof(uint32_t) * index.size();
+        pad(out, offset);
+        out.write(reinterpret_cast<const char*>(intervals.data()), sizeof(FrontInterval) * intervals.size());
+        offset += sizeof(FrontInterval) * intervals.size();
+    }
+
+    std::string clockTime(int start_minute, int minute) {
+        int total = start_minute + minute;
+        std::ostringstream ss;
+        ss << std::setw(2) << std::setfill('0') << total / 60 << ":"
+            << std::setw(2) << std::setfill('0') << total % 60;
+        return ss.str();
+    }
+
+    // 导出器与只读视图共用的 CSV 输出；objective(i, k) 取目标值，schedule(i, s) 返回可遍历的区间序列
+    template <typename ObjectiveAt, typename ScheduleAt>
+    bool writeCsvFiles(const std::string& prefix, const std::vector<std::string>& names, int solutions,
+        int satellites, int start_minute, ObjectiveAt objective, ScheduleAt schedule) {
+
+        std::ofstream obj_out(prefix + "_objectives.csv");
+        std::ofstream sched_out(prefix + "_schedules.csv");
+        if (!obj_out.is_open() || !sched_out.is_open()) {
+            std::cerr << "无法写入前沿 CSV: " << prefix << std::endl;
+            return false;
+        }
+
+        obj_out << "solution";
+        for (const auto& name : names) {
+            obj_out << "," << name;
+        }
+        obj_out << "\n" << std::setprecision(17);
+        for (int i = 0; i < solutions; ++i) {
+            obj_out << i + 1;
+            for (size_t k = 0; k < names.size(); ++k) {
+                obj_out << "," << objective(i, static_cast<int>(k));
+            }
+            obj_out << "\n";
+        }
+
+        // 卫星编号与 satellite_<i>.csv 一致（从 1 开始）
+        sched_out << "solution,satellite,start_minute,end_minute,start_time,end_time\n";
+        for (int i = 0; i < solutions; ++i) {
+            for (int s = 0; s < satellites; ++s) {
+                for (const FrontInterval& interval : schedule(i, s)) {
+                    sched_out << i + 1 << "," << s + 1 << "," << interval.start << "," << interval.end << ","
+                        << clockTime(start_minute, interval.start) << "," << clockTime(start_minute, interval.end) << "\n";
+                }
+            }
+        }
+
+        return static_cast<bool>(obj_out) && static_cast<bool>(sched_out);
+    }
+}
+
+FrontExporter::FrontExporter(const std::vector<std::vector<int>>& compressed, const std::vector<int>& bounds,
+    int start_minute)
+    : rows_(static_cast<int>(compressed.size())), cols_(static_cast<int>(bounds.size())),
+    start_minute_(start_minute), bounds_(bounds), objective_columns_(ActiveObjectives::N) {
+
+    window_index_.push_back(0);
+    for (const auto& row : compressed) {
+        auto runs = toIntervals(row, bounds_, 0);
+        windows_.insert(windows_.end(), runs.begin(), runs.end());
+        window_index_.push_back(static_cast<uint32_t>(windows_.size()));
+    }
+    schedule_index_.push_back(0);
+}
+
+void FrontExporter::add(const std::vector<std::vector<int>>& solution, const ScheduleMetrics& metrics) {
+    auto values = ActiveObjectives::raw(metrics);
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        objective_columns_[k].push_back(values[k]);
+    }
+
+    for (int sat = 0; sat < rows_; ++sat) {
+        if (sat < static_cast<int>(solution.size())) {
+            auto runs = toIntervals(solution[sat], bounds_, 1);
+            schedules_.insert(schedules_.end(), runs.begin(), runs.end());
+        }
+        schedule_index_.push_back(static_cast<uint32_t>(schedules_.size()));
+    }
+    solutions_++;
+}
+
+std::vector<FrontInterval> FrontExporter::toIntervals(const std::vector<int>& row, const std::vector<int>& bounds,
+    int min_value) {
+
+    std::vector<FrontInterval> runs;
+    size_t n = std::min(row.size(), bounds.size());
+    for (size_t j = 0; j < n; ++j) {
+        if (row[j] < min_value) continue;
+
+        int minute = bounds[j];
+        if (!runs.empty() && runs.back().end + 1 == minute) {
+            runs.back().end = minute;
+        }
+        else {
+            runs.push_back({ minute, minute });
+        }
+    }
+    return runs;
+}
+
+bool FrontExporter::writeBinary(const std::string& path) const {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "无法写入前沿文件: " << tmp_path << std::endl;
+            return false;
+        }
+
+        // 头部的各段偏移在写完后回填
+        FrontHeader header{};
+        std::memcpy(header.magic, kFrontMagic, sizeof(kFrontMagic));
+        header.version = kFrontVersion;
+        header.objectives = ActiveObjectives::N;
+        header.solutions = static_cast<uint32_t>(solutions_);
+        header.satellites = static_cast<uint32_t>(rows_);
+        header.columns = static_cast<uint32_t>(cols_);
+        header.start_minute = start_minute_;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        size_t offset = sizeof(header);
+
+        header.names_offset = offset;
+        for (int k = 0; k < ActiveObjectives::N; ++k) {
+            std::string name = ActiveObjectives::name(k);
+            uint8_t flags[2] = { static_cast<uint8_t>(ActiveObjectives::minimize(k) ? 1 : 0), 0 };
+            uint16_t length = static_cast<uint16_t>(name.size());
+            out.write(reinterpret_cast<const char*>(flags), sizeof(flags));
+            out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+            out.write(name.data(), length);
+            offset += sizeof(flags) + sizeof(length) + length;
+        }
+        pad(out, offset);
+
+        header.objectives_offset = offset;
+        for (const auto& column : objective_columns_) {
+            out.write(reinterpret_cast<const char*>(column.data()), sizeof(double) * column.size());
+            offset += sizeof(double) * column.size();
+        }
+
+        header.windows_offset = offset;
+        writeIntervals(out, offset, window_index_, windows_);
+        pad(out, offset);
+
+        header.schedules_offset = offset;
+        writeIntervals(out, offset, schedule_index_, schedules_);
+        pad(out, offset);
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        if (!out) {
+            std::cerr << "前沿文件写入失败: " << tmp_path << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::cerr << "前沿文件替换失败: " << path << " - " << ec.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool FrontExporter::writeCsv(const std::string& prefix) const {
+    std::vector<std::string> names;
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        names.push_back(ActiveObjectives::name(k));
+    }
+
+    return writeCsvFiles(prefix, names, static_cast<int>(solutions_), rows_, start_minute_,
+        [this](int i, int k) { return objective_columns_[k][i]; },
+        [this](int i, int s) {
+            size_t list = static_cast<size_t>(i) * rows_ + s;
+            return FrontFileView::Intervals{ schedules_.data() + schedule_index_[list],
+                schedule_index_[list + 1] - schedule_index_[list] };
+        });
+}
+
+FrontFileView::~FrontFileView() {
+    close();
+}
+
+void FrontFileView::close() {
+    if (base_) {
+#if defined(_WIN32)
+        UnmapViewOfFile(base_);
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        CloseHandle(static_cast<HANDLE>(file_));
+        mapping_ = nullptr;
+        file_ = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(base_), length_);
+#endif
+    }
+    base_ = nullptr;
+    length_ = 0;
+    objectives_ = solutions_ = satellites_ = columns_ = 0;
+    names_.clear();
+    minimize_.clear();
+}
+
+bool FrontFileView::open(const std::string& path) {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "无法打开前沿文件: " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+    }
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "无法映射前沿文件: " << path << std::endl;
+        return false;
+    }
+    file_ = file;
+    mapping_ = mapping;
+    base_ = static_cast<const uint8_t*>(view);
+    length_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "无法打开前沿文件: " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        std::cerr << "无法映射前沿文件: " << path << std::endl;
+        return false;
+    }
+    base_ = static_cast<const uint8_t*>(view);
+    length_ = static_cast<size_t>(st.st_size);
+#endif
+
+    auto fail = [&](const char* reason) {
+        std::cerr << "前沿文件格式错误（" << reason << "）: " << path << std::endl;
+        close();
+        return false;
+    };
+
+    if (length_ < kHeaderSize) return fail("头部不完整");
+    FrontHeader header;
+    std::memcpy(&header, base_, sizeof(header));
+    if (std::memcmp(header.magic, kFrontMagic, sizeof(kFrontMagic)) != 0) return fail("魔数不符");
+    if (header.version != kFrontVersion) return fail("版本不支持");
+
+    objectives_ = static_cast<int>(header.objectives);
+    solutions_ = static_cast<int>(header.solutions);
+    satellites_ = static_cast<int>(header.satellites);
+    columns_ = static_cast<int>(header.columns);
+    start_minute_ = header.start_minute;
+
+    size_t offset = header.names_offset;
+    for (int k = 0; k < objectives_; ++k) {
+        if (offset + 4 > length_) return fail("名称段越界");
+        uint16_t name_length;
+        std::memcpy(&name_length, base_ + offset + 2, sizeof(name_length));
+        if (offset + 4 + name_length > length_) return fail("名称段越界");
+        minimize_.push_back(base_[offset] != 0);
+        names_.emplace_back(reinterpret_cast<const char*>(base_ + offset + 4), name_length);
+        offset += 4 + name_length;
+    }
+
+    size_t table_bytes = sizeof(double) * objectives_ * static_cast<size_t>(solutions_);
+    if (header.objectives_offset % 8 != 0 || header.objectives_offset + table_bytes > length_) {
+        return fail("目标表越界");
+    }
+    objective_table_ = reinterpret_cast<const double*>(base_ + header.objectives_offset);
+
+    // 区间段：检查列表数与前缀下标，返回 false 表示越界
+    auto mapIntervals = [&](uint64_t section, uint32_t expected_lists, const uint32_t*& index,
+        const FrontInterval*& intervals) {
+
+        if (section % 8 != 0 || section + 8 > length_) return false;
+        uint32_t lists, total;
+        std::memcpy(&lists, base_ + section, sizeof(lists));
+        std::memcpy(&total, base_ + section + 4, sizeof(total));
+        size_t index_end = section + 8 + sizeof(uint32_t) * (static_cast<size_t>(lists) + 1);
+        size_t data = align8(index_end);
+        if (lists != expected_lists || data + sizeof(FrontInterval) * static_cast<size_t>(total) > length_) {
+            return false;
+        }
+        index = reinterpret_cast<const uint32_t*>(base_ + section + 8);
+        intervals = reinterpret_cast<const FrontInterval*>(base_ + data);
+        for (uint32_t l = 0; l < lists; ++l) {
+            if (index[l] > index[l + 1]) return false;
+        }
+        return index[0] == 0 && index[lists] == total;
+    };
+
+    if (!mapIntervals(header.windows_offset, static_cast<uint32_t>(satellites_), window_index_, windows_)) {
+        return fail("可见窗口段越界");
+    }
+    if (!mapIntervals(header.schedules_offset, static_cast<uint32_t>(solutions_ * satellites_),
+        schedule_index_, schedules_)) {
+        return fail("调度段越界");
+    }
+    return true;
+}
+
+FrontFileView::Intervals FrontFileView::windows(int satellite) const {
+    return { windows_ + window_index_[satellite], window_index_[satellite + 1] - window_index_[satellite] };
+}
+
+FrontFileView::Intervals FrontFileView::schedule(int solution, int satellite) const {
+    size_t list = static_cast<size_t>(solution) * satellites_ + satellite;
+    return { schedules_ + schedule_index_[list], schedule_index_[list + 1] - schedule_index_[list] };
+}
+
+bool FrontFileView::writeCsv(const std::string& prefix) const {
+    return writeCsvFiles(prefix, names_, solutions_, satellites_, start_minute_,
+        [this](int i, int k) { return objective(i, k); },
+        [this](int i, int s) { return schedule(i, s); });
+}
@@ -0,0 +1,113 @@
+#pragma once
+// front_exporter.h
+// 前沿的二进制列式导出与只读映射读取
+//
+// 文件布局（小端，各段按 8 字节对齐，读取方可直接在映射内存上访问）：
+//   头部 64 字节   "FWFR"、版本、目标数 K、解数 N、卫星数 M、压缩列数、观测开始的当天分钟数、保留字，
+//                  以及名称段 / 目标表 / 可见窗口段 / 调度段的文件偏移（各 uint64）
+//   名称段         K 项：uint8 是否最小化、uint8 保留、uint16 字节数、名称字节
+//   目标表         按列存放：第 k 个目标的 N 个原始值（未取负、未归一化）连续排列
+//   区间段         uint32 列表数 L、uint32 区间总数 T、L+1 个 uint32 前缀下标，对齐后是 T 个 FrontInterval
+//                  可见窗口段 L = M（每颗卫星的可见窗口）；调度段 L = N*M（按解、卫星顺序的开机区间）
+// 区间是相对观测开始的原始分钟上的闭区间：压缩列经 bounds 换回原始分钟，分钟不连续处断开
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "objective_policies.h"
+
+struct FrontInterval {
+    int32_t start;      // 首个分钟（含）
+    int32_t end;        // 末个分钟（含）
+};
+
+class FrontExporter {
+public:
+    // compressed 为问题的压缩窗口矩阵（-1 表示不可见），bounds 为压缩列对应的原始分钟
+    FrontExporter(const std::vector<std::vector<int>>& compressed, const std::vector<int>& bounds,
+        int start_minute = 8 * 60);
+
+    void add(const std::vector<std::vector<int>>& solution, const ScheduleMetrics& metrics);
+    size_t size() const { return solutions_; }
+
+    bool writeBinary(const std::string& path) const;
+    // 写出 <prefix>_objectives.csv（每解一行）与 <prefix>_schedules.csv（每个开机区间一行）
+    bool writeCsv(const std::string& prefix) const;
+
+    // 一行压缩列上取值不小于 min_value 的单元合并为原始分钟上的区间（min_value 为 0 取可见窗口，为 1 取开机）
+    static std::vector<FrontInterval> toIntervals(const std::vector<int>& row, const std::vector<int>& bounds,
+        int min_value);
+
+private:
+    int rows_;
+    int cols_;
+    int start_minute_;
+    std::vector<int> bounds_;
+    size_t solutions_ = 0;
+
+    std::vector<std::vector<double>> objective_columns_;    // [目标][解]
+    std::vector<uint32_t> window_index_;
+    std::vector<FrontInterval> windows_;
+    std::vector<uint32_t> schedule_index_;
+    std::vector<FrontInterval> schedules_;
+};
+
+// 导出文件的只读视图：整个文件映射到内存，访问器直接返回映射内的指针，不做拷贝
+class FrontFileView {
+public:
+    struct Intervals {
+        const FrontInterval* data = nullptr;
+        size_t count = 0;
+
+        const FrontInterval* begin() const { return data; }
+        const FrontInterval* end() const { return data + count; }
+    };
+
+    FrontFileView() = default;
+    ~FrontFileView();
+    FrontFileView(const FrontFileView&) = delete;
+    FrontFileView& operator=(const FrontFileView&) = delete;
+
+    // 打开并校验文件（魔数、版本、各段范围），失败时返回 false 且视图为空
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return base_ != nullptr; }
+
+    int objectiveCount() const { return objectives_; }
+    int solutionCount() const { return solutions_; }
+    int satelliteCount() const { return satellites_; }
+    int columnCount() const { return columns_; }
+    int startMinute() const { return start_minute_; }
+
+    std::string objectiveName(int k) const { return names_[k]; }
+    bool objectiveMinimized(int k) const { return minimize_[k]; }
+    // 第 k 个目标的全部解的取值（solutionCount() 个）
+    const double* objectiveColumn(int k) const { return objective_table_ + static_cast<size_t>(k) * solutions_; }
+    double objective(int solution, int k) const { return objectiveColumn(k)[solution]; }
+
+    Intervals windows(int satellite) const;
+    Intervals schedule(int solution, int satellite) const;
+
+    // 与 FrontExporter::writeCsv 相同的 CSV 输出
+    bool writeCsv(const std::string& prefix) const;
+
+private:
+    const uint8_t* base_ = nullptr;
+    size_t length_ = 0;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+
+    int objectives_ = 0;
+    int solutions_ = 0;
+    int satellites_ = 0;
+    int columns_ = 0;
+    int start_minute_ = 0;
+    std::vector<std::string> names_;
+    std::vector<bool> minimize_;
+    const double* objective_table_ = nullptr;
+    const uint32_t* window_index_ = nullptr;
+    const FrontInterval* windows_ = nullptr;
+    const uint32_t* schedule_index_ = nullptr;
+    const FrontInterval* schedules_ = nullptr;
+};
@@ -0,0 +1,90 @@
+// front_metrics.cpp
+#include "front_metrics.h"
+#include <algorithm>
+
+namespace front_metrics {
+
+    void ObjectiveRange::include(const ObjectivePoint& point) {
+        if (min_val.empty()) {
+            min_val = point;
+            max_val = point;
+            return;
+        }
+        for (size_t k = 0; k < point.size() && k < min_val.size(); ++k) {
+            min_val[k] = std::min(min_val[k], point[k]);
+            max_val[k] = std::max(max_val[k], point[k]);
+        }
+    }
+
+    ObjectivePoint normalize(const ObjectivePoint& point, const ObjectiveRange& range) {
+        ObjectivePoint result(point.size(), 0.0);
+        for (size_t k = 0; k < point.size() && k < range.min_val.size(); ++k) {
+            double span = range.max_val[k] - range.min_val[k];
+            result[k] = span > 0.0 ? (point[k] - range.min_val[k]) / span : 0.0;
+        }
+        return result;
+    }
+
+    namespace {
+        // 按最后一维切片（HSO）：最后一维排序后逐段累加低一维的超体积
+        // 前沿只有几十个点，O(n^d) 的代价可以接受
+        double sliceVolume(std::vector<ObjectivePoint> points, const ObjectivePoint& reference, int dims) {
+            if (points.empty()) {
+                return 0.0;
+            }
+            if (dims == 1) {
+                double best = reference[0];
+                for (const auto& p : points) {
+                    best = std::min(best, p[0]);
+                }
+                return reference[0] - best;
+            }
+
+            int last = dims - 1;
+            std::sort(points.begin(), points.end(),
+                [last](const ObjectivePoint& a, const ObjectivePoint& b) { return a[last] < b[last]; });
+
+            double volume = 0.0;
+            std::vector<ObjectivePoint> slice;
+            slice.reserve(points.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                slice.push_back(points[i]);
+                double upper = i + 1 < points.size() ? points[i + 1][last] : reference[last];
+                double height = upper - points[i][last];
+                if (height > 0.0) {
+                    volume += height * sliceVolume(slice, reference, last);
+                }
+            }
+            return volume;
+        }
+    }
+
+    double hypervolume(const std::vector<ObjectivePoint>& points, const ObjectivePoint& reference) {
+        std::vector<ObjectivePoint> inside;
+        for (const auto& p : points) {
+            bool dominates_reference = p.size() == reference.size();
+            for (size_t k = 0; dominates_reference && k < p.size(); ++k) {
+                dominates_reference = p[k] < reference[k];
+            }
+            if (dominates_reference) {
+                inside.push_back(p);
+            }
+        }
+        return sliceVolume(std::move(inside), reference, static_cast<int>(reference.size()));
+    }
+
+    double normalizedHypervolume(const std::vector<ObjectivePoint>& points, const ObjectiveRange& range,
+        double reference_offset) {
+
+        if (points.empty() || range.empty()) {
+            return 0.0;
+        }
+
+        std::vector<ObjectivePoint> normalized;
+        normalized.reserve(points.size());
+        for (const auto& p : points) {
+            normalized.push_back(normalize(p, range));
+        }
+        return hypervolume(normalized, ObjectivePoint(range.min_val.size(), reference_offset));
+    }
+}
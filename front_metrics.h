@@ -0,0 +1,27 @@
+#pragma once
+// front_metrics.h
+// 前沿质量指标，所有目标均按最小化方向（即 ObjectiveVector 的方向）
+#include <vector>
+
+namespace front_metrics {
+    using ObjectivePoint = std::vector<double>;
+
+    // 各目标的取值范围，用于把不同运行的前沿映射到同一尺度上比较
+    struct ObjectiveRange {
+        std::vector<double> min_val;
+        std::vector<double> max_val;
+
+        void include(const ObjectivePoint& point);
+        bool empty() const { return min_val.empty(); }
+    };
+
+    // 线性映射到 [0,1]，范围退化的目标取 0
+    ObjectivePoint normalize(const ObjectivePoint& point, const ObjectiveRange& range);
+
+    // 被前沿支配、且支配参考点的区域体积；不严格优于参考点的点不计入
+    double hypervolume(const std::vector<ObjectivePoint>& points, const ObjectivePoint& reference);
+
+    // 先按 range 归一化，再以 (reference_offset, ..., reference_offset) 为参考点计算超体积
+    double normalizedHypervolume(const std::vector<ObjectivePoint>& points, const ObjectiveRange& range,
+        double reference_offset = 1.1);
+}
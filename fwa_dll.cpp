@@ -0,0 +1,294 @@
+// fwa_dll.cpp
+#ifndef FWADLL_EXPORTS
+#define FWADLL_EXPORTS
+#endif
+#include "fwa_dll.h"
+#include "front_exporter.h"
+#include "satellite_data_loader.h"
+#include "satellite_scheduler_multiobjective.h"
+#include <cstring>
+#include <iostream>
+
+struct FWAScheduler {
+    SatelliteSchedulerMultiObjective scheduler;
+    SatelliteDataLoader loader;
+    std::string directory_path;
+
+    // 已加载的数据（跨多次 ExecuteScheduling 复用）
+    bool data_loaded = false;
+    std::string data_file;
+
+    // 最近一次调度结果的连续缓冲区
+    int rows = 0;
+    int cols = 0;
+    std::vector<ScheduleMetrics> metrics;
+    std::vector<double> objectives;
+    std::vector<int8_t> schedules;
+    std::vector<int> time_points;
+
+    std::string last_error;
+};
+
+namespace {
+    void fillResult(const FWAScheduler* handle, FWAScheduleResult* result) {
+        result->solution_count = static_cast<int>(handle->metrics.size());
+        result->objective_count = ActiveObjectives::N;
+        result->satellite_count = handle->rows;
+        result->time_count = handle->cols;
+        result->objectives = handle->objectives.empty() ? nullptr : handle->objectives.data();
+        result->schedules = handle->schedules.empty() ? nullptr : handle->schedules.data();
+        result->time_points = handle->time_points.empty() ? nullptr : handle->time_points.data();
+    }
+
+    bool loadData(FWAScheduler* handle, const std::string& data_file) {
+        auto& loader = handle->loader;
+        loader.loadDataFromExcel(handle->directory_path);
+        if (loader.getCompressedMatrix().empty() || loader.getBounds().empty()) {
+            handle->last_error = "未读取到任何卫星时间窗口数据: " + handle->directory_path;
+            return false;
+        }
+
+        if (!data_file.empty()) {
+            loader.saveCompressedData(data_file);
+        }
+
+        handle->scheduler.loadProblem(loader);
+
+        handle->data_loaded = true;
+        handle->data_file = data_file;
+        return true;
+    }
+
+    void storeSolutions(FWAScheduler* handle, const std::vector<std::vector<std::vector<int>>>& solutions) {
+        auto& scheduler = handle->scheduler;
+        const auto& compressed = scheduler.getCompressed();
+        handle->rows = static_cast<int>(compressed.size());
+        handle->cols = compressed.empty() ? 0 : static_cast<int>(compressed[0].size());
+        handle->time_points = scheduler.getBounds();
+
+        size_t cells = static_cast<size_t>(handle->rows) * handle->cols;
+        handle->metrics.clear();
+        handle->objectives.clear();
+        handle->metrics.reserve(solutions.size());
+        handle->objectives.reserve(solutions.size() * ActiveObjectives::N);
+        handle->schedules.resize(solutions.size() * cells);
+
+        int8_t* out = handle->schedules.data();
+        for (const auto& sol : solutions) {
+            // 评估结果已在优化过程中缓存，这里只是查表
+            auto metrics = scheduler.evaluate(sol, false);
+            handle->metrics.push_back(metrics);
+            auto values = ActiveObjectives::raw(metrics);
+            handle->objectives.insert(handle->objectives.end(), values.begin(), values.end());
+
+            for (const auto& row : sol) {
+                for (int value : row) {
+                    *out++ = static_cast<int8_t>(value);
+                }
+            }
+        }
+    }
+}
+
+void InitSchedulerParams(FWASchedulerParams* params) {
+    if (!params) return;
+
+    std::memset(params, 0, sizeof(FWASchedulerParams));
+    params->max_switches = 7;
+    params->q = 6665;
+    params->max_sparks = 30;
+    params->max_length = 10;
+    params->update_bounds = 1;
+    params->max_variation = 3;
+    params->num_satellites = 10;
+    params->start_hour = 8;
+    params->end_hour = 20;
+}
+
+FWAScheduler* CreateScheduler(const FWASchedulerParams* params) {
+    try {
+        FWASchedulerParams defaults;
+        InitSchedulerParams(&defaults);
+        if (!params) {
+            params = &defaults;
+        }
+
+        auto handle = std::make_unique<FWAScheduler>();
+        auto& scheduler = handle->scheduler;
+        scheduler.setMaxSwitches(params->max_switches);
+        scheduler.setQ(params->q);
+        scheduler.setMaxSparks(params->max_sparks);
+        scheduler.setMaxLength(params->max_length);
+        scheduler.setUpdateBounds(params->update_bounds != 0);
+        scheduler.setMaxVariation(params->max_variation);
+        if (params->weights && params->weight_count > 0) {
+            scheduler.setWeights(std::vector<double>(params->weights, params->weights + params->weight_count));
+        }
+        if (params->special_times && params->special_time_count > 0) {
+            scheduler.setSpecialTimes(std::vector<int>(params->special_times,
+                params->special_times + params->special_time_count));
+        }
+        if (params->satellites && params->satellite_count > 0) {
+            scheduler.setOverlapSatellites(std::vector<int>(params->satellites,
+                params->satellites + params->satellite_count));
+        }
+        scheduler.setCoverageDataDir(params->data_dir ? params->data_dir : "");
+
+        handle->loader.setSatelliteCount(params->num_satellites);
+        handle->loader.setObservationWindow(params->start_hour, params->start_minute, params->start_second,
+            params->end_hour, params->end_minute, params->end_second);
+        handle->directory_path = params->directory_path ? params->directory_path : "";
+
+        return handle.release();
+    }
+    catch (const std::exception& e) {
+        std::cerr << "创建调度器失败: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+void DestroyScheduler(FWAScheduler* scheduler) {
+    delete scheduler;
+}
+
+int ExecuteScheduling(FWAScheduler* scheduler, const char* data_file, int max_iter,
+    int num_fireworks, int max_changes, FWAScheduleResult* result) {
+
+    if (!scheduler || max_iter < 0 || num_fireworks <= 0 || max_changes <= 0) {
+        if (scheduler) scheduler->last_error = "参数无效";
+        return FWA_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        std::string file = data_file ? data_file : "";
+        if (!scheduler->data_loaded || file != scheduler->data_file) {
+            if (!loadData(scheduler, file)) {
+                return FWA_ERROR_DATA;
+            }
+        }
+
+        auto solutions = scheduler->scheduler.optimize(max_iter, num_fireworks, max_changes);
+        storeSolutions(scheduler, solutions.first);
+
+        if (result) {
+            fillResult(scheduler, result);
+        }
+        scheduler->last_error.clear();
+        return FWA_OK;
+    }
+    catch (const std::exception& e) {
+        scheduler->last_error = e.what();
+        return FWA_ERROR_INTERNAL;
+    }
+}
+
+void ReloadSchedulerData(FWAScheduler* scheduler) {
+    if (scheduler) {
+        scheduler->data_loaded = false;
+    }
+}
+
+int GetSolutionCount(const FWAScheduler* scheduler) {
+    return scheduler ? static_cast<int>(scheduler->metrics.size()) : 0;
+}
+
+int GetScheduleResult(const FWAScheduler* scheduler, FWAScheduleResult* result) {
+    if (!scheduler || !result) {
+        return FWA_ERROR_INVALID_ARGUMENT;
+    }
+    fillResult(scheduler, result);
+    return FWA_OK;
+}
+
+int GetSolutionInfo(const FWAScheduler* scheduler, int index,
+    double* satellite_count, double* coverage, double* load_variance) {
+
+    if (!scheduler || index < 0 || index >= static_cast<int>(scheduler->metrics.size())) {
+        return FWA_ERROR_INVALID_ARGUMENT;
+    }
+
+    const auto& metrics = scheduler->metrics[index];
+    if (satellite_count) *satellite_count = metrics.satellite_count;
+    if (coverage) *coverage = metrics.coverage;
+    if (load_variance) *load_variance = metrics.load_variance;
+    return FWA_OK;
+}
+
+const int8_t* GetSolutionSchedule(const FWAScheduler* scheduler, int index) {
+    if (!scheduler || index < 0 || index >= static_cast<int>(scheduler->metrics.size())) {
+        return nullptr;
+    }
+    size_t cells = static_cast<size_t>(scheduler->rows) * scheduler->cols;
+    return scheduler->schedules.data() + index * cells;
+}
+
+long long CopyObjectives(const FWAScheduler* scheduler, double* buffer, size_t capacity) {
+    if (!scheduler || (!buffer && capacity > 0)) {
+        return FWA_ERROR_INVALID_ARGUMENT;
+    }
+    if (capacity < scheduler->objectives.size()) {
+        return FWA_ERROR_BUFFER_TOO_SMALL;
+    }
+    std::copy(scheduler->objectives.begin(), scheduler->objectives.end(), buffer);
+    return static_cast<long long>(scheduler->objectives.size());
+}
+
+long long CopySchedules(const FWAScheduler* scheduler, int8_t* buffer, size_t capacity) {
+    if (!scheduler || (!buffer && capacity > 0)) {
+        return FWA_ERROR_INVALID_ARGUMENT;
+    }
+    if (capacity < scheduler->schedules.size()) {
+        return FWA_ERROR_BUFFER_TOO_SMALL;
+    }
+    std::copy(scheduler->schedules.begin(), scheduler->schedules.end(), buffer);
+    return static_cast<long long>(scheduler->schedules.size());
+}
+
+int ExportFront(const FWAScheduler* scheduler, const char* path, int format) {
+    if (!scheduler || !path || !*path || format == 0 ||
+        (format & ~(FWA_EXPORT_BINARY | FWA_EXPORT_CSV)) != 0) {
+        return FWA_ERROR_INVALID_ARGUMENT;
+    }
+
+    try {
+        FrontExporter exporter(scheduler->scheduler.getCompressed(), scheduler->time_points,
+            scheduler->loader.getStartMinutes());
+        size_t cells = static_cast<size_t>(scheduler->rows) * scheduler->cols;
+        for (size_t i = 0; i < scheduler->metrics.size(); ++i) {
+            const int8_t* cell = scheduler->schedules.data() + i * cells;
+            std::vector<std::vector<int>> solution(scheduler->rows);
+            for (auto& row : solution) {
+                row.assign(cell, cell + scheduler->cols);
+                cell += scheduler->cols;
+            }
+            exporter.add(solution, scheduler->metrics[i]);
+        }
+
+        bool ok = true;
+        if (format & FWA_EXPORT_BINARY) {
+            ok = exporter.writeBinary(path) && ok;
+        }
+        if (format & FWA_EXPORT_CSV) {
+            ok = exporter.writeCsv(path) && ok;
+        }
+        return ok ? FWA_OK : FWA_ERROR_DATA;
+    }
+    catch (const std::exception&) {
+        return FWA_ERROR_INTERNAL;
+    }
+}
+
+int GetObjectiveCount(void) {
+    return ActiveObjectives::N;
+}
+
+const char* GetObjectiveName(int index) {
+    if (index < 0 || index >= ActiveObjectives::N) {
+        return nullptr;
+    }
+    return ActiveObjectives::name(index);
+}
+
+const char* GetLastSchedulerError(const FWAScheduler* scheduler) {
+    return scheduler ? scheduler->last_error.c_str() : "";
+}
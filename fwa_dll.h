@@ -0,0 +1,111 @@
+#pragma once
+// fwa_dll.h
+// FWADll 的 C 接口：Windows 下编译为 FWADll.dll，Linux 下编译为 libFWADll.so
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#ifdef FWADLL_EXPORTS
+#define FWA_API __declspec(dllexport)
+#else
+#define FWA_API __declspec(dllimport)
+#endif
+#else
+#define FWA_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 调度器句柄（不透明）
+typedef struct FWAScheduler FWAScheduler;
+
+// 调度参数，含义与 README 中的参数一致；先调用 InitSchedulerParams 填入默认值再按需修改
+typedef struct FWASchedulerParams {
+    int max_switches;               // 卫星连续开关机次数上限
+    int q;                          // 观测目标网格点数
+    const double* weights;          // 目标权重（开机卫星数、覆盖率、负载均衡），NULL 表示默认
+    int weight_count;
+    int max_sparks;                 // 最大火花数
+    int max_length;                 // 变异调整的决策窗口最大长度
+    int update_bounds;              // 是否更新归一化边界（0/1）
+    int max_variation;              // 最大变异次数
+
+    const int* special_times;       // 有重叠时间窗口的时间点，NULL 表示默认
+    int special_time_count;
+    const int* satellites;          // 有重叠时间窗口的卫星编号，NULL 表示默认
+    int satellite_count;
+
+    int num_satellites;             // 卫星总数
+    int start_hour;                 // 观测开始时间
+    int start_minute;
+    int start_second;
+    int end_hour;                   // 观测结束时间
+    int end_minute;
+    int end_second;
+
+    const char* directory_path;     // 时间窗口文件目录，NULL 或空表示当前目录
+    const char* data_dir;           // 重叠时间点网格数据目录，NULL 或空表示当前目录
+} FWASchedulerParams;
+
+// 调度结果：缓冲区归调度器所有，在下一次 ExecuteScheduling 或 DestroyScheduler 之前有效
+typedef struct FWAScheduleResult {
+    int solution_count;             // 最优解个数
+    int objective_count;            // 每个解的目标值个数，顺序见 GetObjectiveName
+    int satellite_count;            // 调度矩阵行数
+    int time_count;                 // 调度矩阵列数（压缩后的时间点）
+    const double* objectives;       // solution_count x objective_count，原始方向（未取负、未归一化）
+    const int8_t* schedules;        // solution_count x satellite_count x time_count，1 开机 / 0 关机 / -1 无时间窗口
+    const int* time_points;         // time_count 个时间点（相对观测开始的分钟数）
+} FWAScheduleResult;
+
+// 错误码
+#define FWA_OK 0
+#define FWA_ERROR_INVALID_ARGUMENT -1
+#define FWA_ERROR_DATA -2
+#define FWA_ERROR_INTERNAL -3
+#define FWA_ERROR_BUFFER_TOO_SMALL -4
+
+FWA_API void InitSchedulerParams(FWASchedulerParams* params);
+
+// 创建调度器；params 为 NULL 时使用默认参数。数据在首次 ExecuteScheduling 时加载
+FWA_API FWAScheduler* CreateScheduler(const FWASchedulerParams* params);
+FWA_API void DestroyScheduler(FWAScheduler* scheduler);
+
+// 执行调度：首次调用（或 data_file 变化）时加载数据并把压缩数据保存为 data_file，
+// 之后复用已加载的数据、网格和评估缓存。result 可为 NULL
+FWA_API int ExecuteScheduling(FWAScheduler* scheduler, const char* data_file, int max_iter,
+    int num_fireworks, int max_changes, FWAScheduleResult* result);
+
+// 强制下一次 ExecuteScheduling 重新加载数据（输入文件已更新时使用）
+FWA_API void ReloadSchedulerData(FWAScheduler* scheduler);
+
+// 最近一次调度的结果
+FWA_API int GetSolutionCount(const FWAScheduler* scheduler);
+FWA_API int GetScheduleResult(const FWAScheduler* scheduler, FWAScheduleResult* result);
+FWA_API int GetSolutionInfo(const FWAScheduler* scheduler, int index,
+    double* satellite_count, double* coverage, double* load_variance);
+// 第 index 个解的调度矩阵（satellite_count x time_count），指向调度器内部缓冲区
+FWA_API const int8_t* GetSolutionSchedule(const FWAScheduler* scheduler, int index);
+
+// 复制到调用方缓冲区；capacity 为元素个数，返回写入的元素个数，不足时返回 FWA_ERROR_BUFFER_TOO_SMALL
+FWA_API long long CopyObjectives(const FWAScheduler* scheduler, double* buffer, size_t capacity);
+FWA_API long long CopySchedules(const FWAScheduler* scheduler, int8_t* buffer, size_t capacity);
+
+// 把最近一次调度的最优前沿导出到文件，format 为下列标志的按位或：
+// FWA_EXPORT_BINARY 写出列式二进制文件 path（格式见 front_exporter.h），
+// FWA_EXPORT_CSV 把 path 作为前缀，写出 <path>_objectives.csv 与 <path>_schedules.csv
+#define FWA_EXPORT_BINARY 1
+#define FWA_EXPORT_CSV 2
+FWA_API int ExportFront(const FWAScheduler* scheduler, const char* path, int format);
+
+FWA_API int GetObjectiveCount(void);
+FWA_API const char* GetObjectiveName(int index);
+
+// 最近一次失败的原因
+FWA_API const char* GetLastSchedulerError(const FWAScheduler* scheduler);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,381 @@
+// mesh_container.cpp
+#include "mesh_container.h"
+#include <algorithm>
+#include <climits>
+#include "bitplane_schedule.h"
+
+namespace {
+    // 从 pos 起第一个取值为 1（flip 为全 1 时为 0）的位，没有时返回 word_count * 64
+    int scanBit(const uint64_t* bits, int word_count, int pos, uint64_t flip) {
+        int i = pos >> 6;
+        if (i >= word_count) {
+            return word_count * 64;
+        }
+        uint64_t w = (bits[i] ^ flip) & (~0ULL << (pos & 63));
+        while (w == 0) {
+            if (++i == word_count) {
+                return word_count * 64;
+            }
+            w = bits[i] ^ flip;
+        }
+        return i * 64 + ctz64(w);
+    }
+
+    // 把 [first, last] 上的位置 1
+    void setRange(uint64_t* bits, int first, int last) {
+        int first_word = first >> 6;
+        int last_word = last >> 6;
+        uint64_t head = ~0ULL << (first & 63);
+        uint64_t tail = ~0ULL >> (63 - (last & 63));
+        if (first_word == last_word) {
+            bits[first_word] |= head & tail;
+            return;
+        }
+        bits[first_word] |= head;
+        for (int w = first_word + 1; w < last_word; ++w) {
+            bits[w] = ~0ULL;
+        }
+        bits[last_word] |= tail;
+    }
+
+    // 没有位图参与时，游程与数组点合计不超过该数就按区间排序合并，否则在块内位图上按位或
+    const size_t kMergeLimit = 256;
+
+    // 并集的工作区：每个线程一份，避免每次求并集都分配内存
+    struct UnionScratch {
+        std::vector<size_t> cursors;
+        std::vector<int> parts;
+        std::vector<std::pair<uint32_t, uint32_t>> intervals;
+        std::vector<uint16_t> runs;
+        std::vector<uint64_t> bitmap;
+    };
+
+    thread_local UnionScratch union_scratch;
+
+    class CardinalityVisitor : public MeshContainer::ChunkVisitor {
+    public:
+        void visit(const MeshContainer::ChunkView& chunk) override { total += chunk.cardinality; }
+        int total = 0;
+    };
+}
+
+MeshContainer MeshContainer::fromBits(const std::vector<bool>& mesh, int q) {
+    std::vector<uint64_t> bits((q + 63) / 64, 0);
+    int n = std::min(static_cast<int>(mesh.size()), q);
+    for (int i = 0; i < n; ++i) {
+        if (mesh[i]) {
+            bits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+    return fromWords(bits.data(), q);
+}
+
+MeshContainer MeshContainer::fromWords(const uint64_t* bits, int q) {
+    MeshContainer mesh;
+    mesh.q_ = q;
+    int words = (q + 63) / 64;
+    for (int first = 0; first < words; first += kChunkWords) {
+        mesh.appendChunk(first / kChunkWords, bits + first, std::min(kChunkWords, words - first));
+    }
+
+    // 缓存整天的网格时容器数量很多，去掉容量余量
+    mesh.chunks_.shrink_to_fit();
+    mesh.values_.shrink_to_fit();
+    mesh.words_.shrink_to_fit();
+    return mesh;
+}
+
+void MeshContainer::appendChunk(int key, const uint64_t* bits, int word_count) {
+    int cardinality = 0;
+    int runs = 0;
+    uint64_t carry = 0;
+    for (int w = 0; w < word_count; ++w) {
+        cardinality += popcount64(bits[w]);
+        runs += popcount64(bits[w] & ~((bits[w] << 1) | carry));
+        carry = bits[w] >> 63;
+    }
+    if (cardinality == 0) {
+        return;
+    }
+
+    Chunk chunk;
+    chunk.key = static_cast<uint16_t>(key);
+    chunk.cardinality = static_cast<uint32_t>(cardinality);
+
+    size_t array_bytes = 2 * static_cast<size_t>(cardinality);
+    size_t bitmap_bytes = 8 * static_cast<size_t>(word_count);
+    size_t run_bytes = 4 * static_cast<size_t>(runs);
+
+    if (run_bytes < std::min(array_bytes, bitmap_bytes)) {
+        chunk.encoding = Encoding::Run;
+        chunk.offset = static_cast<uint32_t>(values_.size());
+        int limit = word_count * 64;
+        int pos = 0;
+        while (pos < limit) {
+            int start = scanBit(bits, word_count, pos, 0);
+            if (start >= limit) break;
+            int end = scanBit(bits, word_count, start, ~0ULL);
+            values_.push_back(static_cast<uint16_t>(start));
+            values_.push_back(static_cast<uint16_t>(end - start - 1));
+            pos = end;
+        }
+    }
+    else if (array_bytes < bitmap_bytes) {
+        chunk.encoding = Encoding::Array;
+        chunk.offset = static_cast<uint32_t>(values_.size());
+        for (int w = 0; w < word_count; ++w) {
+            for (uint64_t x = bits[w]; x != 0; x &= x - 1) {
+                values_.push_back(static_cast<uint16_t>(w * 64 + ctz64(x)));
+            }
+        }
+    }
+    else {
+        chunk.encoding = Encoding::Bitmap;
+        chunk.offset = static_cast<uint32_t>(words_.size());
+        words_.insert(words_.end(), bits, bits + word_count);
+    }
+    chunk.length = static_cast<uint32_t>((chunk.encoding == Encoding::Bitmap ? words_.size() : values_.size())
+        - chunk.offset);
+    chunks_.push_back(chunk);
+}
+
+int MeshContainer::cardinality() const {
+    int total = 0;
+    for (const Chunk& chunk : chunks_) {
+        total += static_cast<int>(chunk.cardinality);
+    }
+    return total;
+}
+
+const MeshContainer::Chunk* MeshContainer::findChunk(int key) const {
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), key,
+        [](const Chunk& chunk, int k) { return chunk.key < k; });
+    return it != chunks_.end() && it->key == key ? &*it : nullptr;
+}
+
+bool MeshContainer::contains(int point) const {
+    if (point < 0 || point >= q_) {
+        return false;
+    }
+    const Chunk* chunk = findChunk(point >> kChunkBits);
+    if (!chunk) {
+        return false;
+    }
+
+    int low = point & (kChunkPoints - 1);
+    switch (chunk->encoding) {
+    case Encoding::Array: {
+        const uint16_t* first = values_.data() + chunk->offset;
+        return std::binary_search(first, first + chunk->length, static_cast<uint16_t>(low));
+    }
+    case Encoding::Bitmap:
+        return words_[chunk->offset + (low >> 6)] >> (low & 63) & 1ULL;
+    case Encoding::Run: {
+        // 起点不大于 low 的最后一个游程
+        const uint16_t* runs = values_.data() + chunk->offset;
+        int lo = 0;
+        int hi = static_cast<int>(chunk->length / 2);
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (runs[2 * mid] <= low) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo > 0 && low <= runs[2 * (lo - 1)] + runs[2 * (lo - 1) + 1];
+    }
+    }
+    return false;
+}
+
+void MeshContainer::orInto(uint64_t* bits) const {
+    for (const Chunk& chunk : chunks_) {
+        int base = static_cast<int>(chunk.key) << kChunkBits;
+        const uint16_t* values = values_.data() + chunk.offset;
+        switch (chunk.encoding) {
+        case Encoding::Array:
+            for (uint32_t i = 0; i < chunk.length; ++i) {
+                int point = base + values[i];
+                bits[point >> 6] |= 1ULL << (point & 63);
+            }
+            break;
+        case Encoding::Bitmap: {
+            uint64_t* target = bits + (base >> 6);
+            for (uint32_t w = 0; w < chunk.length; ++w) {
+                target[w] |= words_[chunk.offset + w];
+            }
+            break;
+        }
+        case Encoding::Run:
+            for (uint32_t i = 0; i < chunk.length; i += 2) {
+                setRange(bits, base + values[i], base + values[i] + values[i + 1]);
+            }
+            break;
+        }
+    }
+}
+
+void MeshContainer::toWords(uint64_t* bits) const {
+    std::fill(bits, bits + (q_ + 63) / 64, 0ULL);
+    orInto(bits);
+}
+
+std::vector<bool> MeshContainer::toBits() const {
+    std::vector<uint64_t> bits((q_ + 63) / 64);
+    toWords(bits.data());
+    std::vector<bool> mesh(q_);
+    for (int i = 0; i < q_; ++i) {
+        mesh[i] = bits[i >> 6] >> (i & 63) & 1ULL;
+    }
+    return mesh;
+}
+
+size_t MeshContainer::bytes() const {
+    return chunks_.size() * sizeof(Chunk) + values_.size() * sizeof(uint16_t) + words_.size() * sizeof(uint64_t);
+}
+
+int MeshContainer::chunkCount(Encoding encoding) const {
+    int count = 0;
+    for (const Chunk& chunk : chunks_) {
+        count += chunk.encoding == encoding;
+    }
+    return count;
+}
+
+MeshContainer::ChunkView MeshContainer::view(const Chunk& chunk) const {
+    ChunkView result{ chunk.encoding, static_cast<int>(chunk.key) << kChunkBits,
+        static_cast<int>(chunk.cardinality), nullptr, 0, nullptr, 0 };
+    if (chunk.encoding == Encoding::Bitmap) {
+        result.words = words_.data() + chunk.offset;
+        result.word_count = static_cast<int>(chunk.length);
+    }
+    else {
+        result.values = values_.data() + chunk.offset;
+        result.count = static_cast<int>(chunk.encoding == Encoding::Run ? chunk.length / 2 : chunk.length);
+    }
+    return result;
+}
+
+int MeshContainer::unionCardinality(const MeshContainer* const* meshes, int count) {
+    CardinalityVisitor visitor;
+    unionChunks(meshes, count, visitor);
+    return visitor.total;
+}
+
+void MeshContainer::unionChunks(const MeshContainer* const* meshes, int count, ChunkVisitor& visitor) {
+    if (count <= 0) {
+        return;
+    }
+    UnionScratch& scratch = union_scratch;
+    scratch.cursors.assign(count, 0);
+    scratch.parts.resize(count);
+    int total_words = (meshes[0]->q_ + 63) / 64;
+
+    while (true) {
+        int key = INT_MAX;
+        for (int k = 0; k < count; ++k) {
+            const auto& chunks = meshes[k]->chunks_;
+            if (scratch.cursors[k] < chunks.size()) {
+                key = std::min(key, static_cast<int>(chunks[scratch.cursors[k]].key));
+            }
+        }
+        if (key == INT_MAX) {
+            break;
+        }
+
+        // 含有该块的网格
+        int parts = 0;
+        bool has_bitmap = false;
+        size_t items = 0;
+        for (int k = 0; k < count; ++k) {
+            const auto& chunks = meshes[k]->chunks_;
+            size_t& cursor = scratch.cursors[k];
+            if (cursor < chunks.size() && chunks[cursor].key == key) {
+                const Chunk& chunk = chunks[cursor];
+                has_bitmap |= chunk.encoding == Encoding::Bitmap;
+                items += chunk.encoding == Encoding::Run ? chunk.length / 2 : chunk.length;
+                scratch.parts[parts++] = k;
+            }
+        }
+
+        if (parts == 1) {
+            int k = scratch.parts[0];
+            visitor.visit(meshes[k]->view(meshes[k]->chunks_[scratch.cursors[k]++]));
+            continue;
+        }
+
+        int base = key << kChunkBits;
+        if (!has_bitmap && items <= kMergeLimit) {
+            // 数组点视为长度 1 的区间，与游程一起排序后合并相交或相邻的区间
+            auto& intervals = scratch.intervals;
+            intervals.clear();
+            for (int p = 0; p < parts; ++p) {
+                int k = scratch.parts[p];
+                const Chunk& chunk = meshes[k]->chunks_[scratch.cursors[k]++];
+                const uint16_t* values = meshes[k]->values_.data() + chunk.offset;
+                if (chunk.encoding == Encoding::Run) {
+                    for (uint32_t i = 0; i < chunk.length; i += 2) {
+                        intervals.emplace_back(values[i], values[i] + values[i + 1]);
+                    }
+                }
+                else {
+                    for (uint32_t i = 0; i < chunk.length; ++i) {
+                        intervals.emplace_back(values[i], values[i]);
+                    }
+                }
+            }
+            std::sort(intervals.begin(), intervals.end());
+
+            auto& runs = scratch.runs;
+            runs.clear();
+            int cardinality = 0;
+            uint32_t start = intervals[0].first;
+            uint32_t end = intervals[0].second;
+            for (size_t i = 1; i <= intervals.size(); ++i) {
+                if (i < intervals.size() && intervals[i].first <= end + 1) {
+                    end = std::max(end, intervals[i].second);
+                    continue;
+                }
+                runs.push_back(static_cast<uint16_t>(start));
+                runs.push_back(static_cast<uint16_t>(end - start));
+                cardinality += static_cast<int>(end - start + 1);
+                if (i < intervals.size()) {
+                    start = intervals[i].first;
+                    end = intervals[i].second;
+                }
+            }
+            visitor.visit({ Encoding::Run, base, cardinality, runs.data(), static_cast<int>(runs.size() / 2), nullptr, 0 });
+            continue;
+        }
+
+        int word_count = std::min(kChunkWords, total_words - key * kChunkWords);
+        auto& bitmap = scratch.bitmap;
+        bitmap.assign(word_count, 0);
+        for (int p = 0; p < parts; ++p) {
+            int k = scratch.parts[p];
+            const MeshContainer& mesh = *meshes[k];
+            const Chunk& chunk = mesh.chunks_[scratch.cursors[k]++];
+            const uint16_t* values = mesh.values_.data() + chunk.offset;
+            switch (chunk.encoding) {
+            case Encoding::Array:
+                for (uint32_t i = 0; i < chunk.length; ++i) {
+                    bitmap[values[i] >> 6] |= 1ULL << (values[i] & 63);
+                }
+                break;
+            case Encoding::Bitmap:
+                for (uint32_t w = 0; w < chunk.length; ++w) {
+                    bitmap[w] |= mesh.words_[chunk.offset + w];
+                }
+                break;
+            case Encoding::Run:
+                for (uint32_t i = 0; i < chunk.length; i += 2) {
+                    setRange(bitmap.data(), values[i], values[i] + values[i + 1]);
+                }
+                break;
+            }
+        }
+        int cardinality = 0;
+        for (int w = 0; w < word_count; ++w) {
+            cardinality += popcount64(bitmap[w]);
+        }
+        visitor.visit({ Encoding::Bitmap, base, cardinality, nullptr, 0, bitmap.data(), word_count });
+    }
+}
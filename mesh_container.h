@@ -0,0 +1,135 @@
+#pragma once
+// mesh_container.h
+// 网格点集合的分块压缩容器（Roaring 思路）：网格点按编号每 65536 个分为一块，
+// 每块按占用字节最少的原则选用三种编码之一：
+//   Array   升序的块内编号（uint16），适合稀疏块
+//   Bitmap  块内每点一位（末块按实际点数截短），适合稠密且零散的块
+//   Run     (起点, 长度-1) 对，适合连续成片的块（卫星覆盖区在网格编号上通常只有几段）
+// 全空的块不存储；并集与计数直接在压缩形式上进行，不展开为完整位图
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class MeshContainer {
+public:
+    enum class Encoding : uint8_t { Array, Bitmap, Run };
+
+    static constexpr int kChunkBits = 16;
+    static constexpr int kChunkPoints = 1 << kChunkBits;
+    static constexpr int kChunkWords = kChunkPoints / 64;
+
+    // 并集结果中的一块：base 为块首网格点编号，数据只在下一次 visit 之前有效
+    struct ChunkView {
+        Encoding encoding;
+        int base;
+        int cardinality;
+        const uint16_t* values;     // Array：块内编号；Run：(起点, 长度-1) 对
+        int count;                  // Array：点数；Run：游程数
+        const uint64_t* words;      // Bitmap：块内位图
+        int word_count;
+    };
+
+    class ChunkVisitor {
+    public:
+        virtual ~ChunkVisitor() = default;
+        virtual void visit(const ChunkView& chunk) = 0;
+    };
+
+    MeshContainer() = default;
+
+    // 由 q 个网格点的取值 / 按 64 位打包的位图（(q+63)/64 个字，末字填充位须为 0）构建
+    static MeshContainer fromBits(const std::vector<bool>& mesh, int q);
+    static MeshContainer fromWords(const uint64_t* bits, int q);
+
+    int q() const { return q_; }
+    int cardinality() const;
+    bool contains(int point) const;
+
+    // 展开：toWords 写满 (q+63)/64 个字；orInto 把本集合按位或到已有位图上
+    void toWords(uint64_t* bits) const;
+    void orInto(uint64_t* bits) const;
+    std::vector<bool> toBits() const;
+
+    // 按字号升序给出非零的 64 位字：visit(word, bits)，word 为完整位图中的字号，每个字至多给出一次；
+    // 代价与非零字数成正比，不展开为完整位图
+    template <typename Visit>
+    void forEachWord(Visit&& visit) const;
+
+    // 数据与块目录占用的字节数（不含 vector 自身的容量余量）
+    size_t bytes() const;
+    int chunkCount() const { return static_cast<int>(chunks_.size()); }
+    int chunkCount(Encoding encoding) const;
+
+    // count 个网格（q 相同）的并集点数
+    static int unionCardinality(const MeshContainer* const* meshes, int count);
+    // 按块号升序逐块给出并集：只出现在一个网格中的块直接给出原编码，
+    // 没有位图参与且规模不大的块合并为游程，其余块在块内位图上按位或
+    static void unionChunks(const MeshContainer* const* meshes, int count, ChunkVisitor& visitor);
+
+private:
+    struct Chunk {
+        uint16_t key;           // 块号
+        Encoding encoding;
+        uint32_t cardinality;
+        uint32_t offset;        // Array / Run 在 values_ 中、Bitmap 在 words_ 中的起点
+        uint32_t length;        // values_ 中的 uint16 个数或 words_ 中的字数
+    };
+
+    const Chunk* findChunk(int key) const;
+    ChunkView view(const Chunk& chunk) const;
+    void appendChunk(int key, const uint64_t* bits, int word_count);
+
+    int q_ = 0;
+    std::vector<Chunk> chunks_;         // 按块号升序
+    std::vector<uint16_t> values_;
+    std::vector<uint64_t> words_;
+};
+
+template <typename Visit>
+void MeshContainer::forEachWord(Visit&& visit) const {
+    // 块边界与字边界对齐，只需合并同一块内落在同一字的点或游程
+    int current = -1;
+    uint64_t pending = 0;
+    auto emit = [&](int word, uint64_t bits) {
+        if (word != current) {
+            if (pending != 0) visit(current, pending);
+            current = word;
+            pending = 0;
+        }
+        pending |= bits;
+    };
+
+    for (const Chunk& chunk : chunks_) {
+        int base = static_cast<int>(chunk.key) << kChunkBits;
+        const uint16_t* values = values_.data() + chunk.offset;
+        switch (chunk.encoding) {
+        case Encoding::Array:
+            for (uint32_t i = 0; i < chunk.length; ++i) {
+                int point = base + values[i];
+                emit(point >> 6, 1ULL << (point & 63));
+            }
+            break;
+        case Encoding::Bitmap:
+            for (uint32_t w = 0; w < chunk.length; ++w) {
+                uint64_t bits = words_[chunk.offset + w];
+                if (bits != 0) emit((base >> 6) + static_cast<int>(w), bits);
+            }
+            break;
+        case Encoding::Run:
+            for (uint32_t i = 0; i < chunk.length; i += 2) {
+                int first = base + values[i];
+                int last = first + values[i + 1];
+                for (int w = first >> 6; w <= last >> 6; ++w) {
+                    uint64_t bits = ~0ULL;
+                    if (w == first >> 6) bits &= ~0ULL << (first & 63);
+                    if (w == last >> 6) bits &= ~0ULL >> (63 - (last & 63));
+                    emit(w, bits);
+                }
+            }
+            break;
+        }
+    }
+    if (pending != 0) {
+        visit(current, pending);
+    }
+}
@@ -0,0 +1,65 @@
+// objective_policies.cpp
+#include "objective_policies.h"
+#include <algorithm>
+#include "unique_coverage.h"
+#include "point_revisit.h"
+
+void SwitchCountObjective::measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics) {
+    int total = 0;
+    for (int sat = 0; sat < ctx.layout.rows(); ++sat) {
+        total += ctx.bits->switchCount(ctx.layout, sat);
+    }
+    metrics.switch_count = total;
+}
+
+void PeakConcurrencyObjective::measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics) {
+    int cols = ctx.solution.empty() ? 0 : static_cast<int>(ctx.solution[0].size());
+    std::vector<int> active(cols, 0);
+    for (const auto& row : ctx.solution) {
+        for (int j = 0; j < cols; ++j) {
+            active[j] += row[j] == 1;
+        }
+    }
+    metrics.peak_concurrency = active.empty() ? 0 : *std::max_element(active.begin(), active.end());
+}
+
+void RevisitGapObjective::measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics) {
+    if (ctx.bounds.empty()) {
+        metrics.max_revisit_gap = 0.0;
+        return;
+    }
+
+    // 任一卫星开机的列：各卫星开关掩码按字取或
+    int words = ctx.layout.words();
+    std::vector<uint64_t> any(words, 0);
+    for (int sat = 0; sat < ctx.layout.rows(); ++sat) {
+        const uint64_t* bits = ctx.bits->on(sat);
+        for (int w = 0; w < words; ++w) {
+            any[w] |= bits[w];
+        }
+    }
+
+    // 相邻两次开机之间的原始时间间隔，含时域首尾
+    int previous = ctx.bounds.front();
+    int worst = 0;
+    for (int w = 0; w < words; ++w) {
+        uint64_t word = any[w];
+        while (word) {
+            int j = w * 64 + static_cast<int>(popcount64((word & (~word + 1)) - 1));
+            worst = std::max(worst, ctx.bounds[j] - previous);
+            previous = ctx.bounds[j];
+            word &= word - 1;
+        }
+    }
+    worst = std::max(worst, ctx.bounds.back() - previous);
+
+    metrics.max_revisit_gap = worst;
+}
+
+void UniqueCoverageObjective::measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics) {
+    metrics.unique_coverage = ctx.unique ? ctx.unique->fraction(ctx.solution) : 0.0;
+}
+
+void PointRevisitGapObjective::measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics) {
+    metrics.max_point_gap = ctx.unique ? PointRevisitGap::worst(*ctx.unique, ctx.bounds, ctx.solution) : 0.0;
+}
@@ -0,0 +1,186 @@
+#pragma once
+// objective_policies.h
+#include <vector>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include "bitplane_schedule.h"
+
+class UniqueCoverage;
+
+// 调度方案的原始指标（未归一化、未取符号）
+struct ScheduleMetrics {
+    double satellite_count = 0.0;   // 开机卫星数
+    double coverage = 0.0;          // 总覆盖率
+    double load_variance = 0.0;     // 负载方差
+    double switch_count = 0.0;      // 总切换次数
+    double peak_concurrency = 0.0;  // 单个时间片内同时开机的最多卫星数
+    double max_revisit_gap = 0.0;   // 最长无卫星开机间隔（原始时间点）
+    double unique_coverage = 0.0;   // 整个时域去重后覆盖的网格点比例
+    double max_point_gap = 0.0;     // 网格点的最长未观测间隔（原始时间点），取所有网格点的最大值
+};
+
+// 目标策略计算指标时可用的调度视图
+struct ObjectiveContext {
+    const std::vector<std::vector<int>>& solution;
+    const BitPlaneLayout& layout;
+    const BitPlaneSchedule* bits;       // 仅当目标集需要位平面时非空
+    const std::vector<int>& bounds;     // 压缩列对应的原始时间点
+    const UniqueCoverage* unique;       // 逐单元网格；仅当目标集的 kNeedsCellMeshes 为真时非空
+};
+
+// 目标策略：kField 指向 ScheduleMetrics 中的指标，kMinimize 表示优化方向
+// measure 计算该指标；卫星数、覆盖率、负载方差由评估器统一计算
+struct SatelliteCountObjective {
+    static constexpr const char* kName = "卫星数";
+    static constexpr bool kMinimize = true;
+    static constexpr bool kNeedsBitPlane = false;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::satellite_count;
+    static void measure(const ObjectiveContext&, ScheduleMetrics&) {}
+};
+
+struct CoverageObjective {
+    static constexpr const char* kName = "覆盖率";
+    static constexpr bool kMinimize = false;
+    static constexpr bool kNeedsBitPlane = false;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::coverage;
+    static void measure(const ObjectiveContext&, ScheduleMetrics&) {}
+};
+
+struct LoadVarianceObjective {
+    static constexpr const char* kName = "负载方差";
+    static constexpr bool kMinimize = true;
+    static constexpr bool kNeedsBitPlane = false;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::load_variance;
+    static void measure(const ObjectiveContext&, ScheduleMetrics&) {}
+};
+
+struct SwitchCountObjective {
+    static constexpr const char* kName = "切换次数";
+    static constexpr bool kMinimize = true;
+    static constexpr bool kNeedsBitPlane = true;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::switch_count;
+    static void measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics);
+};
+
+struct PeakConcurrencyObjective {
+    static constexpr const char* kName = "峰值并发卫星数";
+    static constexpr bool kMinimize = true;
+    static constexpr bool kNeedsBitPlane = false;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::peak_concurrency;
+    static void measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics);
+};
+
+struct RevisitGapObjective {
+    static constexpr const char* kName = "最长重访间隔";
+    static constexpr bool kMinimize = true;
+    static constexpr bool kNeedsBitPlane = true;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::max_revisit_gap;
+    static void measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics);
+};
+
+// 需要每个可见 (卫星, 列) 的网格（见 UniqueCoverage），启用后首次评估时加载
+struct UniqueCoverageObjective {
+    static constexpr const char* kName = "去重覆盖率";
+    static constexpr bool kMinimize = false;
+    static constexpr bool kNeedsBitPlane = false;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::unique_coverage;
+    static void measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics);
+};
+
+// 逐网格点的重访间隔（见 PointRevisitGap），与 RevisitGapObjective 的区别是按网格点而非按是否有卫星开机计算
+struct PointRevisitGapObjective {
+    static constexpr const char* kName = "网格点最长重访间隔";
+    static constexpr bool kMinimize = true;
+    static constexpr bool kNeedsBitPlane = false;
+    static constexpr double ScheduleMetrics::* kField = &ScheduleMetrics::max_point_gap;
+    static void measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics);
+};
+
+// 目标集合：目标个数 N 在编译期确定，支配判断、加权等循环按 N 展开
+template <typename... Policies>
+class ObjectiveSet {
+public:
+    static constexpr int N = static_cast<int>(sizeof...(Policies));
+    static_assert(N > 0, "目标集合不能为空");
+
+    using Vector = std::array<double, N>;
+
+    static constexpr bool kNeedsBitPlane = (Policies::kNeedsBitPlane || ...);
+    // 需要逐单元网格（SchedulingProblem::uniqueCoverage）的目标
+    static constexpr bool kNeedsCellMeshes =
+        (std::is_same_v<Policies, UniqueCoverageObjective> || ...) ||
+        (std::is_same_v<Policies, PointRevisitGapObjective> || ...);
+
+    template <typename Policy>
+    static constexpr bool contains() { return (std::is_same_v<Policy, Policies> || ...); }
+
+    static const char* name(int i) {
+        static constexpr const char* names[] = { Policies::kName... };
+        return names[i];
+    }
+
+    static bool minimize(int i) {
+        static constexpr bool flags[] = { Policies::kMinimize... };
+        return flags[i];
+    }
+
+    static void measure(const ObjectiveContext& ctx, ScheduleMetrics& metrics) {
+        (Policies::measure(ctx, metrics), ...);
+    }
+
+    // 按目标顺序取出原始指标 / 写回指标
+    static Vector raw(const ScheduleMetrics& metrics) {
+        return { (metrics.*Policies::kField)... };
+    }
+
+    static void assign(ScheduleMetrics& metrics, const Vector& values) {
+        assignImpl(metrics, values, Indices{});
+    }
+
+    // 最小化意义下的目标向量（最大化目标取负）
+    static Vector minimized(const ScheduleMetrics& metrics) {
+        return { (Policies::kMinimize ? (metrics.*Policies::kField) : -(metrics.*Policies::kField))... };
+    }
+
+    // a 支配 b：所有目标不差且至少一个目标严格更优（无分支，便于向量化）
+    static bool dominates(const Vector& a, const Vector& b) {
+        return dominatesImpl(a, b, Indices{});
+    }
+
+    // 标量适应度（越大越好）：归一化指标按方向取符号后加权求和
+    static double fitness(const ScheduleMetrics& normalized, const double* weights) {
+        return fitnessImpl(normalized, weights, Indices{});
+    }
+
+private:
+    using Indices = std::make_index_sequence<sizeof...(Policies)>;
+
+    template <std::size_t I>
+    using PolicyAt = std::tuple_element_t<I, std::tuple<Policies...>>;
+
+    template <std::size_t... I>
+    static void assignImpl(ScheduleMetrics& metrics, const Vector& values, std::index_sequence<I...>) {
+        ((metrics.*PolicyAt<I>::kField = values[I]), ...);
+    }
+
+    template <std::size_t... I>
+    static bool dominatesImpl(const Vector& a, const Vector& b, std::index_sequence<I...>) {
+        bool no_worse = ((a[I] <= b[I]) & ...);
+        bool better = ((a[I] < b[I]) | ...);
+        return no_worse & better;
+    }
+
+    template <std::size_t... I>
+    static double fitnessImpl(const ScheduleMetrics& normalized, const double* weights, std::index_sequence<I...>) {
+        return (... + (PolicyAt<I>::kMinimize ? weights[I] * -(normalized.*PolicyAt<I>::kField)
+            : weights[I] * (normalized.*PolicyAt<I>::kField)));
+    }
+};
+
+// 当前启用的目标：新增目标时在此追加策略类型，
+// 种群排序、拥挤距离、外部档案和断点格式随目标个数自动调整
+using ActiveObjectives = ObjectiveSet<SatelliteCountObjective, CoverageObjective, LoadVarianceObjective>;
+using ObjectiveVector = ActiveObjectives::Vector;
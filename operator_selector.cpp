@@ -0,0 +1,91 @@
+// operator_selector.cpp
+#include "operator_selector.h"
+#include <algorithm>
+
+OperatorSelector::OperatorSelector(int arms) {
+    reset(arms);
+}
+
+void OperatorSelector::reset(int arms) {
+    stats_.assign(std::max(1, arms), ArmStats());
+    generation_reward_.assign(stats_.size(), 0.0);
+    generation_uses_.assign(stats_.size(), 0);
+    for (auto& arm : stats_) {
+        // 初始质量取中间值，未试过的臂不会在第一代后立刻被压到下限
+        arm.quality = 0.5;
+    }
+    recomputeProbabilities();
+}
+
+void OperatorSelector::configure(double learning_rate, double min_probability) {
+    learning_rate_ = std::clamp(learning_rate, 0.0, 1.0);
+    min_probability_ = std::clamp(min_probability, 0.0, 1.0 / stats_.size());
+    recomputeProbabilities();
+}
+
+int OperatorSelector::select(RandomSource& gen) const {
+    if (stats_.size() == 1) {
+        return 0;
+    }
+
+    double r = gen.uniform01();
+    for (size_t a = 0; a + 1 < stats_.size(); ++a) {
+        r -= stats_[a].probability;
+        if (r < 0.0) {
+            return static_cast<int>(a);
+        }
+    }
+    return static_cast<int>(stats_.size()) - 1;
+}
+
+void OperatorSelector::credit(int arm, bool survived, bool first_front) {
+    auto& stats = stats_[arm];
+    stats.uses++;
+    stats.survived += survived ? 1 : 0;
+    stats.first_front += first_front ? 1 : 0;
+
+    generation_reward_[arm] += first_front ? 1.0 : (survived ? 0.5 : 0.0);
+    generation_uses_[arm]++;
+}
+
+void OperatorSelector::update() {
+    for (size_t a = 0; a < stats_.size(); ++a) {
+        if (generation_uses_[a] > 0) {
+            double reward = generation_reward_[a] / generation_uses_[a];
+            stats_[a].quality += learning_rate_ * (reward - stats_[a].quality);
+        }
+        generation_reward_[a] = 0.0;
+        generation_uses_[a] = 0;
+    }
+    recomputeProbabilities();
+}
+
+void OperatorSelector::recomputeProbabilities() {
+    double total = 0.0;
+    for (const auto& arm : stats_) {
+        total += arm.quality;
+    }
+
+    double k = static_cast<double>(stats_.size());
+    for (auto& arm : stats_) {
+        double share = total > 0.0 ? arm.quality / total : 1.0 / k;
+        arm.probability = min_probability_ + (1.0 - k * min_probability_) * share;
+    }
+}
+
+void OperatorSelector::saveState(std::vector<double>& out) const {
+    for (const auto& arm : stats_) {
+        out.push_back(arm.quality);
+    }
+}
+
+bool OperatorSelector::restoreState(const std::vector<double>& state, size_t& offset) {
+    if (offset + stats_.size() > state.size()) {
+        return false;
+    }
+    for (auto& arm : stats_) {
+        arm.quality = state[offset++];
+    }
+    recomputeProbabilities();
+    return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+// operator_selector.h
+// 变异算子的自适应选择：概率匹配（probability matching）式的多臂老虎机
+#include <cstdint>
+#include <vector>
+#include "fast_rng.h"
+
+// 一组可互相替代的算子（臂）。每个火花按当前概率抽一个臂；一代结束后按本代各臂火花的平均回报
+// 以指数滑动平均更新质量估计，概率正比于质量并保留下限 min_probability，避免某个臂被永久放弃
+// 一代之内概率不变，火花的生成与评估顺序无关
+class OperatorSelector {
+public:
+    struct ArmStats {
+        uint64_t uses = 0;          // 累计产生的火花数
+        uint64_t survived = 0;      // 进入下一代（或替换了邻居）的火花数
+        uint64_t first_front = 0;   // 进入第一前沿（或外部档案）的火花数
+        double quality = 0.0;       // 回报的滑动平均
+        double probability = 0.0;   // 当前选择概率
+    };
+
+    explicit OperatorSelector(int arms = 1);
+
+    // 重置为均匀概率，统计清零
+    void reset(int arms);
+    void configure(double learning_rate, double min_probability);
+
+    int arms() const { return static_cast<int>(stats_.size()); }
+    int select(RandomSource& gen) const;
+
+    // 回报：进入第一前沿为 1，仅存活为 0.5，其余为 0（被淘汰、克隆、不可行或被代理筛掉）
+    void credit(int arm, bool survived, bool first_front);
+    // 一代结束：更新本代用过的臂的质量并重算概率
+    void update();
+
+    const std::vector<ArmStats>& stats() const { return stats_; }
+
+    // 断点用：各臂的质量与概率
+    void saveState(std::vector<double>& out) const;
+    bool restoreState(const std::vector<double>& state, size_t& offset);
+
+private:
+    void recomputeProbabilities();
+
+    double learning_rate_ = 0.3;
+    double min_probability_ = 0.05;
+    std::vector<ArmStats> stats_;
+    std::vector<double> generation_reward_;
+    std::vector<int> generation_uses_;
+};
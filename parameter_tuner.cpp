@@ -0,0 +1,185 @@
+// parameter_tuner.cpp
+#include "parameter_tuner.h"
+#include "front_metrics.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+std::string FireworksParams::toString() const {
+    std::ostringstream ss;
+    ss << "max_sparks=" << max_sparks << " max_length=" << max_length
+        << " max_variation=" << max_variation << " num_fireworks=" << num_fireworks
+        << " max_changes=" << max_changes;
+    return ss.str();
+}
+
+ParameterTuner::ParameterTuner(SchedulingProblem::Ptr problem, std::vector<SchedulingScenario> scenarios,
+    const TuningOptions& options)
+    : problem_(std::move(problem)), scenarios_(std::move(scenarios)), options_(options) {
+
+    if (scenarios_.empty()) {
+        scenarios_.push_back(SchedulingScenario{ "default" });
+    }
+    options_.eta = std::max(2, options_.eta);
+    // 运行不限迭代次数，预算不大于 0 时 optimize 不会结束
+    options_.min_budget_ms = std::max(1.0, options_.min_budget_ms);
+    options_.repeats = std::max(1, options_.repeats);
+    options_.configurations = std::max(1, options_.configurations);
+}
+
+std::vector<FireworksParams> ParameterTuner::sampleCandidates() {
+    std::mt19937 gen(options_.seed);
+    auto pick = [&gen](const int range[2]) {
+        return std::uniform_int_distribution<int>(range[0], range[1])(gen);
+    };
+
+    // 默认参数总是参与比较，作为基准
+    std::vector<FireworksParams> candidates{ FireworksParams() };
+    while (static_cast<int>(candidates.size()) < options_.configurations) {
+        FireworksParams params;
+        params.max_sparks = pick(options_.space.max_sparks);
+        params.max_length = pick(options_.space.max_length);
+        params.max_variation = pick(options_.space.max_variation);
+        params.num_fireworks = pick(options_.space.num_fireworks);
+        params.max_changes = pick(options_.space.max_changes);
+        candidates.push_back(params);
+    }
+    return candidates;
+}
+
+std::vector<double> ParameterTuner::scoreRung(const std::vector<FireworksParams>& candidates, double budget_ms,
+    std::vector<double>& cpu_seconds) {
+
+    // 展开为 候选 x 场景 x 重复 的一批运行，共享同一份问题数据并发执行
+    std::vector<SchedulingScenario> runs;
+    for (const auto& params : candidates) {
+        for (size_t s = 0; s < scenarios_.size(); ++s) {
+            for (int r = 0; r < options_.repeats; ++r) {
+                SchedulingScenario run = scenarios_[s];
+                run.max_sparks = params.max_sparks;
+                run.max_length = params.max_length;
+                run.max_variation = params.max_variation;
+                run.num_fireworks = params.num_fireworks;
+                run.max_changes = params.max_changes;
+                run.max_iter = std::numeric_limits<int>::max();
+                run.time_budget_ms = budget_ms;
+                // 同一场景、同一重复在所有候选和轮次中使用相同的种子，候选之间只差参数
+                run.seed = static_cast<int64_t>(options_.seed) * 1000003 +
+                    static_cast<int64_t>(s) * options_.repeats + r;
+                runs.push_back(run);
+            }
+        }
+    }
+
+    ScenarioRunner runner(problem_, options_.threads);
+    auto results = runner.run(runs);
+
+    auto toPoints = [](const ScenarioResult& result) {
+        std::vector<front_metrics::ObjectivePoint> points;
+        for (const auto& metrics : result.metrics) {
+            auto values = ActiveObjectives::minimized(metrics);
+            points.emplace_back(values.begin(), values.end());
+        }
+        return points;
+    };
+    auto index = [&](size_t c, size_t s, int r) {
+        return (c * scenarios_.size() + s) * options_.repeats + r;
+    };
+
+    // 每个场景在本轮所有运行的前沿上统一归一化，超体积才可比较
+    std::vector<double> scores(candidates.size(), 0.0);
+    cpu_seconds.assign(candidates.size(), 0.0);
+    for (size_t s = 0; s < scenarios_.size(); ++s) {
+        front_metrics::ObjectiveRange range;
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            for (int r = 0; r < options_.repeats; ++r) {
+                for (const auto& point : toPoints(results[index(c, s, r)])) {
+                    range.include(point);
+                }
+            }
+        }
+
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            for (int r = 0; r < options_.repeats; ++r) {
+                const auto& result = results[index(c, s, r)];
+                if (!result.ok) {
+                    std::cerr << "调参运行失败 (" << candidates[c].toString() << ", " << result.name
+                        << "): " << result.error << std::endl;
+                }
+                scores[c] += front_metrics::normalizedHypervolume(toPoints(result), range);
+                cpu_seconds[c] += result.cpu_ms / 1000.0;
+            }
+        }
+    }
+
+    double runs_per_candidate = static_cast<double>(scenarios_.size() * options_.repeats);
+    for (double& score : scores) {
+        score /= runs_per_candidate;
+    }
+    return scores;
+}
+
+FireworksParams ParameterTuner::tune() {
+    history_.clear();
+
+    std::vector<FireworksParams> survivors = sampleCandidates();
+    double budget_ms = options_.min_budget_ms;
+    int rung = 0;
+
+    while (true) {
+        std::cerr << "调参第 " << rung << " 轮: " << survivors.size() << " 个候选, 每次运行预算 "
+            << budget_ms << " ms CPU 时间" << std::endl;
+
+        std::vector<double> cpu_seconds;
+        auto scores = scoreRung(survivors, budget_ms, cpu_seconds);
+
+        std::vector<size_t> order(survivors.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+            [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+
+        for (size_t i : order) {
+            history_.push_back({ survivors[i], rung, scores[i], cpu_seconds[i] });
+            std::cerr << "  超体积=" << scores[i] << ", CPU 时间=" << cpu_seconds[i] << " s, "
+                << survivors[i].toString() << std::endl;
+        }
+
+        best_ = { survivors[order[0]], rung, scores[order[0]], cpu_seconds[order[0]] };
+        if (survivors.size() == 1) {
+            break;
+        }
+
+        size_t keep = std::max<size_t>(1, survivors.size() / options_.eta);
+        std::vector<FireworksParams> next;
+        for (size_t i = 0; i < keep; ++i) {
+            next.push_back(survivors[order[i]]);
+        }
+        survivors = std::move(next);
+        budget_ms *= options_.eta;
+        rung++;
+    }
+
+    return best_.params;
+}
+
+bool ParameterTuner::saveParams(const std::string& path, const FireworksParams& params, const std::string& comment) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "无法写入参数文件: " << path << std::endl;
+        return false;
+    }
+
+    if (!comment.empty()) {
+        file << "# " << comment << "\n";
+    }
+    file << "max_sparks=" << params.max_sparks << "\n"
+        << "max_length=" << params.max_length << "\n"
+        << "max_variation=" << params.max_variation << "\n"
+        << "num_fireworks=" << params.num_fireworks << "\n"
+        << "max_changes=" << params.max_changes << "\n";
+    return static_cast<bool>(file);
+}
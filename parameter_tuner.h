@@ -0,0 +1,74 @@
+#pragma once
+// parameter_tuner.h
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "scenario_runner.h"
+
+// 参与调优的烟花算法参数（默认值与 SatelliteSchedulerBase / optimize 的默认值一致）
+struct FireworksParams {
+    int max_sparks = 30;
+    int max_length = 10;
+    int max_variation = 3;
+    int num_fireworks = 20;
+    int max_changes = 10;
+
+    std::string toString() const;
+};
+
+// 参数取值范围（闭区间）
+struct FireworksParamSpace {
+    int max_sparks[2] = { 10, 60 };
+    int max_length[2] = { 3, 20 };
+    int max_variation[2] = { 1, 6 };
+    int num_fireworks[2] = { 5, 30 };
+    int max_changes[2] = { 5, 60 };
+};
+
+struct TuningOptions {
+    int configurations = 27;        // 首轮候选数（含默认参数）
+    int eta = 3;                    // 每轮保留 1/eta，预算乘以 eta
+    double min_budget_ms = 300.0;   // 首轮每次运行的 CPU 时间预算，必须大于 0（运行只靠预算结束）
+    int repeats = 1;                // 每个场景的重复次数（不同随机种子）
+    int threads = 0;                // 并发运行数，0 表示硬件线程数
+    uint32_t seed = 12345;          // 候选参数采样种子，各次运行的优化种子也由它导出
+    FireworksParamSpace space;
+};
+
+struct TuningCandidate {
+    FireworksParams params;
+    int rung = 0;                   // 最后参与的轮次
+    double score = 0.0;             // 该轮的平均归一化超体积
+    double cpu_seconds = 0.0;       // 该轮所有运行消耗的 CPU 时间之和
+};
+
+// 连续减半（successive halving）调参：
+// 每轮在全部场景上以相同的 CPU 时间预算运行所有存活候选，按固定预算下的前沿超体积排序，
+// 保留前 1/eta 进入下一轮并把预算乘以 eta，直到只剩一个候选
+// 同一时间预算下超体积更高，即单位 CPU 时间的前沿质量更高
+class ParameterTuner {
+public:
+    ParameterTuner(SchedulingProblem::Ptr problem, std::vector<SchedulingScenario> scenarios,
+        const TuningOptions& options = TuningOptions());
+
+    FireworksParams tune();
+
+    // 每轮每个候选的结果，按轮次顺序
+    const std::vector<TuningCandidate>& history() const { return history_; }
+    const TuningCandidate& best() const { return best_; }
+
+    // 以 key=value 形式写出参数（键名与场景文件一致）
+    static bool saveParams(const std::string& path, const FireworksParams& params, const std::string& comment = "");
+
+private:
+    std::vector<FireworksParams> sampleCandidates();
+    std::vector<double> scoreRung(const std::vector<FireworksParams>& candidates, double budget_ms,
+        std::vector<double>& cpu_seconds);
+
+    SchedulingProblem::Ptr problem_;
+    std::vector<SchedulingScenario> scenarios_;
+    TuningOptions options_;
+
+    std::vector<TuningCandidate> history_;
+    TuningCandidate best_;
+};
@@ -0,0 +1,118 @@
+// parameter_tuner_main.cpp
+// 用法: fwa_tune [--dir 时间窗口目录] [--mesh-dir 网格目录] [--satellites 卫星数]
+//                [--scenarios 场景文件] [--configs 候选数] [--eta 淘汰比] [--budget-ms 首轮预算]
+//                [--repeats 重复次数] [--threads 线程数] [--seed 种子] [--output 参数文件]
+//                [--engine pareto|decomposition] [--verbose]
+#include "parameter_tuner.h"
+#include "satellite_data_loader.h"
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+namespace {
+    // 静默期间 std::cout 指向未打开的文件缓冲区；离开作用域前必须恢复，否则退出时刷新会访问已析构的缓冲区
+    class CoutSilencer {
+    public:
+        explicit CoutSilencer(bool enabled) : saved_(std::cout.rdbuf()) {
+            if (enabled) std::cout.rdbuf(null_stream_.rdbuf());
+        }
+        ~CoutSilencer() { restore(); }
+        void restore() {
+            std::cout.rdbuf(saved_);
+            std::cout.clear();
+        }
+
+    private:
+        std::ofstream null_stream_;
+        std::streambuf* saved_;
+    };
+}
+
+int main(int argc, char* argv[]) {
+    std::string directory_path;
+    std::string mesh_dir;
+    std::string scenario_file;
+    std::string output = "tuned_params.txt";
+    int num_satellites = 10;
+    bool verbose = false;
+    std::string engine_name;
+    TuningOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--dir" && has_value) directory_path = argv[++i];
+        else if (arg == "--mesh-dir" && has_value) mesh_dir = argv[++i];
+        else if (arg == "--satellites" && has_value) num_satellites = std::atoi(argv[++i]);
+        else if (arg == "--scenarios" && has_value) scenario_file = argv[++i];
+        else if (arg == "--configs" && has_value) options.configurations = std::atoi(argv[++i]);
+        else if (arg == "--eta" && has_value) options.eta = std::atoi(argv[++i]);
+        else if (arg == "--budget-ms" && has_value) options.min_budget_ms = std::atof(argv[++i]);
+        else if (arg == "--repeats" && has_value) options.repeats = std::atoi(argv[++i]);
+        else if (arg == "--threads" && has_value) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && has_value) options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--output" && has_value) output = argv[++i];
+        else if (arg == "--engine" && has_value) engine_name = argv[++i];
+        else if (arg == "--verbose") verbose = true;
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    if (!(options.min_budget_ms > 0.0)) {
+        std::cerr << "--budget-ms 必须大于 0" << std::endl;
+        return 1;
+    }
+
+    // 调参会运行大量优化，默认丢弃逐代输出；调参进度写到 stderr
+    CoutSilencer silencer(!verbose);
+
+    std::vector<SchedulingScenario> scenarios;
+    if (!scenario_file.empty() && !ScenarioRunner::loadScenarios(scenario_file, scenarios)) {
+        return 1;
+    }
+
+    // 指定引擎时覆盖场景文件中的设置，便于分别为两种引擎调参
+    if (!engine_name.empty()) {
+        OptimizerEngine engine;
+        if (!parseOptimizerEngine(engine_name, engine)) {
+            std::cerr << "未知引擎: " << engine_name << std::endl;
+            return 1;
+        }
+        if (scenarios.empty()) {
+            scenarios.push_back(SchedulingScenario{ "default" });
+        }
+        for (auto& scenario : scenarios) {
+            scenario.engine = engine;
+        }
+    }
+
+    SatelliteDataLoader loader;
+    loader.setSatelliteCount(num_satellites);
+    loader.loadDataFromExcel(directory_path);
+    if (loader.getCompressedMatrix().empty() || loader.getBounds().empty()) {
+        std::cerr << "未读取到任何卫星时间窗口数据: " << directory_path << std::endl;
+        return 1;
+    }
+
+    // 借助调度器加载问题（默认重叠卫星与时间点），之后所有运行共享这份数据
+    SatelliteSchedulerMultiObjective scheduler;
+    scheduler.setCoverageDataDir(mesh_dir);
+    scheduler.loadProblem(loader);
+
+    ParameterTuner tuner(scheduler.getProblem(), scenarios, options);
+    FireworksParams best = tuner.tune();
+
+    const auto& result = tuner.best();
+    std::string comment = "fwa_tune: 平均归一化超体积 " + std::to_string(result.score) +
+        ", 第 " + std::to_string(result.rung) + " 轮";
+    if (!ParameterTuner::saveParams(output, best, comment)) {
+        return 1;
+    }
+
+    silencer.restore();
+    std::cout << "最优参数: " << best.toString() << std::endl;
+    std::cout << "已写入 " << output << std::endl;
+    return 0;
+}
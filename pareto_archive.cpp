@@ -0,0 +1,267 @@
+// pareto_archive.cpp
+#include "pareto_archive.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+ParetoArchive::ParetoArchive(size_t capacity) : capacity_(std::max<size_t>(capacity, 1)) {
+}
+
+bool ParetoArchive::insert(const std::vector<std::vector<int>>& solution, const Objectives& objectives) {
+    if (entries_.empty()) {
+        rows_ = static_cast<int>(solution.size());
+        cols_ = solution.empty() ? 0 : static_cast<int>(solution[0].size());
+    }
+
+    BoxKey box = makeBox(objectives);
+
+    // 档案按第一个目标升序排列（网格模式下盒坐标的第一维随之单调）：
+    // 能支配新解的成员第一维不大于新解，只在前段 [0, upper)；可能被新解支配的成员只在后段 [lower, n)
+    // 网格模式按盒坐标比较，同盒成员落在两段的重叠部分；前段从第一维最接近新解的一端向前找支配者，
+    // 在前沿上第一维越小的成员其余目标越大，越不可能支配新解
+    size_t lower, upper;
+    if (gridded_) {
+        lower = std::partition_point(entries_.begin(), entries_.end(),
+            [&](const Entry& e) { return e.box[0] < box[0]; }) - entries_.begin();
+        upper = std::partition_point(entries_.begin() + lower, entries_.end(),
+            [&](const Entry& e) { return e.box[0] <= box[0]; }) - entries_.begin();
+    }
+    else {
+        lower = std::partition_point(entries_.begin(), entries_.end(),
+            [&](const Entry& e) { return e.objectives[0] < objectives[0]; }) - entries_.begin();
+        upper = std::partition_point(entries_.begin() + lower, entries_.end(),
+            [&](const Entry& e) { return e.objectives[0] <= objectives[0]; }) - entries_.begin();
+    }
+
+    if (gridded_) {
+        // 同一网格内只保留一个代表：支配者优先，否则取离网格角点更近者
+        for (size_t i = lower; i < upper; ++i) {
+            Entry& incumbent = entries_[i];
+            if (incumbent.box != box) continue;
+
+            bool better = dominates(objectives, incumbent.objectives) ||
+                (!dominates(incumbent.objectives, objectives) &&
+                    cornerDistance(objectives, box) < cornerDistance(incumbent.objectives, box));
+            if (!better) {
+                return false;
+            }
+
+            // 同盒的代表不被其他盒支配、也不支配其他盒，替换时只需按新的第一个目标重新放置
+            entries_.erase(entries_.begin() + i);
+            Entry entry;
+            entry.objectives = objectives;
+            entry.box = box;
+            entry.schedule.reserve(static_cast<size_t>(rows_) * cols_);
+            for (const auto& row : solution) {
+                entry.schedule.insert(entry.schedule.end(), row.begin(), row.end());
+            }
+            entries_.insert(entries_.begin() + insertPosition(objectives), std::move(entry));
+            return true;
+        }
+
+        for (size_t i = upper; i-- > 0;) {
+            if (boxDominates(entries_[i].box, box)) {
+                return false;
+            }
+        }
+    }
+    else {
+        for (size_t i = upper; i-- > 0;) {
+            if (dominates(entries_[i].objectives, objectives) || entries_[i].objectives == objectives) {
+                return false;
+            }
+        }
+    }
+
+    // 移除被新解支配的档案成员：后段中保留的成员前移，最后一次截断
+    size_t kept = lower;
+    for (size_t i = lower; i < entries_.size(); ++i) {
+        bool dominated = gridded_ ? boxDominates(box, entries_[i].box)
+            : dominates(objectives, entries_[i].objectives);
+        if (!dominated) {
+            if (kept != i) {
+                entries_[kept] = std::move(entries_[i]);
+            }
+            kept++;
+        }
+    }
+    entries_.erase(entries_.begin() + kept, entries_.end());
+
+    // 仅在接收时才压缩保存解
+    Entry entry;
+    entry.objectives = objectives;
+    entry.box = box;
+    entry.schedule.reserve(static_cast<size_t>(rows_) * cols_);
+    for (const auto& row : solution) {
+        entry.schedule.insert(entry.schedule.end(), row.begin(), row.end());
+    }
+    entries_.insert(entries_.begin() + insertPosition(objectives), std::move(entry));
+
+    if (entries_.size() > capacity_) {
+        prune();
+    }
+
+    return true;
+}
+
+void ParetoArchive::clear() {
+    entries_.clear();
+    epsilon_ = {};
+    gridded_ = false;
+    rows_ = 0;
+    cols_ = 0;
+}
+
+void ParetoArchive::setCapacity(size_t capacity) {
+    capacity_ = std::max<size_t>(capacity, 1);
+    if (entries_.size() > capacity_) {
+        prune();
+    }
+}
+
+std::vector<std::vector<int>> ParetoArchive::solution(size_t i) const {
+    const auto& cells = entries_[i].schedule;
+    std::vector<std::vector<int>> decoded(rows_);
+
+    for (int r = 0; r < rows_; ++r) {
+        auto first = cells.begin() + static_cast<size_t>(r) * cols_;
+        decoded[r].assign(first, first + cols_);
+    }
+
+    return decoded;
+}
+
+std::vector<std::vector<std::vector<int>>> ParetoArchive::solutions() const {
+    std::vector<std::vector<std::vector<int>>> decoded;
+    decoded.reserve(entries_.size());
+
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        decoded.push_back(solution(i));
+    }
+
+    return decoded;
+}
+
+void ParetoArchive::restore(int rows, int cols, bool gridded, const Objectives& epsilon,
+    std::vector<Entry> entries) {
+    rows_ = rows;
+    cols_ = cols;
+    gridded_ = gridded;
+    epsilon_ = epsilon;
+    entries_ = std::move(entries);
+    sortEntries();
+}
+
+ParetoArchive::BoxKey ParetoArchive::makeBox(const Objectives& obj) const {
+    BoxKey box{};
+    if (!gridded_) {
+        return box;
+    }
+
+    for (int k = 0; k < kObjectives; ++k) {
+        box[k] = static_cast<long long>(std::floor(obj[k] / epsilon_[k]));
+    }
+    return box;
+}
+
+bool ParetoArchive::boxDominates(const BoxKey& a, const BoxKey& b) {
+    bool strictly_better = false;
+    for (int k = 0; k < kObjectives; ++k) {
+        if (a[k] > b[k]) return false;
+        if (a[k] < b[k]) strictly_better = true;
+    }
+    return strictly_better;
+}
+
+bool ParetoArchive::dominates(const Objectives& a, const Objectives& b) {
+    return ActiveObjectives::dominates(a, b);
+}
+
+double ParetoArchive::cornerDistance(const Objectives& obj, const BoxKey& box) const {
+    double dist = 0.0;
+    for (int k = 0; k < kObjectives; ++k) {
+        double d = (obj[k] - box[k] * epsilon_[k]) / epsilon_[k];
+        dist += d * d;
+    }
+    return dist;
+}
+
+size_t ParetoArchive::insertPosition(const Objectives& obj) const {
+    return std::partition_point(entries_.begin(), entries_.end(),
+        [&](const Entry& e) { return e.objectives[0] <= obj[0]; }) - entries_.begin();
+}
+
+void ParetoArchive::sortEntries() {
+    std::stable_sort(entries_.begin(), entries_.end(),
+        [](const Entry& a, const Entry& b) { return a.objectives[0] < b.objectives[0]; });
+}
+
+void ParetoArchive::regrid() {
+    // 按当前网格重新归箱：每格保留一个代表，并剔除被盒支配的格
+    std::vector<Entry> old_entries;
+    old_entries.swap(entries_);
+    std::unordered_map<BoxKey, size_t, BoxKeyHash> box_index;
+
+    for (auto& e : old_entries) {
+        e.box = makeBox(e.objectives);
+        auto same = box_index.find(e.box);
+        if (same != box_index.end()) {
+            Entry& incumbent = entries_[same->second];
+            if (dominates(e.objectives, incumbent.objectives) ||
+                (!dominates(incumbent.objectives, e.objectives) &&
+                    cornerDistance(e.objectives, e.box) < cornerDistance(incumbent.objectives, e.box))) {
+                incumbent = std::move(e);
+            }
+        }
+        else {
+            box_index[e.box] = entries_.size();
+            entries_.push_back(std::move(e));
+        }
+    }
+
+    std::vector<Entry> kept;
+    kept.reserve(entries_.size());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        bool dominated = false;
+        for (size_t j = 0; j < entries_.size() && !dominated; ++j) {
+            dominated = (i != j) && boxDominates(entries_[j].box, entries_[i].box);
+        }
+        if (!dominated) {
+            kept.push_back(std::move(entries_[i]));
+        }
+    }
+    entries_.swap(kept);
+    sortEntries();
+}
+
+void ParetoArchive::prune() {
+    if (!gridded_) {
+        // 首次超容量：由当前档案的目标范围确定网格边长
+        Objectives lo, hi;
+        lo.fill(std::numeric_limits<double>::max());
+        hi.fill(std::numeric_limits<double>::lowest());
+        for (const auto& e : entries_) {
+            for (int k = 0; k < kObjectives; ++k) {
+                lo[k] = std::min(lo[k], e.objectives[k]);
+                hi[k] = std::max(hi[k], e.objectives[k]);
+            }
+        }
+
+        // 从细网格开始，随后逐步放大直到满足容量，使档案尽量保持接近容量
+        double divisions = static_cast<double>(std::max<size_t>(capacity_, 2));
+        for (int k = 0; k < kObjectives; ++k) {
+            double range = hi[k] - lo[k];
+            epsilon_[k] = range > 0 ? range / divisions : 1.0;
+        }
+        gridded_ = true;
+        regrid();
+    }
+
+    // 仍超容量则逐步放大网格
+    while (entries_.size() > capacity_) {
+        for (auto& eps : epsilon_) {
+            eps *= 1.25;
+        }
+        regrid();
+    }
+}
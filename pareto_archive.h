@@ -0,0 +1,78 @@
+#pragma once
+// pareto_archive.h
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include "objective_policies.h"
+
+// 外部精英档案：跨代保存所有可行候选中的非支配解
+// 目标均按最小化处理；超出容量时启用 epsilon 网格（盒支配）裁剪
+// 成员按第一个目标升序保存，插入时二分定位，只与该维上可能构成支配关系的一段成员比较
+class ParetoArchive {
+public:
+    static constexpr int kObjectives = ActiveObjectives::N;
+    using Objectives = std::array<double, kObjectives>;
+    using BoxKey = std::array<long long, kObjectives>;
+
+    struct Entry {
+        Objectives objectives;
+        BoxKey box;
+        std::vector<int8_t> schedule;   // 按行展开的三态矩阵（-1/0/1）
+    };
+
+    explicit ParetoArchive(size_t capacity = 200);
+
+    // 插入候选解，返回是否被档案接收
+    bool insert(const std::vector<std::vector<int>>& solution, const Objectives& objectives);
+
+    void clear();
+    void setCapacity(size_t capacity);
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    size_t capacity() const { return capacity_; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    const Objectives& epsilon() const { return epsilon_; }
+    bool gridded() const { return gridded_; }
+
+    const Objectives& objectives(size_t i) const { return entries_[i].objectives; }
+    const std::vector<Entry>& entries() const { return entries_; }
+    std::vector<std::vector<int>> solution(size_t i) const;
+    std::vector<std::vector<std::vector<int>>> solutions() const;
+
+    // 从断点恢复档案状态
+    void restore(int rows, int cols, bool gridded, const Objectives& epsilon, std::vector<Entry> entries);
+
+private:
+    struct BoxKeyHash {
+        std::size_t operator()(const BoxKey& key) const {
+            std::size_t h = 0;
+            for (long long v : key) {
+                h ^= std::hash<long long>()(v) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+    };
+
+    BoxKey makeBox(const Objectives& obj) const;
+    static bool boxDominates(const BoxKey& a, const BoxKey& b);
+    static bool dominates(const Objectives& a, const Objectives& b);
+    double cornerDistance(const Objectives& obj, const BoxKey& box) const;
+
+    // 按第一个目标的插入位置（相同取值放在末尾）
+    size_t insertPosition(const Objectives& obj) const;
+    void sortEntries();
+    void regrid();
+    void prune();
+
+    std::vector<Entry> entries_;                // 按 objectives[0] 升序
+
+    size_t capacity_;
+    Objectives epsilon_{};  // 网格边长，仅在 gridded_ 为真时有效
+    bool gridded_ = false;  // 未超容量前按精确支配维护
+    int rows_ = 0;
+    int cols_ = 0;
+};
@@ -0,0 +1,587 @@
+// perf_baseline.cpp
+#include "perf_baseline.h"
+#include "satellite_data_loader.h"
+#include "thread_cpu_timer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+namespace {
+    const char* const kBaselineHeader = "# fwa_baseline 3";
+    const int kEvaluatePasses = 5;      // 评估 / 排序阶段每次计时连续处理语料的遍数，单遍耗时很短
+    const int kSparksPerSchedule = 8;   // 爆炸阶段每个语料调度产生的火花数
+    const int kSparkMaxChanges = 10;    // 爆炸阶段的最多修改卫星数（与 SchedulingScenario 的默认 max_changes 相同）
+
+    // 语料中记录的原始指标（与 ScheduleMetrics 字段一一对应，不受当前目标集合影响）
+    struct MetricField {
+        const char* name;
+        double ScheduleMetrics::* field;
+    };
+    const MetricField kMetricFields[] = {
+        { "satellite_count", &ScheduleMetrics::satellite_count },
+        { "coverage", &ScheduleMetrics::coverage },
+        { "load_variance", &ScheduleMetrics::load_variance },
+        { "switch_count", &ScheduleMetrics::switch_count },
+        { "peak_concurrency", &ScheduleMetrics::peak_concurrency },
+        { "max_revisit_gap", &ScheduleMetrics::max_revisit_gap },
+        { "unique_coverage", &ScheduleMetrics::unique_coverage },
+        { "max_point_gap", &ScheduleMetrics::max_point_gap },
+    };
+
+    // 计数器字段（与 RegionCounts 一一对应），counters 行按此顺序保存
+    const struct {
+        const char* name;
+        int64_t RegionCounts::* field;
+    } kCountFields[] = {
+        { "cycles", &RegionCounts::cycles },
+        { "instructions", &RegionCounts::instructions },
+        { "llc_misses", &RegionCounts::llc_misses },
+        { "branch_misses", &RegionCounts::branch_misses },
+        { "allocations", &RegionCounts::allocations },
+        { "allocated_bytes", &RegionCounts::allocated_bytes },
+    };
+
+    // 重复计时中保留耗时最小的一次及其硬件计数；堆分配取最后一次重复，
+    // 首次运行中缓存扩容等一次性分配不计入，同一输入下的分配次数在各次运行间可比
+    struct PhaseBest {
+        double ms = std::numeric_limits<double>::max();
+        RegionCounts counts;
+
+        void offer(double attempt_ms, const RegionCounts& attempt_counts) {
+            if (attempt_ms < ms) {
+                ms = attempt_ms;
+                counts = attempt_counts;
+            }
+            counts.allocations = attempt_counts.allocations;
+            counts.allocated_bytes = attempt_counts.allocated_bytes;
+        }
+    };
+
+    // 爆炸阶段需要与 optimize 相同的适应度（受保护成员）
+    class SparkBench : public SatelliteSchedulerMultiObjective {
+    public:
+        double fitness(const std::vector<std::vector<int>>& solution) {
+            return fitnessValue(evaluate(solution, true));
+        }
+    };
+
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    front_metrics::ObjectivePoint toPoint(const ScheduleMetrics& metrics) {
+        auto values = ActiveObjectives::minimized(metrics);
+        return front_metrics::ObjectivePoint(values.begin(), values.end());
+    }
+
+    // 三态调度按行写成 '1' / '0' / '.'，行间以 '/' 分隔
+    std::string encodeSchedule(const std::vector<std::vector<int>>& schedule) {
+        std::string text;
+        for (size_t r = 0; r < schedule.size(); ++r) {
+            if (r > 0) text += '/';
+            for (int v : schedule[r]) {
+                text += v == 1 ? '1' : (v == 0 ? '0' : '.');
+            }
+        }
+        return text;
+    }
+
+    bool decodeSchedule(const std::string& text, std::vector<std::vector<int>>& schedule) {
+        schedule.assign(1, {});
+        for (char c : text) {
+            if (c == '/') {
+                schedule.emplace_back();
+            }
+            else if (c == '1' || c == '0' || c == '.') {
+                schedule.back().push_back(c == '1' ? 1 : (c == '0' ? 0 : -1));
+            }
+            else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void writeValues(std::ostream& out, const std::vector<double>& values) {
+        for (double v : values) {
+            out << ' ' << v;
+        }
+    }
+}
+
+bool BaselineRecord::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "无法写入基线文件: " << path << std::endl;
+        return false;
+    }
+
+    file << std::setprecision(17);
+    file << kBaselineHeader << "\n";
+    file << "seed " << seed << "\n";
+    for (const auto& phase : phases) {
+        file << "phase " << phase.name << ' ' << phase.ms << "\n";
+        if (phase.counts.hasHardware() || phase.counts.hasAllocations()) {
+            file << "counters " << phase.name;
+            for (const auto& f : kCountFields) {
+                file << ' ' << phase.counts.*f.field;
+            }
+            file << "\n";
+        }
+    }
+    file << "range_min";
+    writeValues(file, range.min_val);
+    file << "\nrange_max";
+    writeValues(file, range.max_val);
+    file << "\n";
+    for (const auto& hv : hypervolumes) {
+        file << "hypervolume " << hv.first << ' ' << hv.second << "\n";
+    }
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        file << "schedule";
+        for (const auto& f : kMetricFields) {
+            file << ' ' << corpus_metrics[i].*f.field;
+        }
+        file << ' ' << encodeSchedule(corpus[i]) << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool BaselineRecord::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "无法打开基线文件: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line) || line != kBaselineHeader) {
+        std::cerr << "基线文件格式错误: " << path << std::endl;
+        return false;
+    }
+
+    *this = BaselineRecord();
+    int line_no = 1;
+    while (std::getline(file, line)) {
+        line_no++;
+        std::istringstream ss(line);
+        std::string key;
+        if (!(ss >> key)) continue;
+
+        bool ok = true;
+        if (key == "seed") {
+            ok = static_cast<bool>(ss >> seed);
+        }
+        else if (key == "phase") {
+            BaselinePhase phase;
+            ok = static_cast<bool>(ss >> phase.name >> phase.ms);
+            phases.push_back(phase);
+        }
+        else if (key == "counters") {
+            std::string name;
+            RegionCounts counts;
+            ok = static_cast<bool>(ss >> name);
+            for (const auto& f : kCountFields) {
+                ok = ok && static_cast<bool>(ss >> counts.*f.field);
+            }
+            auto it = std::find_if(phases.begin(), phases.end(),
+                [&](const BaselinePhase& phase) { return phase.name == name; });
+            if (ok && it != phases.end()) {
+                it->counts = counts;
+            }
+        }
+        else if (key == "range_min" || key == "range_max") {
+            auto& values = key == "range_min" ? range.min_val : range.max_val;
+            double v;
+            while (ss >> v) {
+                values.push_back(v);
+            }
+        }
+        else if (key == "hypervolume") {
+            std::pair<std::string, double> hv;
+            ok = static_cast<bool>(ss >> hv.first >> hv.second);
+            hypervolumes.push_back(hv);
+        }
+        else if (key == "schedule") {
+            ScheduleMetrics metrics;
+            for (const auto& f : kMetricFields) {
+                ok = ok && static_cast<bool>(ss >> metrics.*f.field);
+            }
+            std::string text;
+            std::vector<std::vector<int>> schedule;
+            ok = ok && static_cast<bool>(ss >> text) && decodeSchedule(text, schedule);
+            corpus.push_back(std::move(schedule));
+            corpus_metrics.push_back(metrics);
+        }
+
+        if (!ok) {
+            std::cerr << "基线文件第 " << line_no << " 行格式错误: " << path << std::endl;
+            return false;
+        }
+    }
+
+    if (range.min_val.size() != range.max_val.size()) {
+        std::cerr << "基线文件归一化范围不完整: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+PerfBaseline::PerfBaseline(const BaselineOptions& options) : options_(options) {
+    if (options_.scenarios.empty()) {
+        options_.scenarios = defaultScenarios();
+    }
+    options_.repeats = std::max(1, options_.repeats);
+}
+
+std::vector<SchedulingScenario> PerfBaseline::defaultScenarios() {
+    SchedulingScenario pareto{ "pareto" };
+    pareto.max_iter = 20;
+    pareto.num_fireworks = 10;
+    pareto.max_changes = 20;
+
+    SchedulingScenario decomposition = pareto;
+    decomposition.name = "decomposition";
+    decomposition.engine = OptimizerEngine::Decomposition;
+
+    return { pareto, decomposition };
+}
+
+bool PerfBaseline::run(BaselineRecord& record, const BaselineRecord* reference) {
+    record = BaselineRecord();
+    record.seed = reference ? reference->seed : options_.seed;
+    int repeats = options_.repeats;
+
+    // 本线程上的硬件计数器；优化阶段在 ScenarioRunner 的工作线程上另行计数
+    PerfCounters counters;
+    record.counter_status = counters.status();
+
+    // 读取时间窗口（CSV 解析与压缩）
+    SatelliteDataLoader loader;
+    PhaseBest best;
+    for (int r = 0; r < repeats; ++r) {
+        SatelliteDataLoader attempt;
+        attempt.setSatelliteCount(options_.num_satellites);
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        attempt.loadDataFromExcel(options_.directory_path);
+        double ms = elapsedMs(start);
+        best.offer(ms, counters.stop());
+        loader = std::move(attempt);
+    }
+    if (loader.getCompressedMatrix().empty() || loader.getBounds().empty()) {
+        std::cerr << "未读取到任何卫星时间窗口数据: " << options_.directory_path << std::endl;
+        return false;
+    }
+    record.phases.push_back({ "load_windows", best.ms, best.counts });
+
+    // 构建问题（网格读取、缺失网格的固定种子填充、打包覆盖率模型）
+    SatelliteSchedulerMultiObjective scheduler;
+    best = PhaseBest();
+    for (int r = 0; r < repeats; ++r) {
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        scheduler.setCoverageDataDir(options_.mesh_dir);
+        scheduler.setMeshFillSeed(record.seed);
+        scheduler.loadProblem(loader);
+        scheduler.getProblem()->packedCoverage();
+        double ms = elapsedMs(start);
+        best.offer(ms, counters.stop());
+    }
+    record.phases.push_back({ "load_problem", best.ms, best.counts });
+    auto problem = scheduler.getProblem();
+
+    // 各场景的固定种子优化；时间预算会使结果依赖机器速度，这里忽略
+    std::vector<SchedulingScenario> scenarios = options_.scenarios;
+    for (auto& scenario : scenarios) {
+        if (scenario.time_budget_ms > 0.0) {
+            std::cerr << "场景 " << scenario.name << " 的时间预算在基线中被忽略" << std::endl;
+            scenario.time_budget_ms = 0.0;
+        }
+    }
+
+    ScenarioRunner runner(problem, 1);
+    uint32_t seed = record.seed;
+    runner.setConfigure([seed](SatelliteSchedulerMultiObjective& s) { s.setRandomSeed(seed); });
+
+    std::vector<ScenarioResult> results;
+    std::vector<PhaseBest> optimize_best(scenarios.size());
+    for (int r = 0; r < repeats; ++r) {
+        auto attempt = runner.run(scenarios);
+        for (size_t s = 0; s < attempt.size(); ++s) {
+            if (!attempt[s].ok) {
+                std::cerr << "场景运行失败 (" << attempt[s].name << "): " << attempt[s].error << std::endl;
+                return false;
+            }
+            optimize_best[s].offer(attempt[s].cpu_ms, attempt[s].counts);
+            if (r > 0 && attempt[s].metrics.size() != results[s].metrics.size()) {
+                std::cerr << "警告: 场景 " << attempt[s].name << " 在相同种子下结果不一致" << std::endl;
+            }
+        }
+        if (r == 0) {
+            results = std::move(attempt);
+        }
+    }
+    for (size_t s = 0; s < scenarios.size(); ++s) {
+        record.phases.push_back({ "optimize/" + scenarios[s].name, optimize_best[s].ms, optimize_best[s].counts });
+    }
+
+    // 调度语料：对比模式沿用基线中的语料；记录模式由随机解、启发式解和各场景前沿组成
+    if (reference) {
+        record.corpus = reference->corpus;
+        record.range = reference->range;
+    }
+    else {
+        SatelliteSchedulerMultiObjective generator;
+        generator.attachProblem(problem);
+        generator.setRandomSeed(record.seed);
+        for (int i = 0; i < options_.corpus_size; ++i) {
+            record.corpus.push_back(generator.initializeSolution());
+        }
+        record.corpus.push_back(generator.buildHeuristicSolution(
+            SatelliteSchedulerSolution::SeedHeuristic::GreedyCoverageRate));
+        record.corpus.push_back(generator.buildHeuristicSolution(
+            SatelliteSchedulerSolution::SeedHeuristic::MinSatellites));
+        record.corpus.push_back(generator.buildHeuristicSolution(
+            SatelliteSchedulerSolution::SeedHeuristic::BalancedRoundRobin));
+        for (const auto& result : results) {
+            record.corpus.insert(record.corpus.end(), result.front.begin(), result.front.end());
+        }
+    }
+
+    // 评估语料：每一遍之前清空评估缓存，计时的是完整评估
+    SatelliteSchedulerMultiObjective evaluator;
+    evaluator.attachProblem(problem);
+    for (const auto& schedule : record.corpus) {
+        if (schedule.size() != static_cast<size_t>(problem->rows()) ||
+            (!schedule.empty() && schedule[0].size() != static_cast<size_t>(problem->cols()))) {
+            std::cerr << "语料中的调度与当前问题规模不一致" << std::endl;
+            return false;
+        }
+    }
+
+    best = PhaseBest();
+    for (int r = 0; r < repeats; ++r) {
+        std::vector<ScheduleMetrics> metrics(record.corpus.size());
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < kEvaluatePasses; ++pass) {
+            evaluator.clearEvaluationCache();
+            for (size_t i = 0; i < record.corpus.size(); ++i) {
+                metrics[i] = evaluator.evaluate(record.corpus[i], false);
+            }
+        }
+        double ms = elapsedMs(start) / kEvaluatePasses;
+        best.offer(ms, counters.stop());
+        record.corpus_metrics = std::move(metrics);
+    }
+    record.phases.push_back({ "evaluate", best.ms, best.counts });
+
+    // 非支配排序：语料的评估结果已在缓存中，计时的是排序本身（含缓存查找）
+    best = PhaseBest();
+    evaluator.fastNonDominatedSort(record.corpus);
+    for (int r = 0; r < repeats; ++r) {
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < kEvaluatePasses; ++pass) {
+            evaluator.fastNonDominatedSort(record.corpus);
+        }
+        double ms = elapsedMs(start) / kEvaluatePasses;
+        best.offer(ms, counters.stop());
+    }
+    record.phases.push_back({ "nondominated_sort", best.ms, best.counts });
+
+    // 爆炸：以语料为烟花，按 optimize 的方式计算适应度与火花概率，每个调度产生固定数量的火花
+    // 每次重复重置种子，产生的火花相同；父解的评估在计时前完成
+    best = PhaseBest();
+    for (int r = 0; r < repeats; ++r) {
+        SparkBench bench;
+        bench.attachProblem(problem);
+        bench.setRandomSeed(record.seed);
+        double fmax = -std::numeric_limits<double>::max();
+        double fsum = 0.0;
+        for (const auto& schedule : record.corpus) {
+            double value = bench.fitness(schedule);
+            fmax = std::max(fmax, value);
+            fsum += value;
+        }
+
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < record.corpus.size(); ++i) {
+            bench.setSparkStream(0, static_cast<int>(i));
+            bench.explode(record.corpus[i], kSparksPerSchedule, kSparkMaxChanges,
+                fmax, fsum, static_cast<double>(record.corpus.size()), std::numeric_limits<double>::epsilon());
+        }
+        double ms = elapsedMs(start);
+        best.offer(ms, counters.stop());
+    }
+    record.phases.push_back({ "explode", best.ms, best.counts });
+
+    if (!reference) {
+        for (const auto& metrics : record.corpus_metrics) {
+            record.range.include(toPoint(metrics));
+        }
+    }
+
+    for (const auto& result : results) {
+        std::vector<front_metrics::ObjectivePoint> points;
+        for (const auto& metrics : result.metrics) {
+            points.push_back(toPoint(metrics));
+        }
+        record.hypervolumes.emplace_back(result.name, front_metrics::normalizedHypervolume(points, record.range));
+    }
+
+    return true;
+}
+
+bool PerfBaseline::compare(const BaselineRecord& baseline, const BaselineRecord& current,
+    std::ostream& report) const {
+
+    bool consistent = true;
+    report << std::setprecision(6);
+    report << "== 正确性 ==" << std::endl;
+
+    // 语料目标值
+    if (baseline.corpus_metrics.size() != current.corpus_metrics.size()) {
+        report << "语料规模不一致: 基线 " << baseline.corpus_metrics.size() << " 个, 当前 "
+            << current.corpus_metrics.size() << " 个" << std::endl;
+        consistent = false;
+    }
+    else {
+        size_t drifted = 0;
+        double worst = 0.0;
+        std::string worst_field;
+        size_t worst_index = 0;
+        int listed = 0;
+        for (size_t i = 0; i < baseline.corpus_metrics.size(); ++i) {
+            bool schedule_drifted = false;
+            for (const auto& f : kMetricFields) {
+                double a = baseline.corpus_metrics[i].*f.field;
+                double b = current.corpus_metrics[i].*f.field;
+                double error = std::fabs(a - b) / std::max(1.0, std::fabs(a));
+                if (error > worst) {
+                    worst = error;
+                    worst_field = f.name;
+                    worst_index = i;
+                }
+                if (error > options_.objective_tolerance) {
+                    schedule_drifted = true;
+                    if (listed < 10) {
+                        report << "  调度 " << i << " 的 " << f.name << ": 基线 " << std::setprecision(17) << a
+                            << ", 当前 " << b << std::setprecision(6) << std::endl;
+                        listed++;
+                    }
+                }
+            }
+            drifted += schedule_drifted ? 1 : 0;
+        }
+
+        report << "语料 " << baseline.corpus_metrics.size() << " 个调度, 目标值超出容差 "
+            << options_.objective_tolerance << " 的 " << drifted << " 个";
+        if (worst > 0.0) {
+            report << ", 最大相对误差 " << worst << " (调度 " << worst_index << " 的 " << worst_field << ")";
+        }
+        report << std::endl;
+        consistent = consistent && drifted == 0;
+    }
+
+    // 前沿超体积（同一归一化范围）
+    for (const auto& hv : baseline.hypervolumes) {
+        auto it = std::find_if(current.hypervolumes.begin(), current.hypervolumes.end(),
+            [&](const std::pair<std::string, double>& c) { return c.first == hv.first; });
+        if (it == current.hypervolumes.end()) {
+            report << "超体积 " << hv.first << ": 当前运行中没有该场景" << std::endl;
+            continue;
+        }
+        double diff = it->second - hv.second;
+        bool ok = std::fabs(diff) <= options_.hypervolume_tolerance;
+        report << "超体积 " << hv.first << ": 基线 " << hv.second << ", 当前 " << it->second
+            << " (" << (diff >= 0 ? "+" : "") << diff << ")" << (ok ? "" : "  超出容差") << std::endl;
+        consistent = consistent && ok;
+    }
+
+    // 分阶段耗时：比值为 基线 / 当前，大于 1 表示加速
+    report << "== 性能 ==" << std::endl;
+    // 表头中每个汉字在 UTF-8 下占 3 字节、显示 2 列，宽度按字节数补齐
+    report << std::left << std::setw(30) << "阶段" << std::right << std::setw(16) << "基线(ms)"
+        << std::setw(16) << "当前(ms)" << std::setw(12) << "比值" << std::endl;
+    for (const auto& phase : current.phases) {
+        auto it = std::find_if(baseline.phases.begin(), baseline.phases.end(),
+            [&](const BaselinePhase& b) { return b.name == phase.name; });
+        report << std::left << std::setw(28) << phase.name << std::right << std::fixed << std::setprecision(2);
+        if (it == baseline.phases.end()) {
+            report << std::setw(14) << "-" << std::setw(14) << phase.ms << std::endl;
+            report.unsetf(std::ios::fixed);
+            continue;
+        }
+
+        double ratio = phase.ms > 0.0 ? it->ms / phase.ms : 1.0;
+        report << std::setw(14) << it->ms << std::setw(14) << phase.ms << std::setw(9) << ratio << "x";
+        if (ratio > 1.0 + options_.timing_threshold) {
+            report << "  加速";
+        }
+        else if (ratio < 1.0 / (1.0 + options_.timing_threshold)) {
+            report << "  变慢";
+        }
+        report << std::endl;
+        report.unsetf(std::ios::fixed);
+    }
+    report << std::setprecision(6);
+
+    // 计数器：当前运行各阶段的硬件计数与堆分配；同一输入下分配次数是确定的，与基线不同时列出基线值
+    report << "== 计数器 ==" << std::endl;
+    if (!current.counter_status.empty()) {
+        report << current.counter_status << std::endl;
+    }
+    auto cell = [&](int width, int64_t value, double scale) {
+        if (value < 0) {
+            report << std::setw(width) << "-";
+        }
+        else {
+            report << std::setw(width) << value / scale;
+        }
+    };
+    report << std::left << std::setw(30) << "阶段" << std::right << std::setw(14) << "周期(M)"
+        << std::setw(8) << "IPC" << std::setw(18) << "LLC未命中(K)" << std::setw(20) << "分支未命中(K)"
+        << std::setw(16) << "分配次数" << std::setw(14) << "分配(KB)" << std::endl;
+    for (const auto& phase : current.phases) {
+        const RegionCounts& c = phase.counts;
+        report << std::left << std::setw(28) << phase.name << std::right << std::fixed << std::setprecision(1);
+        cell(10, c.cycles, 1e6);
+        if (c.cycles > 0 && c.instructions >= 0) {
+            report << std::setw(8) << std::setprecision(2) << static_cast<double>(c.instructions) / c.cycles
+                << std::setprecision(1);
+        }
+        else {
+            report << std::setw(8) << "-";
+        }
+        cell(12, c.llc_misses, 1e3);
+        cell(13, c.branch_misses, 1e3);
+        if (c.allocations < 0) {
+            report << std::setw(12) << "-";
+        }
+        else {
+            report << std::setw(12) << c.allocations;
+        }
+        cell(12, c.allocated_bytes, 1024.0);
+        report.unsetf(std::ios::fixed);
+
+        auto it = std::find_if(baseline.phases.begin(), baseline.phases.end(),
+            [&](const BaselinePhase& b) { return b.name == phase.name; });
+        if (it != baseline.phases.end() && it->counts.hasAllocations() && c.hasAllocations() &&
+            it->counts.allocations != c.allocations) {
+            report << "  基线分配 " << it->counts.allocations;
+        }
+        report << std::endl;
+    }
+    report << std::setprecision(6);
+
+    report << (consistent ? "结论: 结果与基线一致" : "结论: 结果与基线存在漂移") << std::endl;
+    return consistent;
+}
@@ -0,0 +1,66 @@
+#pragma once
+// perf_baseline.h
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include "scenario_runner.h"
+#include "front_metrics.h"
+#include "perf_counters.h"
+
+// 基线的运行选项；对比时应与记录时使用相同的数据目录、卫星数和场景
+struct BaselineOptions {
+    std::string directory_path;             // 时间窗口文件目录，空表示当前目录
+    std::string mesh_dir;                   // 网格文件目录，空表示当前目录
+    int num_satellites = 10;
+    uint32_t seed = 20240601;               // 优化、语料生成与缺失网格填充的种子（对比时取基线中的值）
+    int corpus_size = 32;                   // 记录时随机生成的调度数（另加三种启发式解与各场景前沿）
+    int repeats = 5;                        // 各计时阶段的重复次数，取最小值
+    double objective_tolerance = 1e-9;      // 目标值容差：|a-b| <= tol * max(1, |a|)
+    double hypervolume_tolerance = 1e-6;    // 前沿超体积的绝对容差
+    double timing_threshold = 0.10;         // 耗时比值偏离 1 超过该比例才报告为加速 / 变慢
+    std::vector<SchedulingScenario> scenarios;  // 为空时使用 defaultScenarios()
+};
+
+struct BaselinePhase {
+    std::string name;
+    double ms = 0.0;                        // 重复运行中的最小耗时（优化阶段为线程 CPU 时间，评估阶段为评估一遍语料）
+    RegionCounts counts;                    // 耗时最小的那次重复的硬件计数与堆分配，不可用的项为 -1
+};
+
+// 一次基线运行的全部记录：调度语料及其原始目标值、各场景前沿超体积、分阶段耗时
+// 语料随基线文件保存，对比时评估的是同一批调度，与随机数序列或初始化方式的改动无关
+struct BaselineRecord {
+    uint32_t seed = 0;
+    std::vector<BaselinePhase> phases;
+    std::vector<std::vector<std::vector<int>>> corpus;
+    std::vector<ScheduleMetrics> corpus_metrics;
+    front_metrics::ObjectiveRange range;    // 超体积的归一化范围，记录时确定，对比时沿用
+    std::vector<std::pair<std::string, double>> hypervolumes;
+    std::string counter_status;             // 硬件计数器不可用的原因（不保存）
+
+    // 文本格式，每行一项：seed / phase / counters / range_min / range_max / hypervolume / schedule
+    // counters 行是可选的：没有该行的旧基线照常读取，对比时只缺少计数器的对照
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+// 金标准输出与性能基线：以固定种子运行一组场景，记录语料的原始目标值、前沿超体积和
+// 读取窗口 / 构建问题 / 评估 / 爆炸 / 非支配排序 / 各场景优化的耗时与硬件计数、堆分配；之后的构建按容差与之对比
+// 只使用随仓库提供的 satellite_*.csv 与 s*_*.csv，缺失的网格由固定种子填充，可离线运行
+class PerfBaseline {
+public:
+    explicit PerfBaseline(const BaselineOptions& options = BaselineOptions());
+
+    // 两个小规模场景：Pareto 引擎与分解引擎各一个，均不设时间预算
+    static std::vector<SchedulingScenario> defaultScenarios();
+
+    // reference 为空时为记录模式（生成语料、确定归一化范围）；否则沿用 reference 的语料、范围和种子
+    bool run(BaselineRecord& record, const BaselineRecord* reference = nullptr);
+
+    // 写出对比报告：正确性漂移（目标值、超体积）、各阶段的加速 / 变慢与计数器；返回是否没有正确性漂移
+    bool compare(const BaselineRecord& baseline, const BaselineRecord& current, std::ostream& report) const;
+
+private:
+    BaselineOptions options_;
+};
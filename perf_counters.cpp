@@ -0,0 +1,126 @@
+// perf_counters.cpp
+#include "perf_counters.h"
+#include "allocation_tracker.h"
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#if defined(__linux__)
+namespace {
+    int openEvent(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // pid = 0, cpu = -1：当前线程，任意 CPU
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    // 读取计数并按运行时间比例换算；事件从未被调度上硬件时返回 -1
+    int64_t readScaled(int fd) {
+        uint64_t values[3] = { 0, 0, 0 };     // 计数、启用时间、运行时间
+        if (read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0) {
+            return -1;
+        }
+        if (values[2] >= values[1]) {
+            return static_cast<int64_t>(values[0]);
+        }
+        return static_cast<int64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+    }
+}
+#endif
+
+PerfCounters::PerfCounters() {
+    for (int& fd : fds_) {
+        fd = -1;
+    }
+
+#if defined(__linux__)
+    const struct { uint32_t type; uint64_t config; } events[EventCount] = {
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+        { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    };
+    int first_error = 0;
+    for (int e = 0; e < EventCount; ++e) {
+        fds_[e] = openEvent(events[e].type, events[e].config);
+        if (fds_[e] < 0 && first_error == 0) {
+            first_error = errno;
+        }
+    }
+    if (!available()) {
+        status_ = std::string("perf_event_open 不可用: ") + std::strerror(first_error);
+        if (first_error == EACCES || first_error == EPERM) {
+            status_ += "（检查 /proc/sys/kernel/perf_event_paranoid 或容器权限）";
+        }
+    }
+    else if (first_error != 0) {
+        status_ = std::string("部分硬件事件不可用: ") + std::strerror(first_error);
+    }
+#else
+    status_ = "硬件计数器仅在 Linux 上可用";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::available() const {
+    for (int fd : fds_) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+    auto allocations = AllocationTracker::snapshot();
+    allocations_start_ = allocations.allocations;
+    bytes_start_ = allocations.bytes;
+
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+RegionCounts PerfCounters::stop() {
+    RegionCounts counts;
+
+#if defined(__linux__)
+    for (int fd : fds_) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    int64_t* targets[EventCount] = { &counts.cycles, &counts.instructions, &counts.llc_misses, &counts.branch_misses };
+    for (int e = 0; e < EventCount; ++e) {
+        if (fds_[e] >= 0) {
+            *targets[e] = readScaled(fds_[e]);
+        }
+    }
+#endif
+
+    if (AllocationTracker::installed()) {
+        auto allocations = AllocationTracker::snapshot();
+        counts.allocations = allocations.allocations - allocations_start_;
+        counts.allocated_bytes = allocations.bytes - bytes_start_;
+    }
+    return counts;
+}
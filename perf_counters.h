@@ -0,0 +1,46 @@
+#pragma once
+// perf_counters.h
+#include <cstdint>
+#include <string>
+
+// 一个计量区间的硬件计数与堆分配，取值 -1 表示该项不可用
+struct RegionCounts {
+    int64_t cycles = -1;
+    int64_t instructions = -1;
+    int64_t llc_misses = -1;            // 末级缓存未命中
+    int64_t branch_misses = -1;
+    int64_t allocations = -1;           // operator new 调用次数（需链接 allocation_hook.cpp）
+    int64_t allocated_bytes = -1;
+
+    bool hasHardware() const { return cycles >= 0 || instructions >= 0 || llc_misses >= 0 || branch_misses >= 0; }
+    bool hasAllocations() const { return allocations >= 0; }
+};
+
+// 当前线程的硬件性能计数器（Linux perf_event_open，只计用户态）与堆分配计数
+// 构造时在当前线程上打开计数器，start / stop 之间的计数由 stop 返回，可反复使用；
+// 只能在构造它的线程上调用 start / stop
+// 非 Linux 平台、内核不允许（perf_event_paranoid、容器权限）或硬件不支持某项事件时，对应项为 -1，
+// status() 给出原因，计时与其余计数不受影响
+// 多个事件轮流占用硬件计数器时，按事件实际运行时间的比例换算为整个区间的估计值
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // 是否至少有一项硬件事件可用
+    bool available() const;
+    const std::string& status() const { return status_; }
+
+    void start();
+    RegionCounts stop();
+
+private:
+    enum Event { Cycles, Instructions, LlcMisses, BranchMisses, EventCount };
+
+    int fds_[EventCount];
+    int64_t allocations_start_ = 0;
+    int64_t bytes_start_ = 0;
+    std::string status_;
+};
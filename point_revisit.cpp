@@ -0,0 +1,226 @@
+// point_revisit.cpp
+#include "point_revisit.h"
+#include <algorithm>
+#include <iomanip>
+#include "bitplane_schedule.h"
+
+namespace {
+    const int kMaxPlanes = 32;
+
+    // 在 mask 选中的网格点上用时间 now 更新：gap = max(gap, now - last)，last = now
+    void observe(uint64_t* last, uint64_t* gap, int planes, int now, uint64_t mask) {
+        // 按平面做 now - last（now 对所有网格点相同，且不小于 last，不会最终借位）
+        uint64_t diff[kMaxPlanes];
+        uint64_t borrow = 0;
+        for (int b = 0; b < planes; ++b) {
+            uint64_t a = (now >> b & 1) ? ~0ULL : 0ULL;
+            uint64_t l = last[b];
+            diff[b] = a ^ l ^ borrow;
+            borrow = (~a & (l | borrow)) | (l & borrow);
+        }
+
+        // 从高位到低位比较 diff 与 gap
+        uint64_t greater = 0;
+        uint64_t equal = ~0ULL;
+        for (int b = planes - 1; b >= 0; --b) {
+            greater |= equal & diff[b] & ~gap[b];
+            equal &= ~(diff[b] ^ gap[b]);
+        }
+
+        uint64_t select = greater & mask;
+        if (select != 0) {
+            for (int b = 0; b < planes; ++b) {
+                gap[b] ^= (gap[b] ^ diff[b]) & select;
+            }
+        }
+        for (int b = 0; b < planes; ++b) {
+            uint64_t a = (now >> b & 1) ? ~0ULL : 0ULL;
+            last[b] ^= (last[b] ^ a) & mask;
+        }
+    }
+
+    uint64_t laneMask(int q, int w) {
+        int lanes = std::min(64, q - w * 64);
+        return lanes == 64 ? ~0ULL : (1ULL << lanes) - 1;
+    }
+
+    int planesFor(int span) {
+        int planes = 1;
+        while (planes < kMaxPlanes - 1 && (1LL << planes) <= span) {
+            planes++;
+        }
+        return planes;
+    }
+
+    // 按列的时间顺序给出有卫星开机的列：visit(now, seen)，now 为相对时域起点的时间，seen 为该列开机网格的并集
+    template <typename Visit>
+    void forEachObservation(const UniqueCoverage& model, const std::vector<int>& bounds,
+        const std::vector<std::vector<int>>& solution, Visit&& visit) {
+
+        int words = model.words();
+        std::vector<uint64_t> seen(words);
+        int cols = std::min(model.cols(), static_cast<int>(bounds.size()));
+        for (int col = 0; col < cols; ++col) {
+            bool any = false;
+            for (int sat = 0; sat < model.rows(); ++sat) {
+                if (solution[sat][col] != 1 || !model.hasMesh(sat, col)) continue;
+                if (!any) {
+                    std::fill(seen.begin(), seen.end(), 0ULL);
+                    any = true;
+                }
+                model.orMesh(sat, col, seen.data());
+            }
+            if (any) {
+                visit(bounds[col] - bounds.front(), seen.data());
+            }
+        }
+    }
+
+    // mask 选中的网格点中 last 的最小值（从最高平面向下，能取 0 的位就取 0；无分支，避免随机数据上的误预测）
+    int minimumLast(const uint64_t* last, int planes, uint64_t mask) {
+        int value = 0;
+        for (int b = planes - 1; b >= 0; --b) {
+            uint64_t zero = mask & ~last[b];
+            int one = zero == 0;
+            value |= one << b;
+            mask = one ? mask : zero;
+        }
+        return value;
+    }
+}
+
+std::vector<uint64_t> PointRevisitGap::scan(const UniqueCoverage& model, const std::vector<int>& bounds,
+    const std::vector<std::vector<int>>& solution, int& planes) {
+
+    int words = model.words();
+    int span = bounds.empty() ? 0 : bounds.back() - bounds.front();
+    planes = planesFor(span);
+
+    std::vector<uint64_t> last(static_cast<size_t>(words) * planes, 0);
+    std::vector<uint64_t> gap(static_cast<size_t>(words) * planes, 0);
+    if (bounds.empty()) {
+        return gap;
+    }
+
+    forEachObservation(model, bounds, solution, [&](int now, const uint64_t* seen) {
+        for (int w = 0; w < words; ++w) {
+            if (seen[w] != 0) {
+                observe(last.data() + static_cast<size_t>(w) * planes, gap.data() + static_cast<size_t>(w) * planes,
+                    planes, now, seen[w]);
+            }
+        }
+    });
+
+    // 时域末尾：最后一次观测到时域结束的间隔
+    for (int w = 0; w < words; ++w) {
+        observe(last.data() + static_cast<size_t>(w) * planes, gap.data() + static_cast<size_t>(w) * planes,
+            planes, span, laneMask(model.q(), w));
+    }
+    return gap;
+}
+
+int PointRevisitGap::worst(const UniqueCoverage& model, const std::vector<int>& bounds,
+    const std::vector<std::vector<int>>& solution) {
+
+    if (bounds.empty()) {
+        return 0;
+    }
+
+    // 只求全局最大值：不保存逐点的最长间隔，只保存上次观测时间的位平面和一个标量最大值
+    // floor[w] 不大于字 w 中所有网格点的上次观测时间，now - floor[w] 不超过当前最大值时该字不会产生更长的间隔
+    int words = model.words();
+    int span = bounds.back() - bounds.front();
+    int planes = planesFor(span);
+    std::vector<uint64_t> last(static_cast<size_t>(words) * planes, 0);
+    std::vector<int> floor(words, 0);
+    int result = 0;
+
+    uint64_t now_bits[kMaxPlanes];
+    forEachObservation(model, bounds, solution, [&](int now, const uint64_t* seen) {
+        for (int b = 0; b < planes; ++b) {
+            now_bits[b] = (now >> b & 1) ? ~0ULL : 0ULL;
+        }
+
+        for (int w = 0; w < words; ++w) {
+            uint64_t mask = seen[w];
+            if (mask == 0) continue;
+            uint64_t* l = last.data() + static_cast<size_t>(w) * planes;
+
+            if (now - floor[w] > result) {
+                result = std::max(result, now - minimumLast(l, planes, mask));
+                floor[w] = std::min(minimumLast(l, planes, ~mask & laneMask(model.q(), w)), now);
+            }
+
+            // 被观测的网格点 last = now：now 对所有网格点相同，按预先展开的 now_bits 逐平面替换
+            for (int b = 0; b < planes; ++b) {
+                l[b] ^= (l[b] ^ now_bits[b]) & mask;
+            }
+        }
+    });
+
+    for (int w = 0; w < words; ++w) {
+        const uint64_t* l = last.data() + static_cast<size_t>(w) * planes;
+        result = std::max(result, span - minimumLast(l, planes, laneMask(model.q(), w)));
+    }
+    return result;
+}
+
+std::vector<int> PointRevisitGap::pointGaps(const UniqueCoverage& model, const std::vector<int>& bounds,
+    const std::vector<std::vector<int>>& solution) {
+
+    int planes = 0;
+    auto gap = scan(model, bounds, solution, planes);
+
+    std::vector<int> gaps(model.q(), 0);
+    for (int i = 0; i < model.q(); ++i) {
+        const uint64_t* g = gap.data() + static_cast<size_t>(i >> 6) * planes;
+        int value = 0;
+        for (int b = 0; b < planes; ++b) {
+            value |= static_cast<int>(g[b] >> (i & 63) & 1ULL) << b;
+        }
+        gaps[i] = value;
+    }
+    return gaps;
+}
+
+PointRevisitGap::Summary PointRevisitGap::summarize(const std::vector<int>& gaps) {
+    Summary summary;
+    if (gaps.empty()) {
+        return summary;
+    }
+
+    std::vector<int> sorted = gaps;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) {
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[index];
+    };
+
+    double sum = 0.0;
+    for (int g : gaps) {
+        sum += g;
+    }
+    summary.worst = sorted.back();
+    summary.mean = sum / gaps.size();
+    summary.p50 = percentile(0.5);
+    summary.p90 = percentile(0.9);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+void PointRevisitGap::report(const UniqueCoverage& model, const std::vector<int>& bounds,
+    const std::vector<std::vector<std::vector<int>>>& front, std::ostream& out) {
+
+    out << "网格点重访间隔（原始时间点，共 " << model.q() << " 个网格点）:" << std::endl;
+    out << std::left << std::setw(8) << "解" << std::right << std::setw(8) << "最长" << std::setw(10) << "平均"
+        << std::setw(8) << "P50" << std::setw(8) << "P90" << std::setw(8) << "P99"
+        << std::setw(12) << "从未观测" << std::endl;
+    for (size_t i = 0; i < front.size(); ++i) {
+        Summary s = summarize(pointGaps(model, bounds, front[i]));
+        s.unobserved = model.q() - model.covered(front[i]);
+        out << std::left << std::setw(8) << i + 1 << std::right << std::setw(8) << s.worst
+            << std::setw(10) << std::fixed << std::setprecision(1) << s.mean << std::defaultfloat
+            << std::setw(8) << s.p50 << std::setw(8) << s.p90 << std::setw(8) << s.p99
+            << std::setw(12) << s.unobserved << std::endl;
+    }
+}
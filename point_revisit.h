@@ -0,0 +1,39 @@
+#pragma once
+// point_revisit.h
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include "unique_coverage.h"
+
+// 逐网格点的最长重访间隔：按压缩列的时间顺序（bounds 的原始时间点）扫描方案，
+// 每个网格点记录上次被观测的时间和迄今最长的未观测间隔；时域首尾计入，从未被观测的点取整个时域长度
+// 两个量都按位切片存放：每 64 个网格点一字、每字 planes 个平面，一次位运算同时更新 64 个网格点，
+// 每列只处理该列开机网格并集非零的字
+class PointRevisitGap {
+public:
+    // 所有网格点中最长的未观测间隔（原始时间点）
+    static int worst(const UniqueCoverage& model, const std::vector<int>& bounds,
+        const std::vector<std::vector<int>>& solution);
+    // 每个网格点的最长未观测间隔（q 项）
+    static std::vector<int> pointGaps(const UniqueCoverage& model, const std::vector<int>& bounds,
+        const std::vector<std::vector<int>>& solution);
+
+    struct Summary {
+        int worst = 0;
+        double mean = 0.0;
+        int p50 = 0;
+        int p90 = 0;
+        int p99 = 0;
+        int unobserved = 0;     // 整个时域都未被观测的网格点数（由 report 按并集网格填写）
+    };
+    static Summary summarize(const std::vector<int>& gaps);
+
+    // 前沿上每个解一行的汇总表
+    static void report(const UniqueCoverage& model, const std::vector<int>& bounds,
+        const std::vector<std::vector<std::vector<int>>>& front, std::ostream& out);
+
+private:
+    // 扫描方案，返回 [字][平面] 的最长间隔位平面；planes 为平面数
+    static std::vector<uint64_t> scan(const UniqueCoverage& model, const std::vector<int>& bounds,
+        const std::vector<std::vector<int>>& solution, int& planes);
+};
@@ -1,208 +1,441 @@
-// satellite_data_loader.cpp
-#include "satellite_data_loader.h"
-#include <iostream>
-#include <regex>
-#include <stdexcept>
-#include "csv_parser.h"
-
-SatelliteDataLoader::SatelliteDataLoader() {
-    // ʼھ
-    window_.resize(num_satellites_, std::vector<int>(total_minutes_, -1));
-    idx_.resize(num_satellites_);
-}
-
-int SatelliteDataLoader::parseTimeToMinutes(const std::string& timeStr) {
-    auto timePoint = safeParseTime(timeStr);
-    return timePoint.toMinutesSince8AM();
-}
-
-SatelliteDataLoader::TimePoint SatelliteDataLoader::safeParseTime(const std::string& timeStr) {
-    if (timeStr.empty() || timeStr == "NaN" || timeStr == "nan") {
-        return TimePoint(-1, -1, -1); // Чʱ
-    }
-
-    try {
-        // µCSVʽ"1 May 2025,08:23:00.000,6.57,6.57"
-        // Ҫȡʱ䲿 "08:23:00.000"
-
-        // ŷַָ
-        std::vector<std::string> parts;
-        std::stringstream ss(timeStr);
-        std::string part;
-
-        while (std::getline(ss, part, ',')) {
-            parts.push_back(part);
-        }
-
-        /*// Ƿ㹻Ĳ
-        if (parts.size() < 2) {
-            std::cerr << "ʱʽֶβ: " << timeStr << std::endl;
-            return TimePoint(-1, -1, -1);
-        }*/
-
-        // ڶӦʱ "08:23:00.000"
-        std::string timePart = parts[0];
-
-        // ܵĺʽ
-        std::string cleanTimeStr = timePart;
-        size_t dotPos = timePart.find('.');
-        if (dotPos != std::string::npos) {
-            cleanTimeStr = timePart.substr(0, dotPos);
-        }
-
-        // ʽƥʱʽ HH:MM:SS
-        std::regex pattern(R"((\d{1,2}):(\d{2}):(\d{2}))");
-        std::smatch matches;
-
-        if (std::regex_match(cleanTimeStr, matches, pattern)) {
-            int hour = std::stoi(matches[1]);
-            int minute = std::stoi(matches[2]);
-            int second = std::stoi(matches[3]);
-
-            return TimePoint(hour, minute, second);
-        }
-        else {
-            std::cerr << "޷ʱʽ: " << cleanTimeStr << std::endl;
-        }
-
-    }
-    catch (const std::exception& e) {
-        std::cerr << "ʱ: " << timeStr << " - " << e.what() << std::endl;
-    }
-
-    return TimePoint(-1, -1, -1); // ʧ
-}
-
-bool SatelliteDataLoader::loadDataFromExcel(const std::string& excelPath) {
-    std::cout << "ʼ..." << std::endl;
-
-    for (int i = 1; i <= 10; ++i) {
-        std::string filename = "satellite_" + std::to_string(i) + ".csv";
-
-        try {
-            auto csv_data = CSVParser::parseCSV(filename);
-
-            // УУ
-            size_t start_row = 0;
-
-            std::vector<double> coverage_values;
-            std::vector<int> time_indices;
-            int satellite_index = i - 1;
-
-            for (size_t row = start_row; row < csv_data.size(); ++row) {
-                const auto& fields = csv_data[row];
-
-                if (fields.size() >= 3) {
-                    // ȡʱ䲿֣ڶֶΣ
-                    std::string time_str = fields[1];
-
-                    // ʱ
-                    int minutes = parseTimeToMinutes(time_str);
-                    if (minutes >= 0) {
-                        time_indices.push_back(minutes);
-                    }
-
-                    // ȡʣֶΣ
-                    std::string coverage_str = fields[2];
-                    try {
-                        double coverage = std::stod(coverage_str);
-                        coverage_values.push_back(coverage);
-                    }
-                    catch (const std::exception& e) {
-                        std::cerr << "ʽ: " << coverage_str << " - " << e.what() << std::endl;
-                    }
-                }
-            }
-
-            // 洢
-            idx_[satellite_index] = time_indices;
-            coverage_data_[satellite_index] = coverage_values;
-
-            // 䴰ھ
-            for (int time_index : time_indices) {
-                if (time_index >= 0 && time_index < total_minutes_) {
-                    window_[satellite_index][time_index] = 1;
-                }
-            }
-
-            std::cout << " " << i << " ݼɣʱ: " << time_indices.size()
-                << ", : " << coverage_values.size() << std::endl;
-
-        }
-        catch (const std::exception& e) {
-            std::cerr << "ļ " << filename << " : " << e.what() << std::endl;
-            continue;
-        }
-    }
-
-    // ѹʱ䴰
-    compressTimeWindows();
-
-    std::cout << "ݼ" << std::endl;
-    return true;
-}
-
-void SatelliteDataLoader::compressTimeWindows() {
-    std::cout << "ʼѹʱ䴰..." << std::endl;
-
-    // ҵΪ-1
-    std::vector<bool> all_minus_one_columns(total_minutes_, true);
-
-    for (int col = 0; col < total_minutes_; ++col) {
-        for (int row = 0; row < num_satellites_; ++row) {
-            if (window_[row][col] != -1) {
-                all_minus_one_columns[col] = false;
-                break;
-            }
-        }
-    }
-
-    // ռȫ-1е
-    for (int col = 0; col < total_minutes_; ++col) {
-        if (!all_minus_one_columns[col]) {
-            bounds_.push_back(col);
-        }
-    }
-
-    // ѹ
-    compressed_.resize(num_satellites_);
-    for (int row = 0; row < num_satellites_; ++row) {
-        compressed_[row].reserve(bounds_.size());
-        for (int bound : bounds_) {
-            compressed_[row].push_back(window_[row][bound]);
-        }
-    }
-
-    std::cout << "ʱ䴰ѹɣԭʼ: " << total_minutes_
-        << ", ѹ: " << bounds_.size() << std::endl;
-}
-
-void SatelliteDataLoader::saveCompressedData(const std::string& filename) {
-    std::ofstream file(filename);
-
-    if (!file.is_open()) {
-        std::cerr << "޷ļ: " << filename << std::endl;
-        return;
-    }
-
-    // bounds
-    file << "# bounds\n";
-    for (size_t i = 0; i < bounds_.size(); ++i) {
-        file << bounds_[i];
-        if (i < bounds_.size() - 1) file << ",";
-    }
-    file << "\n";
-
-    // compressed
-    file << "# compressed\n";
-    for (const auto& sat_schedule : compressed_) {
-        for (size_t i = 0; i < sat_schedule.size(); ++i) {
-            file << sat_schedule[i];
-            if (i < sat_schedule.size() - 1) file << ",";
-        }
-        file << "\n";
-    }
-
-    file.close();
-    std::cout << "ѹѱ浽: " << filename << std::endl;
+// satellite_data_loader.cpp
+#include "satellite_data_loader.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <regex>
+#include <stdexcept>
+#include <filesystem>
+#include "csv_parser.h"
+
+SatelliteDataLoader::SatelliteDataLoader() {
+    // 初始化窗口矩阵
+    window_.resize(num_satellites_, std::vector<int>(total_minutes_, -1));
+    idx_.resize(num_satellites_);
+}
+
+void SatelliteDataLoader::setSatelliteCount(int num_satellites) {
+    num_satellites_ = num_satellites;
+    window_.assign(num_satellites_, std::vector<int>(total_minutes_, -1));
+    idx_.assign(num_satellites_, {});
+}
+
+void SatelliteDataLoader::setObservationWindow(int start_hour, int start_minute, int start_second,
+    int end_hour, int end_minute, int end_second) {
+    start_minutes_ = TimePoint(start_hour, start_minute, start_second).toMinutes();
+    total_minutes_ = TimePoint(end_hour, end_minute, end_second).toMinutes() - start_minutes_ + 1;
+    window_.assign(num_satellites_, std::vector<int>(total_minutes_, -1));
+}
+
+int SatelliteDataLoader::parseTimeToMinutes(const std::string& timeStr) {
+    auto timePoint = safeParseTime(timeStr);
+    if (timePoint.hour < 0) {
+        return -1;
+    }
+    return timePoint.toMinutes() - start_minutes_;
+}
+
+SatelliteDataLoader::TimePoint SatelliteDataLoader::safeParseTime(const std::string& timeStr) {
+    if (timeStr.empty() || timeStr == "NaN" || timeStr == "nan") {
+        return TimePoint(-1, -1, -1); // 无效时间标记
+    }
+
+    try {
+        // 新的CSV格式："1 May 2025,08:23:00.000,6.57,6.57"
+        // 我们需要提取时间部分 "08:23:00.000"
+
+        // 按逗号分割字符串
+        std::vector<std::string> parts;
+        std::stringstream ss(timeStr);
+        std::string part;
+
+        while (std::getline(ss, part, ',')) {
+            parts.push_back(part);
+        }
+
+        /*// 检查是否有足够的部分
+        if (parts.size() < 2) {
+            std::cerr << "时间格式错误，字段不足: " << timeStr << std::endl;
+            return TimePoint(-1, -1, -1);
+        }*/
+
+        // 第二个部分应该是时间 "08:23:00.000"
+        std::string timePart = parts[0];
+
+        // 处理可能的毫秒格式
+        std::string cleanTimeStr = timePart;
+        size_t dotPos = timePart.find('.');
+        if (dotPos != std::string::npos) {
+            cleanTimeStr = timePart.substr(0, dotPos);
+        }
+
+        // 正则表达式匹配时间格式 HH:MM:SS
+        std::regex pattern(R"((\d{1,2}):(\d{2}):(\d{2}))");
+        std::smatch matches;
+
+        if (std::regex_match(cleanTimeStr, matches, pattern)) {
+            int hour = std::stoi(matches[1]);
+            int minute = std::stoi(matches[2]);
+            int second = std::stoi(matches[3]);
+
+            return TimePoint(hour, minute, second);
+        }
+        else {
+            std::cerr << "无法解析时间格式: " << cleanTimeStr << std::endl;
+        }
+
+    }
+    catch (const std::exception& e) {
+        std::cerr << "时间解析错误: " << timeStr << " - " << e.what() << std::endl;
+    }
+
+    return TimePoint(-1, -1, -1); // 解析失败
+}
+
+bool SatelliteDataLoader::loadDataFromExcel(const std::string& excelPath) {
+    std::cout << "开始加载卫星数据..." << std::endl;
+
+    // 重复加载时从空状态开始
+    window_.assign(num_satellites_, std::vector<int>(total_minutes_, -1));
+    idx_.assign(num_satellites_, {});
+    coverage_data_.clear();
+    bounds_.clear();
+    compressed_.clear();
+
+    std::error_code ec;
+    bool from_directory = !excelPath.empty() && std::filesystem::is_directory(excelPath, ec);
+
+    for (int i = 1; i <= num_satellites_; ++i) {
+        std::string filename = "satellite_" + std::to_string(i) + ".csv";
+        if (from_directory) {
+            filename = (std::filesystem::path(excelPath) / filename).string();
+        }
+
+        try {
+            auto csv_data = CSVParser::parseCSV(filename);
+
+            // 跳过标题行（如果有）
+            size_t start_row = 0;
+
+            std::vector<double> coverage_values;
+            std::vector<int> time_indices;
+            int satellite_index = i - 1;
+
+            for (size_t row = start_row; row < csv_data.size(); ++row) {
+                const auto& fields = csv_data[row];
+
+                if (fields.size() >= 3) {
+                    // 提取时间部分（第二个字段）
+                    std::string time_str = fields[1];
+
+                    // 解析时间
+                    int minutes = parseTimeToMinutes(time_str);
+                    if (minutes >= 0) {
+                        time_indices.push_back(minutes);
+                    }
+
+                    // 提取覆盖率（第三个字段）
+                    std::string coverage_str = fields[2];
+                    try {
+                        double coverage = std::stod(coverage_str);
+                        coverage_values.push_back(coverage);
+                    }
+                    catch (const std::exception& e) {
+                        std::cerr << "覆盖率解析错误: " << coverage_str << " - " << e.what() << std::endl;
+                    }
+                }
+            }
+
+            // 存储数据
+            idx_[satellite_index] = time_indices;
+            coverage_data_[satellite_index] = coverage_values;
+
+            // 填充窗口矩阵
+            for (int time_index : time_indices) {
+                if (time_index >= 0 && time_index < total_minutes_) {
+                    window_[satellite_index][time_index] = 1;
+                }
+            }
+
+            std::cout << "卫星 " << i << " 数据加载完成，时间点数量: " << time_indices.size()
+                << ", 覆盖率数据数量: " << coverage_values.size() << std::endl;
+
+        }
+        catch (const std::exception& e) {
+            std::cerr << "加载文件 " << filename << " 错误: " << e.what() << std::endl;
+            continue;
+        }
+    }
+
+    // 压缩时间窗口
+    compressTimeWindows();
+
+    std::cout << "所有卫星数据加载完成" << std::endl;
+    return true;
+}
+
+void SatelliteDataLoader::compressTimeWindows() {
+    std::cout << "开始压缩时间窗口..." << std::endl;
+
+    // 找到所有为-1的列
+    std::vector<bool> all_minus_one_columns(total_minutes_, true);
+
+    for (int col = 0; col < total_minutes_; ++col) {
+        for (int row = 0; row < num_satellites_; ++row) {
+            if (window_[row][col] != -1) {
+                all_minus_one_columns[col] = false;
+                break;
+            }
+        }
+    }
+
+    // 收集非全-1列的索引
+    for (int col = 0; col < total_minutes_; ++col) {
+        if (!all_minus_one_columns[col]) {
+            bounds_.push_back(col);
+        }
+    }
+
+    // 创建压缩矩阵
+    compressed_.resize(num_satellites_);
+    for (int row = 0; row < num_satellites_; ++row) {
+        compressed_[row].reserve(bounds_.size());
+        for (int bound : bounds_) {
+            compressed_[row].push_back(window_[row][bound]);
+        }
+    }
+
+    std::cout << "时间窗口压缩完成，原始列数: " << total_minutes_
+        << ", 压缩后列数: " << bounds_.size() << std::endl;
+}
+
+bool SatelliteDataLoader::ColumnRemap::columnsChanged() const {
+    if (new_cols != static_cast<int>(old_to_new.size())) {
+        return true;
+    }
+    for (size_t k = 0; k < old_to_new.size(); ++k) {
+        if (old_to_new[k] != static_cast<int>(k)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<std::vector<int>> SatelliteDataLoader::ColumnRemap::apply(
+    const std::vector<std::vector<int>>& solution, const std::vector<std::vector<int>>& compressed, int fill) const {
+
+    std::vector<std::vector<int>> migrated(compressed.size());
+    for (size_t sat = 0; sat < compressed.size(); ++sat) {
+        auto& row = migrated[sat];
+        row.assign(new_cols, -1);
+        for (int j = 0; j < new_cols; ++j) {
+            if (compressed[sat][j] != -1) {
+                row[j] = fill;
+            }
+        }
+        if (sat >= solution.size()) continue;
+
+        for (size_t k = 0; k < old_to_new.size() && k < solution[sat].size(); ++k) {
+            int j = old_to_new[k];
+            if (j >= 0 && row[j] != -1 && solution[sat][k] != -1) {
+                row[j] = solution[sat][k];
+            }
+        }
+    }
+    return migrated;
+}
+
+SatelliteDataLoader::ColumnRemap SatelliteDataLoader::ingestPass(int satellite, int first_minute, int last_minute,
+    const std::vector<PassSample>& samples) {
+
+    if (satellite < 0 || satellite >= num_satellites_) {
+        throw std::out_of_range("卫星编号超出范围: " + std::to_string(satellite));
+    }
+
+    for (const auto& sample : samples) {
+        first_minute = std::min(first_minute, sample.minute);
+        last_minute = std::max(last_minute, sample.minute);
+    }
+    first_minute = std::max(first_minute, 0);
+    last_minute = std::min(last_minute, total_minutes_ - 1);
+
+    ColumnRemap remap;
+    int old_cols = static_cast<int>(bounds_.size());
+    remap.old_to_new.resize(old_cols);
+    for (int k = 0; k < old_cols; ++k) {
+        remap.old_to_new[k] = k;
+    }
+    remap.new_cols = old_cols;
+    if (first_minute > last_minute) {
+        return remap;
+    }
+
+    // 区间内该卫星原有的覆盖率（NaN 表示无记录），用于判断哪些列发生了变化
+    int span = last_minute - first_minute + 1;
+    std::vector<double> old_coverage(span, std::numeric_limits<double>::quiet_NaN());
+    std::vector<double> new_coverage(span, std::numeric_limits<double>::quiet_NaN());
+
+    // 时间索引与覆盖率按时间升序平行存放：删去区间内的记录，再在相应位置插入新记录
+    auto& times = idx_[satellite];
+    auto& coverage = coverage_data_[satellite];
+    coverage.resize(times.size(), 0.0);
+    auto begin = std::lower_bound(times.begin(), times.end(), first_minute) - times.begin();
+    auto end = std::upper_bound(times.begin(), times.end(), last_minute) - times.begin();
+    for (auto i = begin; i < end; ++i) {
+        old_coverage[times[i] - first_minute] = coverage[i];
+    }
+
+    std::vector<PassSample> sorted = samples;
+    std::sort(sorted.begin(), sorted.end(),
+        [](const PassSample& a, const PassSample& b) { return a.minute < b.minute; });
+    std::vector<int> new_times;
+    std::vector<double> new_values;
+    for (const auto& sample : sorted) {
+        if (sample.minute < 0 || sample.minute >= total_minutes_) continue;
+        if (!new_times.empty() && new_times.back() == sample.minute) {
+            new_values.back() = sample.coverage;    // 同一时间点重复出现时以后者为准
+            continue;
+        }
+        new_times.push_back(sample.minute);
+        new_values.push_back(sample.coverage);
+    }
+    for (size_t i = 0; i < new_times.size(); ++i) {
+        new_coverage[new_times[i] - first_minute] = new_values[i];
+    }
+
+    times.erase(times.begin() + begin, times.begin() + end);
+    times.insert(times.begin() + begin, new_times.begin(), new_times.end());
+    coverage.erase(coverage.begin() + begin, coverage.begin() + end);
+    coverage.insert(coverage.begin() + begin, new_values.begin(), new_values.end());
+
+    for (int m = first_minute; m <= last_minute; ++m) {
+        window_[satellite][m] = std::isnan(new_coverage[m - first_minute]) ? -1 : 1;
+    }
+
+    // 区间内重新判定哪些原始时间点构成压缩列
+    auto range_begin = std::lower_bound(bounds_.begin(), bounds_.end(), first_minute) - bounds_.begin();
+    auto range_end = std::upper_bound(bounds_.begin(), bounds_.end(), last_minute) - bounds_.begin();
+    std::vector<int> range_bounds;
+    for (int m = first_minute; m <= last_minute; ++m) {
+        for (int row = 0; row < num_satellites_; ++row) {
+            if (window_[row][m] != -1) {
+                range_bounds.push_back(m);
+                break;
+            }
+        }
+    }
+
+    auto differs = [&](int m) {
+        double a = old_coverage[m - first_minute];
+        double b = new_coverage[m - first_minute];
+        return std::isnan(a) != std::isnan(b) || (!std::isnan(a) && a != b);
+    };
+
+    bool same_columns = static_cast<int>(range_bounds.size()) == range_end - range_begin &&
+        std::equal(range_bounds.begin(), range_bounds.end(), bounds_.begin() + range_begin);
+
+    if (same_columns) {
+        // 列集合不变：只改写该卫星在区间内的窗口
+        for (auto j = range_begin; j < range_end; ++j) {
+            if (differs(bounds_[j])) {
+                compressed_[satellite][j] = window_[satellite][bounds_[j]];
+                remap.changed.push_back(static_cast<int>(j));
+            }
+        }
+    }
+    else {
+        int delta = static_cast<int>(range_bounds.size()) - static_cast<int>(range_end - range_begin);
+        for (auto k = range_begin; k < range_end; ++k) {
+            auto it = std::lower_bound(range_bounds.begin(), range_bounds.end(), bounds_[k]);
+            remap.old_to_new[k] = it != range_bounds.end() && *it == bounds_[k] ?
+                static_cast<int>(range_begin + (it - range_bounds.begin())) : -1;
+        }
+        for (int k = static_cast<int>(range_end); k < old_cols; ++k) {
+            remap.old_to_new[k] = k + delta;
+        }
+
+        for (int row = 0; row < num_satellites_; ++row) {
+            std::vector<int> values;
+            values.reserve(range_bounds.size());
+            for (int m : range_bounds) {
+                values.push_back(window_[row][m]);
+            }
+            auto& line = compressed_[row];
+            line.erase(line.begin() + range_begin, line.begin() + range_end);
+            line.insert(line.begin() + range_begin, values.begin(), values.end());
+        }
+        bounds_.erase(bounds_.begin() + range_begin, bounds_.begin() + range_end);
+        bounds_.insert(bounds_.begin() + range_begin, range_bounds.begin(), range_bounds.end());
+        remap.new_cols = static_cast<int>(bounds_.size());
+
+        std::vector<bool> kept(range_bounds.size(), false);
+        for (auto k = range_begin; k < range_end; ++k) {
+            if (remap.old_to_new[k] >= 0) {
+                kept[remap.old_to_new[k] - range_begin] = true;
+            }
+        }
+        for (size_t i = 0; i < range_bounds.size(); ++i) {
+            if (!kept[i] || differs(range_bounds[i])) {
+                remap.changed.push_back(static_cast<int>(range_begin + i));
+            }
+        }
+    }
+
+    std::cout << "增量更新卫星 " << satellite + 1 << ": 区间 [" << first_minute << ", " << last_minute
+        << "], " << new_times.size() << " 条记录, 变化列 " << remap.changed.size()
+        << ", 压缩列数 " << old_cols << " -> " << remap.new_cols << std::endl;
+    return remap;
+}
+
+std::vector<SatelliteDataLoader::PassSample> SatelliteDataLoader::readPassSamples(std::istream& in) {
+    std::vector<PassSample> samples;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        auto fields = CSVParser::parseCSVLine(line);
+        if (fields.size() < 3) continue;
+
+        // 与 satellite_<i>.csv 相同：第二个字段为时间，第三个字段为覆盖率
+        int minutes = parseTimeToMinutes(fields[1]);
+        if (minutes < 0) continue;
+        try {
+            samples.push_back({ minutes, std::stod(fields[2]) });
+        }
+        catch (const std::exception& e) {
+            std::cerr << "覆盖率解析错误: " << fields[2] << " - " << e.what() << std::endl;
+        }
+    }
+    return samples;
+}
+
+void SatelliteDataLoader::saveCompressedData(const std::string& filename) {
+    std::ofstream file(filename);
+
+    if (!file.is_open()) {
+        std::cerr << "无法创建文件: " << filename << std::endl;
+        return;
+    }
+
+    // 保存bounds数据
+    file << "# bounds\n";
+    for (size_t i = 0; i < bounds_.size(); ++i) {
+        file << bounds_[i];
+        if (i < bounds_.size() - 1) file << ",";
+    }
+    file << "\n";
+
+    // 保存compressed数据
+    file << "# compressed\n";
+    for (const auto& sat_schedule : compressed_) {
+        for (size_t i = 0; i < sat_schedule.size(); ++i) {
+            file << sat_schedule[i];
+            if (i < sat_schedule.size() - 1) file << ",";
+        }
+        file << "\n";
+    }
+
+    file.close();
+    std::cout << "压缩数据已保存到: " << filename << std::endl;
 }
\ No newline at end of file
@@ -1,52 +1,89 @@
-#pragma once
-// satellite_data_loader.h
-#pragma once
-#include <vector>
-#include <string>
-#include <map>
-#include <chrono>
-#include <fstream>
-#include <sstream>
-#include <iomanip>
-#include <algorithm>
-
-class SatelliteDataLoader {
-private:
-    struct TimePoint {
-        int hour;
-        int minute;
-        int second;
-
-        TimePoint(int h = 0, int m = 0, int s = 0) : hour(h), minute(m), second(s) {}
-
-        int toMinutesSince8AM() const {
-            return (hour - 8) * 60 + minute + second / 60;
-        }
-    };
-
-public:
-    SatelliteDataLoader();
-    bool loadDataFromExcel(const std::string& excelPath);
-    void saveCompressedData(const std::string& filename = "compressed_example_3.0.txt");
-
-    const std::vector<std::vector<int>>& getWindowMatrix() const { return window_; }
-    const std::vector<std::vector<int>>& getCompressedMatrix() const { return compressed_; }
-    const std::vector<int>& getBounds() const { return bounds_; }
-    const std::map<int, std::vector<double>>& getCoverageData() const { return coverage_data_; }
-    const std::vector<std::vector<int>>& getTimeIndices() const { return idx_; }
-
-private:
-    TimePoint safeParseTime(const std::string& timeStr);
-    int parseTimeToMinutes(const std::string& timeStr);
-    void compressTimeWindows();
-
-    // ݳԱ
-    std::vector<std::vector<int>> window_;           // ʱ䴰ھ
-    std::vector<std::vector<int>> compressed_;       // ѹľ
-    std::vector<int> bounds_;                        // ԭʼʱ
-    std::map<int, std::vector<double>> coverage_data_; // 
-    std::vector<std::vector<int>> idx_;              // ʱ
-
-    const int num_satellites_ = 10;
-    const int total_minutes_ = 721; // 12*60 + 1
+#pragma once
+// satellite_data_loader.h
+#pragma once
+#include <vector>
+#include <string>
+#include <map>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+class SatelliteDataLoader {
+private:
+    struct TimePoint {
+        int hour;
+        int minute;
+        int second;
+
+        TimePoint(int h = 0, int m = 0, int s = 0) : hour(h), minute(m), second(s) {}
+
+        int toMinutes() const {
+            return hour * 60 + minute + second / 60;
+        }
+    };
+
+public:
+    SatelliteDataLoader();
+    // excelPath 为目录时从该目录读取 satellite_<i>.csv，否则从当前目录读取
+    bool loadDataFromExcel(const std::string& excelPath);
+    void saveCompressedData(const std::string& filename = "compressed_example_3.0.txt");
+
+    const std::vector<std::vector<int>>& getWindowMatrix() const { return window_; }
+    const std::vector<std::vector<int>>& getCompressedMatrix() const { return compressed_; }
+    const std::vector<int>& getBounds() const { return bounds_; }
+    const std::map<int, std::vector<double>>& getCoverageData() const { return coverage_data_; }
+    const std::vector<std::vector<int>>& getTimeIndices() const { return idx_; }
+
+    // 观测参数（需在加载数据前设置）：卫星总数、观测起止时间
+    void setSatelliteCount(int num_satellites);
+    void setObservationWindow(int start_hour, int start_minute, int start_second,
+        int end_hour, int end_minute, int end_second);
+    int getTotalMinutes() const { return total_minutes_; }
+    // 观测开始时间（当天分钟数），原始时间点均相对于它
+    int getStartMinutes() const { return start_minutes_; }
+
+    // 一条过境记录：相对观测开始的分钟数与该时刻的覆盖率
+    struct PassSample {
+        int minute;
+        double coverage;
+    };
+
+    // 增量更新前后压缩列的对应关系
+    struct ColumnRemap {
+        std::vector<int> old_to_new;    // 旧压缩列 -> 新压缩列，被删除的列为 -1
+        std::vector<int> changed;       // 窗口或覆盖率有变化的新压缩列（升序，含新增列）
+        int new_cols = 0;
+
+        // 是否有列被插入或删除
+        bool columnsChanged() const;
+        // 把旧时间轴上的解迁移到新压缩列：保留列照搬取值，新变为可见的单元取 fill，不可见单元为 -1
+        std::vector<std::vector<int>> apply(const std::vector<std::vector<int>>& solution,
+            const std::vector<std::vector<int>>& compressed, int fill = 0) const;
+    };
+
+    // 增量接入卫星 satellite（0-based）在 [first_minute, last_minute] 内的过境记录：
+    // 区间内原有记录整体替换为 samples（区间自动扩展到包含全部 samples），新过境区间原本为空，samples 为空即撤销该过境
+    // 只重算区间内的列；列集合不变时原地更新，否则每行只做一次拼接
+    ColumnRemap ingestPass(int satellite, int first_minute, int last_minute, const std::vector<PassSample>& samples);
+
+    // 从流中读取与 satellite_<i>.csv 格式相同的过境记录（管道或持续追加的文件），跳过无法解析的行
+    std::vector<PassSample> readPassSamples(std::istream& in);
+
+private:
+    TimePoint safeParseTime(const std::string& timeStr);
+    int parseTimeToMinutes(const std::string& timeStr);
+    void compressTimeWindows();
+
+    // 数据成员
+    std::vector<std::vector<int>> window_;           // 时间窗口矩阵
+    std::vector<std::vector<int>> compressed_;       // 压缩后的矩阵
+    std::vector<int> bounds_;                        // 原始时间索引
+    std::map<int, std::vector<double>> coverage_data_; // 覆盖率数据
+    std::vector<std::vector<int>> idx_;              // 时间索引
+
+    int num_satellites_ = 10;
+    int total_minutes_ = 721;       // 12*60 + 1
+    int start_minutes_ = 8 * 60;    // 观测开始时间（当天分钟数）
 };
\ No newline at end of file
@@ -1,101 +1,139 @@
-// satellite_scheduler_base.cpp
-#include "satellite_scheduler_base.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
-#include <algorithm>
-
-SatelliteSchedulerBase::SatelliteSchedulerBase() : gen_(rd_()) {
-    // 캯ʼ
-}
-
-bool SatelliteSchedulerBase::loadCompressedData(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "޷ѹļ: " << filename << std::endl;
-        return false;
-    }
-
-    std::vector<std::string> lines;
-    std::string line;
-
-    while (std::getline(file, line)) {
-        if (!line.empty() && line[0] != '#') { // кע
-            lines.push_back(line);
-        }
-    }
-    file.close();
-
-    if (lines.size() < 2) {
-        std::cerr << "ѹļʽ" << std::endl;
-        return false;
-    }
-
-    // һboundscompressed
-    std::string bounds_line = lines[0];
-    std::vector<std::string> compressed_lines(lines.begin() + 1, lines.end());
-
-    bounds_ = parseBoundsData(bounds_line);
-    compressed_ = parseCompressedData(compressed_lines);
-    m_ = compressed_.size();
-
-    std::cout << "ѹ: " << m_ << " , "
-        << (compressed_.empty() ? 0 : compressed_[0].size()) << " ʱ䴰" << std::endl;
-
-    return true;
-}
-
-void SatelliteSchedulerBase::initializeCoverageLoader() {
-    coverage_loader_ = std::make_unique<CoverageDataLoader>();
-
-    // Ԥʱ
-    std::vector<int> satellites = { 2, 4, 5 }; // Ǳ
-    coverage_loader_->preloadAllData(satellites, special_times_);
-
-    std::cout << "ʼʼ" << std::endl;
-}
-
-std::vector<int> SatelliteSchedulerBase::parseBoundsData(const std::string& bounds_line) {
-    std::vector<int> bounds;
-    std::stringstream ss(bounds_line);
-    std::string token;
-
-    while (std::getline(ss, token, ',')) {
-        try {
-            bounds.push_back(std::stoi(token));
-        }
-        catch (const std::exception& e) {
-            std::cerr << "boundsݴ: " << token << " - " << e.what() << std::endl;
-        }
-    }
-
-    return bounds;
-}
-
-std::vector<std::vector<int>> SatelliteSchedulerBase::parseCompressedData(
-    const std::vector<std::string>& lines) {
-
-    std::vector<std::vector<int>> compressed;
-
-    for (const auto& line : lines) {
-        std::vector<int> satellite_schedule;
-        std::stringstream ss(line);
-        std::string token;
-
-        while (std::getline(ss, token, ',')) {
-            try {
-                satellite_schedule.push_back(std::stoi(token));
-            }
-            catch (const std::exception& e) {
-                std::cerr << "ѹݴ: " << token << " - " << e.what() << std::endl;
-                satellite_schedule.push_back(-1); // ʱΪЧֵ
-            }
-        }
-
-        if (!satellite_schedule.empty()) {
-            compressed.push_back(satellite_schedule);
-        }
-    }
-
-    return compressed;
+// satellite_scheduler_base.cpp
+#include "satellite_scheduler_base.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+SatelliteSchedulerBase::SatelliteSchedulerBase() : problem_(SchedulingProblem::empty()),
+    gen_((static_cast<uint64_t>(rd_()) << 32) | rd_()) {
+    // 构造函数初始化
+}
+
+bool SatelliteSchedulerBase::loadCompressedData(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "无法打开压缩数据文件: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+
+    while (std::getline(file, line)) {
+        if (!line.empty() && line[0] != '#') { // 跳过空行和注释
+            lines.push_back(line);
+        }
+    }
+    file.close();
+
+    if (lines.size() < 2) {
+        std::cerr << "压缩数据文件格式错误" << std::endl;
+        return false;
+    }
+
+    // 第一行是bounds，其余是compressed数据
+    std::string bounds_line = lines[0];
+    std::vector<std::string> compressed_lines(lines.begin() + 1, lines.end());
+
+    setCompressedData(parseCompressedData(compressed_lines), parseBoundsData(bounds_line));
+
+    std::cout << "加载压缩数据完成: " << m_ << " 颗卫星, "
+        << problem_->cols() << " 个时间窗口" << std::endl;
+
+    return true;
+}
+
+void SatelliteSchedulerBase::setCompressedData(const std::vector<std::vector<int>>& compressed,
+    const std::vector<int>& bounds) {
+    problem_ = problem_->withWindows(compressed, bounds);
+    m_ = problem_->rows();
+    onProblemChanged();
+}
+
+void SatelliteSchedulerBase::attachProblem(SchedulingProblem::Ptr problem) {
+    problem_ = std::move(problem);
+    m_ = problem_->rows();
+    if (problem_->hasMeshSource()) {
+        q_ = problem_->q();
+    }
+    onProblemChanged();
+}
+
+void SatelliteSchedulerBase::setWeights(const std::vector<double>& weights) {
+    // 长度不足的部分保持原权重
+    for (size_t k = 0; k < weights.size() && k < weights_.size(); ++k) {
+        weights_[k] = weights[k];
+    }
+}
+
+void SatelliteSchedulerBase::initializeCoverageLoader() {
+    auto loader = std::make_shared<CoverageDataLoader>(mesh_dir_, q_);
+    loader->setFillSeed(mesh_fill_seed_);
+    if (!grid_weights_.empty()) {
+        loader->setGridWeights(grid_weights_);
+    }
+    else if (!grid_weight_file_.empty()) {
+        loader->loadGridWeights(grid_weight_file_);
+    }
+
+    // 预加载特殊卫星在特殊时间点的数据
+    loader->preloadAllData(overlap_satellites_, special_times_);
+    problem_ = problem_->withMeshSource(std::move(loader), q_);
+    onCoverageLoaderChanged();
+
+    std::cout << "覆盖率加载器初始化完成" << std::endl;
+}
+
+std::vector<uint32_t> SatelliteSchedulerBase::saveRngState() const {
+    return gen_.saveState();
+}
+
+bool SatelliteSchedulerBase::restoreRngState(const std::vector<uint32_t>& state) {
+    return gen_.restoreState(state);
+}
+
+std::vector<int> SatelliteSchedulerBase::parseBoundsData(const std::string& bounds_line) {
+    std::vector<int> bounds;
+    std::stringstream ss(bounds_line);
+    std::string token;
+
+    while (std::getline(ss, token, ',')) {
+        try {
+            bounds.push_back(std::stoi(token));
+        }
+        catch (const std::exception& e) {
+            std::cerr << "解析bounds数据错误: " << token << " - " << e.what() << std::endl;
+        }
+    }
+
+    return bounds;
+}
+
+std::vector<std::vector<int>> SatelliteSchedulerBase::parseCompressedData(
+    const std::vector<std::string>& lines) {
+
+    std::vector<std::vector<int>> compressed;
+
+    for (const auto& line : lines) {
+        std::vector<int> satellite_schedule;
+        std::stringstream ss(line);
+        std::string token;
+
+        while (std::getline(ss, token, ',')) {
+            try {
+                satellite_schedule.push_back(std::stoi(token));
+            }
+            catch (const std::exception& e) {
+                std::cerr << "解析压缩数据错误: " << token << " - " << e.what() << std::endl;
+                satellite_schedule.push_back(-1); // 错误时设为无效值
+            }
+        }
+
+        if (!satellite_schedule.empty()) {
+            compressed.push_back(satellite_schedule);
+        }
+    }
+
+    return compressed;
 }
\ No newline at end of file
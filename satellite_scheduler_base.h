@@ -1,53 +1,98 @@
-#pragma once
-// satellite_scheduler_base.h
-#pragma once
-#include <vector>
-#include <string>
-#include <memory>
-#include <random>
-#include "coverage_loader.h"
-
-class SatelliteSchedulerBase {
-protected:
-    // ݽṹ
-    std::vector<std::vector<int>> compressed_;  // ѹʱ䴰ھ
-    std::vector<int> bounds_;                   // ԭʼʱ
-    int m_;                                     // 
-
-    // 㷨
-    int max_switches_ = 7;
-    int q_ = 6665;
-    std::vector<double> weights_ = { 0.34, 0.33, 0.33 };
-
-    int max_sparks_ = 30;
-    int max_length_ = 10;
-    bool update_bounds_ = true;
-    int max_variation_ = 3;
-
-    std::vector<int> special_times_ = { 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 449 };
-
-    // 
-    std::unique_ptr<CoverageDataLoader> coverage_loader_;
-
-    // 
-    std::random_device rd_;
-    std::mt19937 gen_;
-
-public:
-    SatelliteSchedulerBase();
-    virtual ~SatelliteSchedulerBase() = default;
-
-    // 
-    bool loadCompressedData(const std::string& filename);
-    void initializeCoverageLoader();
-
-    // ȡ
-    const std::vector<std::vector<int>>& getCompressed() const { return compressed_; }
-    const std::vector<int>& getBounds() const { return bounds_; }
-    int getSatelliteCount() const { return m_; }
-    int getQ() const { return q_; }
-
-protected:
-    std::vector<std::vector<int>> parseCompressedData(const std::vector<std::string>& lines);
-    std::vector<int> parseBoundsData(const std::string& bounds_line);
-};
+#pragma once
+// satellite_scheduler_base.h
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <memory>
+#include <random>
+#include <cstdint>
+#include "scheduling_problem.h"
+#include "fast_rng.h"
+
+class SatelliteSchedulerBase {
+protected:
+    // 问题数据（只读，可与其他调度器共享）
+    SchedulingProblem::Ptr problem_;
+    int m_ = 0;                                 // 卫星数量
+
+    // 算法参数
+    int max_switches_ = 7;
+    int q_ = 6665;
+    std::vector<double> weights_ = { 0.34, 0.33, 0.33 };
+
+    int max_sparks_ = 30;
+    int max_length_ = 10;
+    bool update_bounds_ = true;
+    int max_variation_ = 3;
+
+    std::vector<int> special_times_ = { 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 449 };
+    std::vector<int> overlap_satellites_ = { 2, 4, 5 };    // 有重叠时间窗口的卫星编号（1-based）
+    std::string mesh_dir_ = "mesh_data";                    // 重叠时间点网格数据目录
+    uint32_t mesh_fill_seed_ = 0;                           // 缺失网格的填充种子，0 表示随机
+    std::string grid_weight_file_;                          // 网格点权重文件（位于网格目录），空表示不读取
+    std::vector<double> grid_weights_;                      // 直接给定的网格点权重，优先于文件
+
+    // 随机数生成（见 fast_rng.h）：默认以 random_device 播种的 xoshiro256**
+    std::random_device rd_;
+    RandomSource gen_;
+
+public:
+    SatelliteSchedulerBase();
+    virtual ~SatelliteSchedulerBase() = default;
+
+    // 基础功能
+    bool loadCompressedData(const std::string& filename);
+    // 直接使用内存中的压缩数据（无需先写出文件再读取）
+    void setCompressedData(const std::vector<std::vector<int>>& compressed, const std::vector<int>& bounds);
+    void initializeCoverageLoader();
+    // 改为使用已构建好的共享问题（不复制数据），问题相关的缓存和边界随之重置
+    void attachProblem(SchedulingProblem::Ptr problem);
+
+    // 获取器
+    const SchedulingProblem::Ptr& getProblem() const { return problem_; }
+    const std::vector<std::vector<int>>& getCompressed() const { return problem_->compressed(); }
+    const std::vector<int>& getBounds() const { return problem_->bounds(); }
+    int getSatelliteCount() const { return m_; }
+    int getQ() const { return q_; }
+    const std::vector<int>& getSpecialTimes() const { return special_times_; }
+    const std::vector<int>& getOverlapSatellites() const { return overlap_satellites_; }
+    const std::string& getCoverageDataDir() const { return mesh_dir_; }
+
+    // 算法参数设置
+    // 负值按 0 处理（不允许开关切换）
+    void setMaxSwitches(int max_switches) { max_switches_ = std::max(0, max_switches); }
+    void setWeights(const std::vector<double>& weights);
+    void setMaxSparks(int max_sparks) { max_sparks_ = max_sparks; }
+    void setMaxLength(int max_length) { max_length_ = max_length; }
+    void setUpdateBounds(bool update_bounds) { update_bounds_ = update_bounds; }
+    void setMaxVariation(int max_variation) { max_variation_ = max_variation; }
+    // 以下参数在下一次 initializeCoverageLoader 时生效
+    void setQ(int q) { q_ = q; }
+    void setSpecialTimes(const std::vector<int>& special_times) { special_times_ = special_times; }
+    void setOverlapSatellites(const std::vector<int>& satellites) { overlap_satellites_ = satellites; }
+    void setCoverageDataDir(const std::string& data_dir) { mesh_dir_ = data_dir; }
+    void setMeshFillSeed(uint32_t seed) { mesh_fill_seed_ = seed; }
+    // 加权覆盖率（面积 / 优先级权重，见 PackedCoverage::setWeights）；两者都为空时各网格点等权
+    void setGridWeightFile(const std::string& filename) { grid_weight_file_ = filename; }
+    void setGridWeights(const std::vector<double>& weights) { grid_weights_ = weights; }
+
+    // 固定随机种子以便复现；Philox 引擎下每个火花使用由 (种子, 代, 烟花, 火花) 决定的独立序列
+    void setRandomSeed(uint64_t seed, RandomSource::Engine engine = RandomSource::Engine::Xoshiro) {
+        gen_.seed(seed, engine);
+    }
+    const RandomSource& getRandomSource() const { return gen_; }
+
+    // 随机数引擎状态（断点续算使用）；状态无法识别时返回 false 且引擎不变
+    std::vector<uint32_t> saveRngState() const;
+    bool restoreRngState(const std::vector<uint32_t>& state);
+
+protected:
+    // 问题数据变化后的回调（派生类用于清理缓存）
+    virtual void onProblemChanged() {}
+    // 覆盖率加载器重新初始化后的回调（派生类用于清理覆盖率相关的缓存）
+    virtual void onCoverageLoaderChanged() {}
+
+    std::vector<std::vector<int>> parseCompressedData(const std::vector<std::string>& lines);
+    std::vector<int> parseBoundsData(const std::string& bounds_line);
+};
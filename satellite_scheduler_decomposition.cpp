@@ -0,0 +1,305 @@
+// satellite_scheduler_decomposition.cpp
+#include "satellite_scheduler_decomposition.h"
+#include "thread_cpu_timer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <unordered_set>
+
+SatelliteSchedulerDecomposition::SatelliteSchedulerDecomposition() {
+    // 构造函数
+}
+
+namespace {
+    double weightDistance(const ObjectiveVector& a, const ObjectiveVector& b) {
+        double d = 0.0;
+        for (int k = 0; k < ActiveObjectives::N; ++k) {
+            d += (a[k] - b[k]) * (a[k] - b[k]);
+        }
+        return d;
+    }
+
+    // 单纯形格点：分量为 i/divisions 且和为 1 的全部向量
+    void enumerateLattice(int divisions, int k, int remaining, ObjectiveVector& current,
+        std::vector<ObjectiveVector>& out) {
+
+        if (k == ActiveObjectives::N - 1) {
+            current[k] = static_cast<double>(remaining) / divisions;
+            out.push_back(current);
+            return;
+        }
+        for (int i = 0; i <= remaining; ++i) {
+            current[k] = static_cast<double>(i) / divisions;
+            enumerateLattice(divisions, k + 1, remaining - i, current, out);
+        }
+    }
+}
+
+std::vector<ObjectiveVector> SatelliteSchedulerDecomposition::generateWeights(int count) {
+    std::vector<ObjectiveVector> lattice;
+    ObjectiveVector current{};
+    int divisions = 1;
+    while (true) {
+        lattice.clear();
+        enumerateLattice(divisions, 0, divisions, current, lattice);
+        if (static_cast<int>(lattice.size()) >= count || ActiveObjectives::N == 1) break;
+        divisions++;
+    }
+
+    if (static_cast<int>(lattice.size()) <= count) {
+        // 单目标时只有一个权重向量，全部子问题共用
+        while (static_cast<int>(lattice.size()) < count) {
+            lattice.push_back(lattice.front());
+        }
+        return lattice;
+    }
+
+    // 格点多于子问题数：从各坐标轴端点出发，依次加入离已选集合最远的格点
+    std::vector<ObjectiveVector> selected;
+    std::vector<double> nearest(lattice.size(), std::numeric_limits<double>::max());
+    auto add = [&](size_t idx) {
+        selected.push_back(lattice[idx]);
+        for (size_t c = 0; c < lattice.size(); ++c) {
+            nearest[c] = std::min(nearest[c], weightDistance(lattice[c], lattice[idx]));
+        }
+    };
+
+    for (size_t c = 0; c < lattice.size() && static_cast<int>(selected.size()) < count; ++c) {
+        if (*std::max_element(lattice[c].begin(), lattice[c].end()) == 1.0) {
+            add(c);
+        }
+    }
+    while (static_cast<int>(selected.size()) < count) {
+        add(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+    }
+    return selected;
+}
+
+double SatelliteSchedulerDecomposition::scalarize(const EvaluationResult& raw, const ObjectiveVector& weights) {
+    auto values = ActiveObjectives::raw(normalizeResult(raw));
+
+    double worst = 0.0;
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        // 归一化后 0 为最好：最小化目标直接取值，最大化目标取 1 - 值
+        double cost = ActiveObjectives::minimize(k) ? values[k] : 1.0 - values[k];
+        worst = std::max(worst, std::max(weights[k], 1e-6) * cost);
+    }
+    return worst;
+}
+
+std::pair<std::vector<std::vector<std::vector<int>>>,
+    std::vector<std::vector<std::vector<int>>>>
+    SatelliteSchedulerDecomposition::optimize(int max_iter, int num_fireworks, int max_changes) {
+
+    int start_iter = 0;
+    auto population = initialPopulation(num_fireworks, start_iter);
+
+    // 断点中的种群规模可能不同（例如由另一引擎保存），截断或补齐到子问题个数
+    int size = num_fireworks;
+    if (static_cast<int>(population.size()) > size) {
+        population.resize(size);
+    }
+    while (static_cast<int>(population.size()) < size) {
+        population.push_back(initializeSolution());
+    }
+
+    // 子问题权重：格点均匀分布，配置的 weights_ 替换距离最近的一个，保证该偏好方向上有专门的子问题
+    subproblem_weights_ = generateWeights(size);
+    ObjectiveVector preferred{};
+    double weight_sum = 0.0;
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        preferred[k] = std::max(0.0, weights_[k]);
+        weight_sum += preferred[k];
+    }
+    if (weight_sum > 0.0) {
+        for (double& w : preferred) w /= weight_sum;
+        auto closest = std::min_element(subproblem_weights_.begin(), subproblem_weights_.end(),
+            [&preferred](const ObjectiveVector& a, const ObjectiveVector& b) {
+                return weightDistance(a, preferred) < weightDistance(b, preferred);
+            });
+        *closest = preferred;
+    }
+
+    int neighborhood = std::max(1, std::min(neighborhood_size_, size));
+    neighbors_.assign(size, std::vector<int>());
+    for (int i = 0; i < size; ++i) {
+        std::vector<int> order(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::partial_sort(order.begin(), order.begin() + neighborhood, order.end(), [&](int a, int b) {
+            return weightDistance(subproblem_weights_[a], subproblem_weights_[i]) <
+                weightDistance(subproblem_weights_[b], subproblem_weights_[i]);
+        });
+        neighbors_[i].assign(order.begin(), order.begin() + neighborhood);
+    }
+
+    std::vector<uint64_t> hashes(size);
+    std::vector<EvaluationResult> incumbents(size);
+    for (int i = 0; i < size; ++i) {
+        hashes[i] = hashSolution(population[i]);
+        incumbents[i] = evaluateHashed(population[i], hashes[i], false);
+        if (checkSwitches(population[i])) {
+            archive_.insert(population[i], objectiveVector(incumbents[i]));
+        }
+    }
+
+    // 每代火花总数与烟花引擎大致相同（约 max_sparks_），平均分给各子问题
+    int sparks_per_subproblem = std::max(1, static_cast<int>(std::round(static_cast<double>(max_sparks_) / size)));
+
+    std::cout << "开始分解多目标优化，迭代次数: " << max_iter << ", 子问题数量: " << size
+        << ", 邻域大小: " << neighborhood << std::endl;
+
+    ThreadCpuTimer cpu_timer;
+    completed_iterations_ = 0;
+    screened_out_ = 0;
+    std::vector<int> visit_order(size);
+    std::iota(visit_order.begin(), visit_order.end(), 0);
+
+    for (int iter = start_iter; iter < max_iter; ++iter) {
+        // explode 的变异概率沿用当代加权适应度的统计量
+        double value_sum = 0.0;
+        double value_max = std::numeric_limits<double>::lowest();
+        for (int i = 0; i < size; ++i) {
+            double value = fitnessValue(evaluateHashed(population[i], hashes[i], true));
+            value_max = std::max(value_max, value);
+            value_sum += value;
+        }
+
+        std::shuffle(visit_order.begin(), visit_order.end(), gen_);
+        int replaced = 0;
+        int infeasible = 0;
+
+        // 候选解只与子问题 i 的邻居比较；邻居按随机顺序尝试，替换次数受限以免一个解占满整个邻域
+        auto offer = [&](int i, const std::vector<std::vector<int>>& candidate, uint64_t hash,
+            const EvaluationResult& result) {
+            auto candidates = neighbors_[i];
+            std::shuffle(candidates.begin(), candidates.end(), gen_);
+            int count = 0;
+            for (int j : candidates) {
+                if (count >= max_replacements_) break;
+                if (hashes[j] == hash) continue;
+
+                const auto& weights = subproblem_weights_[j];
+                if (scalarize(result, weights) < scalarize(incumbents[j], weights)) {
+                    population[j] = candidate;
+                    hashes[j] = hash;
+                    incumbents[j] = result;
+                    count++;
+                }
+            }
+            replaced += count;
+            return count;
+        };
+
+        // 多保真模式：覆盖率取乐观界后仍不能改进任何邻居的火花不做精确评估（也不进入档案）
+        auto promising = [&](int i, const std::vector<std::vector<int>>& candidate, uint64_t hash) {
+            double error = 0.0;
+            auto optimistic = evaluateSurrogate(candidate, hash, &error);
+            optimistic.coverage += error;
+            for (int j : neighbors_[i]) {
+                const auto& weights = subproblem_weights_[j];
+                if (hashes[j] != hash && scalarize(optimistic, weights) < scalarize(incumbents[j], weights)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        for (int i : visit_order) {
+            std::vector<SparkInfo> spark_info;
+            setSparkStream(iter, i);
+            auto sparks = explode(population[i], sparks_per_subproblem, randomInt(1, max_changes),
+                value_max, value_sum, size, std::numeric_limits<double>::epsilon(), &spark_info);
+
+            for (size_t s = 0; s < sparks.size(); ++s) {
+                if (!checkSwitches(spark_info[s].bits)) {
+                    creditSpark(spark_info[s], false, false);
+                    infeasible++;
+                    continue;
+                }
+
+                uint64_t hash = spark_info[s].hash;
+                if (surrogateEnabled() && !promising(i, sparks[s], hash)) {
+                    creditSpark(spark_info[s], false, false);
+                    screened_out_++;
+                    continue;
+                }
+
+                // 算子统计：替换了邻居记为存活，进入外部档案记为进入前沿
+                auto result = evaluateHashed(sparks[s], hash, false, &spark_info[s].bits);
+                bool archived = archive_.insert(sparks[s], objectiveVector(result));
+                bool survived = offer(i, sparks[s], hash, result) > 0;
+                creditSpark(spark_info[s], survived, archived);
+            }
+        }
+        endOperatorGeneration();
+
+        // 精英局部搜索：随机挑选子问题，对其当前解做单星重排后按同样规则参与邻域替换
+        if (refinementDue(iter)) {
+            for (int e = 0; e < refine_elites_ && e < size; ++e) {
+                int i = visit_order[e];
+                if (!checkSwitches(population[i])) continue;
+
+                std::vector<uint64_t> refined_hashes;
+                std::vector<EvaluationResult> refined_results;
+                auto refined = refineElites({ population[i] }, 1, refined_hashes, refined_results);
+                for (size_t r = 0; r < refined.size(); ++r) {
+                    offer(i, refined[r], refined_hashes[r], refined_results[r]);
+                }
+            }
+        }
+
+        std::cout << "迭代 " << iter << "/" << max_iter << " - 替换=" << replaced
+            << ", 不可行火花=" << infeasible << ", 档案=" << archive_.size() << std::endl;
+
+        if (progress_callback_ && progress_interval_ > 0 && (iter + 1) % progress_interval_ == 0) {
+            auto ranked = fastNonDominatedSort(population);
+            if (ranked.find(1) != ranked.end()) {
+                progress_callback_(iter, ranked[1]);
+            }
+        }
+
+        if (checkpoint_interval_ > 0 && (iter + 1) % checkpoint_interval_ == 0) {
+            saveCheckpoint(population, iter + 1, num_fireworks, max_changes);
+        }
+
+        completed_iterations_++;
+        if (time_budget_ms_ > 0.0 && cpu_timer.elapsedMs() >= time_budget_ms_) {
+            std::cout << "达到 CPU 时间预算 " << time_budget_ms_ << " ms，第 " << iter + 1 << " 次迭代后结束" << std::endl;
+            break;
+        }
+        if (cancel_check_ && cancel_check_()) {
+            std::cout << "优化已取消，第 " << iter + 1 << " 次迭代后结束" << std::endl;
+            break;
+        }
+    }
+
+    // 多个子问题可能保留同一个解，排序前去重
+    std::unordered_set<uint64_t> seen;
+    std::vector<std::vector<std::vector<int>>> unique_population;
+    for (int i = 0; i < size; ++i) {
+        if (seen.insert(hashes[i]).second && checkSwitches(population[i])) {
+            unique_population.push_back(population[i]);
+        }
+    }
+
+    auto final_ranking = fastNonDominatedSort(unique_population);
+    std::vector<std::vector<std::vector<int>>> best_solutions;
+    if (final_ranking.find(1) != final_ranking.end()) {
+        best_solutions = final_ranking[1];
+    }
+
+    std::vector<std::vector<std::vector<int>>> all_solutions = archive_.solutions();
+
+    std::cout << "优化完成，找到 " << best_solutions.size() << " 个最优解，档案中保存 "
+        << all_solutions.size() << " 个历代非支配解" << std::endl;
+    std::cout << "评估缓存命中 " << getCacheHits() << " 次，实际评估 " << getCacheMisses() << " 次" << std::endl;
+    if (surrogateEnabled()) {
+        std::cout << "代理评估 " << getSurrogateEvaluations() << " 次，其中 " << screened_out_
+            << " 个火花未做精确评估" << std::endl;
+    }
+    printOperatorStats();
+
+    return { best_solutions, all_solutions };
+}
@@ -0,0 +1,39 @@
+#pragma once
+// satellite_scheduler_decomposition.h
+#include "satellite_scheduler_multiobjective.h"
+
+// 基于分解的多目标优化引擎（MOEA/D 思路）
+// 把各目标按一组均匀分布的权重向量分解为 num_fireworks 个标量子问题，
+// 每个子问题保留一个当前解，用 explode 的爆炸 / 变异算子产生火花，只与相邻子问题比较替换
+// 每代的选择代价与种群规模成线性关系，不再做全局非支配排序
+// 断点、热启动、进度回调、时间预算和外部档案与 SatelliteSchedulerMultiObjective 相同
+class SatelliteSchedulerDecomposition : public SatelliteSchedulerMultiObjective {
+public:
+    SatelliteSchedulerDecomposition();
+
+    std::pair<std::vector<std::vector<std::vector<int>>>,
+        std::vector<std::vector<std::vector<int>>>>
+        optimize(int max_iter = 100, int num_fireworks = 20, int max_changes = 10) override;
+
+    // 邻域大小与每个火花最多替换的邻居数
+    void setNeighborhood(int size, int max_replacements = 2) {
+        neighborhood_size_ = size;
+        max_replacements_ = max_replacements;
+    }
+
+    // 子问题权重向量（每个分量非负且和为 1），optimize 开始时生成
+    const std::vector<ObjectiveVector>& getSubproblemWeights() const { return subproblem_weights_; }
+
+protected:
+    // 单纯形格点上选取 count 个尽量分散的权重向量
+    static std::vector<ObjectiveVector> generateWeights(int count);
+
+    // 归一化后的切比雪夫聚合值（越小越好）；理想点取归一化空间的原点
+    double scalarize(const EvaluationResult& raw, const ObjectiveVector& weights);
+
+    int neighborhood_size_ = 10;
+    int max_replacements_ = 2;
+
+    std::vector<ObjectiveVector> subproblem_weights_;
+    std::vector<std::vector<int>> neighbors_;   // 每个子问题的邻居（按权重距离由近到远，含自身）
+};
@@ -1,226 +1,343 @@
-// satellite_scheduler_fireworks.cpp
-#include "satellite_scheduler_fireworks.h"
-#include <algorithm>
-#include <iostream>
-
-SatelliteSchedulerFireworks::SatelliteSchedulerFireworks() {
-    // 캯
-}
-
-std::vector<std::vector<std::vector<int>>> SatelliteSchedulerFireworks::explode(
-    const std::vector<std::vector<int>>& solution,
-    int num_sparks,
-    int max_changes,
-    double fmax,
-    double fsum,
-    double size,
-    double epsilon) {
-
-    std::vector<std::vector<std::vector<int>>> sparks;
-
-    for (int spark_idx = 0; spark_idx < num_sparks; ++spark_idx) {
-        // ԭ
-        auto new_sol = copySolution(solution);
-
-        // ǰ
-        auto eval_result = evaluate(new_sol, true);
-        double value = weights_[0] * -eval_result.satellite_count +
-            weights_[1] * eval_result.coverage +
-            weights_[2] * -eval_result.load_variance;
-
-        // p
-        double p = (fmax - value + epsilon) / (fmax * size - fsum + epsilon);
-
-        int max_length = 0;
-
-        // ըӣѡǽ޸
-        std::vector<bool> if_sat(m_, false);
-
-        for (int change = 0; change < max_changes; ++change) {
-            // ѡ
-            int sat;
-            if (std::all_of(if_sat.begin(), if_sat.end(), [](bool v) { return v; })) {
-                sat = randomSatellite();
-            }
-            else {
-                // ѡδ޸ĵ
-                std::vector<int> available;
-                for (int i = 0; i < m_; ++i) {
-                    if (!if_sat[i]) {
-                        available.push_back(i);
-                    }
-                }
-                sat = available[randomInt(0, available.size() - 1)];
-            }
-            if_sat[sat] = true;
-
-            // Ѱ
-            int longest_seq = findLongestSequence(new_sol[sat]);
-            max_length = std::min(longest_seq, max_length_);
-
-            // ѡʱ䴰ڽ޸
-            if (max_length >= 2) {
-                int n = randomInt(2, max_length); // ޸ĵڳ
-
-                // еĽλ
-                auto intervals = findValidIntervals(new_sol[sat]);
-                if (!intervals.empty()) {
-                    // ѡ
-                    auto& longest_interval = intervals[0];
-                    for (const auto& interval : intervals) {
-                        if (interval.second - interval.first + 1 > longest_interval.second - longest_interval.first + 1) {
-                            longest_interval = interval;
-                        }
-                    }
-
-                    int start = longest_interval.second - n + 1;
-                    int end = longest_interval.second;
-
-                    // ȷΧЧ
-                    start = std::max(start, longest_interval.first);
-                    end = std::min(end, longest_interval.second);
-
-                    // ݸpõֵ
-                    int set_value;
-                    if (randomDouble() >= p) {
-                        set_value = randomInt(0, 1);
-                    }
-                    else {
-                        set_value = randomBool() ? 0 : 1;
-                    }
-
-                    // ޸ѡеʱ䴰
-                    for (int k = start; k <= end; ++k) {
-                        new_sol[sat][k] = set_value;
-                    }
-                }
-            }
-        }
-
-        // ӣֱ췽ʽ
-        int rand_choice = randomInt(0, 2);
-        applyRandomMutation(new_sol, rand_choice);
-
-        // ߱
-        int variation_sat = randomSatellite();
-        applyDirectedSleepMutation(new_sol, variation_sat, max_length);
-
-        sparks.push_back(new_sol);
-    }
-
-    return sparks;
-}
-
-std::vector<std::pair<int, int>> SatelliteSchedulerFireworks::findValidIntervals(
-    const std::vector<int>& schedule) {
-
-    std::vector<std::pair<int, int>> intervals;
-    int start = -1;
-
-    for (size_t j = 0; j < schedule.size(); ++j) {
-        if (schedule[j] != -1) {
-            if (start == -1) {
-                start = j;
-            }
-        }
-        else {
-            if (start != -1) {
-                intervals.emplace_back(start, j - 1);
-                start = -1;
-            }
-        }
-    }
-
-    if (start != -1) {
-        intervals.emplace_back(start, schedule.size() - 1);
-    }
-
-    return intervals;
-}
-
-int SatelliteSchedulerFireworks::findLongestSequence(const std::vector<int>& schedule) {
-    int longest_seq = 0;
-    int current_seq = 0;
-
-    for (int val : schedule) {
-        if (val != -1) {
-            current_seq++;
-            longest_seq = std::max(longest_seq, current_seq);
-        }
-        else {
-            current_seq = 0;
-        }
-    }
-
-    return longest_seq;
-}
-
-void SatelliteSchedulerFireworks::applyRandomMutation(
-    std::vector<std::vector<int>>& solution, int mutation_type) {
-
-    for (int sat = 0; sat < m_; ++sat) {
-        auto intervals = findValidIntervals(solution[sat]);
-
-        for (const auto& interval : intervals) {
-            int start_col = interval.first;
-            int end_col = interval.second;
-
-            switch (mutation_type) {
-            case 0: // ѡ1
-                if (randomBool(0.5)) {
-                    int selected = randomInt(start_col, end_col);
-                    solution[sat][selected] = 1;
-                }
-                break;
-
-            case 1: // ѡ0
-                if (randomBool(0.5)) {
-                    int selected = randomInt(start_col, end_col);
-                    solution[sat][selected] = 0;
-                }
-                break;
-
-            case 2: // 1
-                if (randomBool(0.1)) {
-                    for (int k = start_col; k <= end_col; ++k) {
-                        solution[sat][k] = 1;
-                    }
-                }
-                break;
-            }
-        }
-    }
-}
-
-void SatelliteSchedulerFireworks::applyDirectedSleepMutation(
-    std::vector<std::vector<int>>& solution, int variation_sat, int max_length) {
-
-    int actual_length = std::min(max_length, static_cast<int>(solution[variation_sat].size()));
-
-    for (int wd = 0; wd < actual_length; ++wd) {
-        if (solution[variation_sat][wd] == 1) {
-            solution[variation_sat][wd] = 0; // رʱ䴰
-        }
-    }
-}
-
-// 
-int SatelliteSchedulerFireworks::randomSatellite() {
-    std::uniform_int_distribution<int> dist(0, m_ - 1);
-    return dist(gen_);
-}
-
-int SatelliteSchedulerFireworks::randomInt(int min, int max) {
-    std::uniform_int_distribution<int> dist(min, max);
-    return dist(gen_);
-}
-
-double SatelliteSchedulerFireworks::randomDouble(double min, double max) {
-    std::uniform_real_distribution<double> dist(min, max);
-    return dist(gen_);
-}
-
-bool SatelliteSchedulerFireworks::randomBool(double probability) {
-    std::bernoulli_distribution dist(probability);
-    return dist(gen_);
-}
\ No newline at end of file
+// satellite_scheduler_fireworks.cpp
+#include "satellite_scheduler_fireworks.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    const double kAmplitudeScales[] = { 0.5, 1.0, 2.0 };
+
+    // 算子选择使用的 Philox 序列与火花本身的序列分开，复现火花时不需要重新抽取算子
+    const uint32_t kOperatorStream = 0x80000000u;
+}
+
+SatelliteSchedulerFireworks::SatelliteSchedulerFireworks()
+    : mutation_selector_(3), sleep_selector_(2), amplitude_selector_(3) {
+}
+
+std::vector<std::vector<std::vector<int>>> SatelliteSchedulerFireworks::explode(
+    const std::vector<std::vector<int>>& solution,
+    int num_sparks,
+    int max_changes,
+    double fmax,
+    double fsum,
+    double size,
+    double epsilon,
+    std::vector<SparkInfo>* spark_info) {
+
+    std::vector<std::vector<std::vector<int>>> sparks;
+
+    // 所有火花都由同一原解产生，原解只需哈希、评估一次；需要返回火花信息时再编码一次位平面，各火花复制后增量修改
+    uint64_t parent_hash = hashSolution(solution);
+    BitPlaneSchedule parent_bits;
+    if (spark_info) {
+        parent_bits = BitPlaneSchedule::encode(problem_->layout(), solution);
+    }
+    auto eval_result = evaluateHashed(solution, parent_hash, true, spark_info ? &parent_bits : nullptr);
+    double value = fitnessValue(eval_result);
+
+    // 计算概率p
+    double p = (fmax - value + epsilon) / (fmax * size - fsum + epsilon);
+
+    for (int spark_idx = 0; spark_idx < num_sparks; ++spark_idx) {
+        // Philox 引擎下每个火花从自己的序列抽取，与其他火花的抽取次数无关
+        gen_.beginStream(stream_generation_, stream_firework_, static_cast<uint32_t>(spark_idx) | kOperatorStream);
+        SparkOperators ops = selectOperators();
+        gen_.endStream();
+
+        gen_.beginStream(stream_generation_, stream_firework_, static_cast<uint32_t>(spark_idx));
+        uint64_t hash = parent_hash;
+        BitPlaneSchedule bits;
+        if (spark_info) {
+            bits = parent_bits;
+        }
+        auto new_sol = generateSpark(solution, max_changes, p, ops, hash, spark_info ? &bits : nullptr);
+        gen_.endStream();
+
+        if (spark_info) {
+            SparkInfo info;
+            info.hash = hash;
+            info.bits = std::move(bits);
+            info.generation = stream_generation_;
+            info.firework = stream_firework_;
+            info.spark = static_cast<uint32_t>(spark_idx);
+            info.max_changes = max_changes;
+            info.p = p;
+            info.ops = ops;
+            spark_info->push_back(std::move(info));
+        }
+        sparks.push_back(std::move(new_sol));
+    }
+
+    return sparks;
+}
+
+std::vector<std::vector<int>> SatelliteSchedulerFireworks::replaySpark(const std::vector<std::vector<int>>& parent,
+    const SparkInfo& info) {
+
+    uint64_t hash = hashSolution(parent);
+    gen_.beginStream(info.generation, info.firework, info.spark);
+    auto spark = generateSpark(parent, info.max_changes, info.p, info.ops, hash);
+    gen_.endStream();
+    return spark;
+}
+
+SatelliteSchedulerFireworks::SparkOperators SatelliteSchedulerFireworks::selectOperators() {
+    SparkOperators ops;
+    if (adaptive_operators_) {
+        ops.mutation = mutation_selector_.select(gen_);
+        ops.directed_sleep = sleep_selector_.select(gen_) == 0;
+        ops.amplitude = amplitude_selector_.select(gen_);
+    }
+    else {
+        ops.mutation = randomInt(0, 2);
+    }
+    return ops;
+}
+
+std::vector<std::vector<int>> SatelliteSchedulerFireworks::generateSpark(
+    const std::vector<std::vector<int>>& solution, int max_changes, double p, const SparkOperators& ops,
+    uint64_t& hash, BitPlaneSchedule* bits) {
+
+    // 复制原解
+    auto new_sol = copySolution(solution);
+
+    int max_length = 0;
+    int length_cap = std::max(1, static_cast<int>(std::lround(max_length_ * kAmplitudeScales[ops.amplitude])));
+
+    // 爆炸算子：随机选择卫星进行修改
+    std::vector<bool> if_sat(m_, false);
+
+    for (int change = 0; change < max_changes; ++change) {
+        // 选择卫星
+        int sat;
+        if (std::all_of(if_sat.begin(), if_sat.end(), [](bool v) { return v; })) {
+            sat = randomSatellite();
+        }
+        else {
+            // 选择尚未修改的卫星
+            std::vector<int> available;
+            for (int i = 0; i < m_; ++i) {
+                if (!if_sat[i]) {
+                    available.push_back(i);
+                }
+            }
+            sat = available[randomInt(0, available.size() - 1)];
+        }
+        if_sat[sat] = true;
+
+        // 寻找最长连续序列（可见段固定，直接取自位平面布局）
+        int longest_seq = problem_->layout().longestSegment(sat);
+        max_length = std::min(longest_seq, length_cap);
+
+        // 选择时间窗口进行修改
+        if (max_length >= 2) {
+            int n = randomInt(2, max_length); // 修改的连续窗口长度
+
+            // 查找连续序列的结束位置
+            const auto& intervals = problem_->layout().segments(sat);
+            if (!intervals.empty()) {
+                // 选择最长的区间
+                auto longest_interval = intervals[0];
+                for (const auto& interval : intervals) {
+                    if (interval.second - interval.first + 1 > longest_interval.second - longest_interval.first + 1) {
+                        longest_interval = interval;
+                    }
+                }
+
+                int start = longest_interval.second - n + 1;
+                int end = longest_interval.second;
+
+                // 确保范围有效
+                start = std::max(start, longest_interval.first);
+                end = std::min(end, longest_interval.second);
+
+                // 根据概率p决定设置的值
+                int set_value;
+                if (randomDouble() >= p) {
+                    set_value = randomInt(0, 1);
+                }
+                else {
+                    set_value = randomBool() ? 0 : 1;
+                }
+
+                // 修改选中的时间窗口
+                setRange(new_sol, &hash, bits, sat, start, end, set_value);
+            }
+        }
+    }
+
+    // 变异算子：三种变异方式
+    applyRandomMutation(new_sol, ops.mutation, &hash, bits);
+
+    // 定向休眠变异算子
+    if (ops.directed_sleep) {
+        int variation_sat = randomSatellite();
+        applyDirectedSleepMutation(new_sol, variation_sat, max_length, &hash, bits);
+    }
+
+    // 滚动时域下已执行的列保持不变
+    applyFrozenColumns(new_sol, &hash, bits);
+
+    return new_sol;
+}
+
+void SatelliteSchedulerFireworks::setAdaptiveOperators(bool enable, double learning_rate, double min_probability) {
+    adaptive_operators_ = enable;
+    mutation_selector_.configure(learning_rate, min_probability);
+    sleep_selector_.configure(learning_rate, min_probability);
+    amplitude_selector_.configure(learning_rate, min_probability);
+}
+
+void SatelliteSchedulerFireworks::creditSpark(const SparkInfo& info, bool survived, bool first_front) {
+    mutation_selector_.credit(info.ops.mutation, survived, first_front);
+    sleep_selector_.credit(info.ops.directed_sleep ? 0 : 1, survived, first_front);
+    amplitude_selector_.credit(info.ops.amplitude, survived, first_front);
+}
+
+void SatelliteSchedulerFireworks::endOperatorGeneration() {
+    // 关闭自适应时质量估计照常更新，只是 selectOperators 不使用这些概率
+    mutation_selector_.update();
+    sleep_selector_.update();
+    amplitude_selector_.update();
+}
+
+void SatelliteSchedulerFireworks::resetOperatorStats() {
+    mutation_selector_.reset(mutation_selector_.arms());
+    sleep_selector_.reset(sleep_selector_.arms());
+    amplitude_selector_.reset(amplitude_selector_.arms());
+}
+
+void SatelliteSchedulerFireworks::printOperatorStats() const {
+    auto print = [](const char* title, const OperatorSelector& selector, const char* const* names) {
+        std::cout << title << ":";
+        for (int a = 0; a < selector.arms(); ++a) {
+            const auto& arm = selector.stats()[a];
+            std::cout << " " << names[a] << " 使用=" << arm.uses << " 存活=" << arm.survived
+                << " 前沿=" << arm.first_front << " 概率=" << arm.probability << ";";
+        }
+        std::cout << std::endl;
+    };
+
+    const char* mutation_names[] = { "单点置1", "单点置0", "整段置1" };
+    const char* sleep_names[] = { "定向休眠", "跳过" };
+    const char* amplitude_names[] = { "幅度x0.5", "幅度x1", "幅度x2" };
+    print("变异算子", mutation_selector_, mutation_names);
+    print("定向休眠", sleep_selector_, sleep_names);
+    print("爆炸幅度", amplitude_selector_, amplitude_names);
+}
+
+std::vector<double> SatelliteSchedulerFireworks::saveOperatorState() const {
+    std::vector<double> state;
+    mutation_selector_.saveState(state);
+    sleep_selector_.saveState(state);
+    amplitude_selector_.saveState(state);
+    return state;
+}
+
+bool SatelliteSchedulerFireworks::restoreOperatorState(const std::vector<double>& state) {
+    size_t offset = 0;
+    return mutation_selector_.restoreState(state, offset) && sleep_selector_.restoreState(state, offset) &&
+        amplitude_selector_.restoreState(state, offset) && offset == state.size();
+}
+
+std::vector<std::pair<int, int>> SatelliteSchedulerFireworks::findValidIntervals(
+    const std::vector<int>& schedule) {
+
+    std::vector<std::pair<int, int>> intervals;
+    int start = -1;
+
+    for (size_t j = 0; j < schedule.size(); ++j) {
+        if (schedule[j] != -1) {
+            if (start == -1) {
+                start = j;
+            }
+        }
+        else {
+            if (start != -1) {
+                intervals.emplace_back(start, j - 1);
+                start = -1;
+            }
+        }
+    }
+
+    if (start != -1) {
+        intervals.emplace_back(start, schedule.size() - 1);
+    }
+
+    return intervals;
+}
+
+int SatelliteSchedulerFireworks::findLongestSequence(const std::vector<int>& schedule) {
+    int longest_seq = 0;
+    int current_seq = 0;
+
+    for (int val : schedule) {
+        if (val != -1) {
+            current_seq++;
+            longest_seq = std::max(longest_seq, current_seq);
+        }
+        else {
+            current_seq = 0;
+        }
+    }
+
+    return longest_seq;
+}
+
+void SatelliteSchedulerFireworks::applyRandomMutation(
+    std::vector<std::vector<int>>& solution, int mutation_type, uint64_t* hash, BitPlaneSchedule* bits) {
+
+    // 各可见段是否变异的伯努利位按卫星一次性批量抽取
+    double probability = mutation_type == 2 ? 0.1 : 0.5;
+
+    for (int sat = 0; sat < m_; ++sat) {
+        const auto& intervals = problem_->layout().segments(sat);
+        if (intervals.empty()) continue;
+
+        coin_bits_.resize((intervals.size() + 63) / 64);
+        gen_.fillBernoulli(probability, coin_bits_.data(), intervals.size());
+
+        for (size_t i = 0; i < intervals.size(); ++i) {
+            if (!(coin_bits_[i >> 6] >> (i & 63) & 1ULL)) continue;
+
+            int start_col = intervals[i].first;
+            int end_col = intervals[i].second;
+
+            switch (mutation_type) {
+            case 0: // 随机选点置1
+                setCell(solution, hash, sat, randomInt(start_col, end_col), 1, bits);
+                break;
+
+            case 1: // 随机选点置0
+                setCell(solution, hash, sat, randomInt(start_col, end_col), 0, bits);
+                break;
+
+            case 2: // 整个区间置1
+                setRange(solution, hash, bits, sat, start_col, end_col, 1);
+                break;
+            }
+        }
+    }
+}
+
+void SatelliteSchedulerFireworks::applyDirectedSleepMutation(
+    std::vector<std::vector<int>>& solution, int variation_sat, int max_length, uint64_t* hash,
+    BitPlaneSchedule* bits) {
+
+    int actual_length = std::min(max_length, static_cast<int>(solution[variation_sat].size()));
+
+    // 有位平面时开机列直接由掩码给出（不可见列恒为 0）
+    if (bits) {
+        if (actual_length > 0) {
+            setRange(solution, hash, bits, variation_sat, 0, actual_length - 1, 0);
+        }
+        return;
+    }
+
+    for (int wd = 0; wd < actual_length; ++wd) {
+        if (solution[variation_sat][wd] == 1) {
+            setCell(solution, hash, variation_sat, wd, 0); // 关闭时间窗口
+        }
+    }
+}
@@ -1,35 +1,103 @@
-#pragma once
-// satellite_scheduler_fireworks.h
-#pragma once
-#include "satellite_scheduler_solution.h"
-#include <unordered_map>
-
-class SatelliteSchedulerFireworks : public SatelliteSchedulerSolution {
-public:
-    SatelliteSchedulerFireworks();
-
-    // ըͱ
-    std::vector<std::vector<std::vector<int>>> explode(
-        const std::vector<std::vector<int>>& solution,
-        int num_sparks,
-        int max_changes,
-        double fmax,
-        double fsum,
-        double size,
-        double epsilon);
-
-    // 
-    std::vector<std::pair<int, int>> findValidIntervals(const std::vector<int>& schedule);
-    int findLongestSequence(const std::vector<int>& schedule);
-
-    // 
-    void applyRandomMutation(std::vector<std::vector<int>>& solution, int mutation_type);
-    void applyDirectedSleepMutation(std::vector<std::vector<int>>& solution, int variation_sat, int max_length);
-
-protected:
-    // ѡ
-    int randomSatellite();
-    int randomInt(int min, int max);
-    double randomDouble(double min = 0.0, double max = 1.0);
-    bool randomBool(double probability = 0.5);
+#pragma once
+// satellite_scheduler_fireworks.h
+#pragma once
+#include "satellite_scheduler_solution.h"
+#include "operator_selector.h"
+#include <unordered_map>
+
+class SatelliteSchedulerFireworks : public SatelliteSchedulerSolution {
+public:
+    SatelliteSchedulerFireworks();
+
+    // 一个火花使用的算子：随机变异类型（0 单点置 1、1 单点置 0、2 整段置 1）、是否做定向休眠变异、
+    // 爆炸幅度档位（max_length 乘以 0.5 / 1 / 2）
+    struct SparkOperators {
+        int mutation = 0;
+        bool directed_sleep = true;
+        int amplitude = 1;
+    };
+
+    // 火花附带信息：随变异增量维护的哈希与位平面，以及复现该火花所需的随机序列编号和爆炸参数
+    struct SparkInfo {
+        uint64_t hash = 0;
+        BitPlaneSchedule bits;
+        uint32_t generation = 0;
+        uint32_t firework = 0;
+        uint32_t spark = 0;
+        int max_changes = 0;
+        double p = 0.0;
+        SparkOperators ops;
+    };
+
+    // 爆炸和变异操作
+    std::vector<std::vector<std::vector<int>>> explode(
+        const std::vector<std::vector<int>>& solution,
+        int num_sparks,
+        int max_changes,
+        double fmax,
+        double fsum,
+        double size,
+        double epsilon,
+        std::vector<SparkInfo>* spark_info = nullptr);
+
+    // 接下来的 explode 所属的代与烟花编号；Philox 引擎下与火花序号一起决定每个火花的随机序列
+    void setSparkStream(int generation, int firework) {
+        stream_generation_ = static_cast<uint32_t>(generation);
+        stream_firework_ = static_cast<uint32_t>(firework);
+    }
+    // 按 SparkInfo 重新生成同一个火花（需 Philox 引擎，且问题、冻结列和 max_length 与生成时相同），用于单独调试
+    std::vector<std::vector<int>> replaySpark(const std::vector<std::vector<int>>& parent, const SparkInfo& info);
+
+    // 自适应算子选择：按各算子火花的存活 / 进入第一前沿情况在线调整选择概率（默认开启）
+    // 关闭时变异类型均匀抽取、总做定向休眠变异、幅度固定为 max_length，但统计仍会记录
+    void setAdaptiveOperators(bool enable, double learning_rate = 0.3, double min_probability = 0.05);
+    bool adaptiveOperatorsEnabled() const { return adaptive_operators_; }
+
+    // 记录火花的选择结果，一代的火花全部记录后调用 endOperatorGeneration 更新概率
+    void creditSpark(const SparkInfo& info, bool survived, bool first_front);
+    void endOperatorGeneration();
+    void resetOperatorStats();
+    void printOperatorStats() const;
+
+    const OperatorSelector& getMutationSelector() const { return mutation_selector_; }
+    const OperatorSelector& getSleepSelector() const { return sleep_selector_; }
+    const OperatorSelector& getAmplitudeSelector() const { return amplitude_selector_; }
+
+    // 各选择器的质量估计（断点续算使用）
+    std::vector<double> saveOperatorState() const;
+    bool restoreOperatorState(const std::vector<double>& state);
+
+    // 辅助函数
+    std::vector<std::pair<int, int>> findValidIntervals(const std::vector<int>& schedule);
+    int findLongestSequence(const std::vector<int>& schedule);
+
+    // 变异操作
+    // hash 非空时随修改增量更新解哈希；bits 非空时同步更新位平面，整段修改按掩码只改写取值变化的列
+    void applyRandomMutation(std::vector<std::vector<int>>& solution, int mutation_type,
+        uint64_t* hash = nullptr, BitPlaneSchedule* bits = nullptr);
+    void applyDirectedSleepMutation(std::vector<std::vector<int>>& solution, int variation_sat, int max_length,
+        uint64_t* hash = nullptr, BitPlaneSchedule* bits = nullptr);
+
+protected:
+    // 为一个火花选择算子；自适应关闭时等价于原先的均匀选择
+    SparkOperators selectOperators();
+
+    // 由原解按给定算子生成一个火花（爆炸、随机变异、定向休眠），hash 与 bits（可为空）随修改增量更新
+    std::vector<std::vector<int>> generateSpark(const std::vector<std::vector<int>>& solution, int max_changes,
+        double p, const SparkOperators& ops, uint64_t& hash, BitPlaneSchedule* bits = nullptr);
+
+    // 随机选择辅助函数
+    int randomSatellite() { return gen_.uniformInt(0, m_ - 1); }
+    int randomInt(int min, int max) { return gen_.uniformInt(min, max); }
+    double randomDouble(double min = 0.0, double max = 1.0) { return min + (max - min) * gen_.uniform01(); }
+    bool randomBool(double probability = 0.5) { return gen_.bernoulli(probability); }
+
+    uint32_t stream_generation_ = 0;
+    uint32_t stream_firework_ = 0;
+    std::vector<uint64_t> coin_bits_;       // 批量伯努利抽样的缓冲区
+
+    bool adaptive_operators_ = true;
+    OperatorSelector mutation_selector_;
+    OperatorSelector sleep_selector_;       // 臂 0 做定向休眠变异，臂 1 跳过
+    OperatorSelector amplitude_selector_;
 };
\ No newline at end of file
@@ -1,309 +1,657 @@
-// satellite_scheduler_multiobjective.cpp
-#include "satellite_scheduler_multiobjective.h"
-#include <algorithm>
-#include <limits>
-#include <iostream>
-
-SatelliteSchedulerMultiObjective::SatelliteSchedulerMultiObjective() {
-    // 캯
-}
-
-std::unordered_map<int, std::vector<std::vector<std::vector<int>>>>
-SatelliteSchedulerMultiObjective::fastNonDominatedSort(
-    const std::vector<std::vector<std::vector<int>>>& solutions) {
-
-    std::unordered_map<int, std::vector<std::vector<std::vector<int>>>> fronts;
-    fronts[1] = {};
-
-    std::vector<int> domination_count(solutions.size(), 0);
-    std::vector<std::vector<int>> dominated_set(solutions.size());
-
-    // нĿֵ
-    std::vector<std::vector<double>> objectives;
-    for (const auto& sol : solutions) {
-        auto eval_result = evaluate(sol, false);
-        objectives.push_back({
-            eval_result.satellite_count,    // f1: С
-            -eval_result.coverage,          // f2:  -> ȡС
-            eval_result.load_variance       // f3: С
-            });
-    }
-
-    // ֧ϵ
-    for (size_t i = 0; i < solutions.size(); ++i) {
-        for (size_t j = 0; j < solutions.size(); ++j) {
-            if (i == j) continue;
-
-            if (dominates(objectives[i], objectives[j])) {
-                dominated_set[i].push_back(j);
-            }
-            else if (dominates(objectives[j], objectives[i])) {
-                domination_count[i]++;
-            }
-        }
-
-        if (domination_count[i] == 0) {
-            fronts[1].push_back(solutions[i]);
-        }
-    }
-
-    // ǰ
-    int current_rank = 1;
-    while (!fronts[current_rank].empty()) {
-        std::vector<std::vector<std::vector<int>>> next_front;
-
-        for (const auto& sol : fronts[current_rank]) {
-            // ҵǰԭʼбе
-            auto it = std::find(solutions.begin(), solutions.end(), sol);
-            if (it != solutions.end()) {
-                int i = std::distance(solutions.begin(), it);
-
-                for (int j : dominated_set[i]) {
-                    domination_count[j]--;
-                    if (domination_count[j] == 0) {
-                        next_front.push_back(solutions[j]);
-                    }
-                }
-            }
-        }
-
-        current_rank++;
-        if (!next_front.empty()) {
-            fronts[current_rank] = next_front;
-        }
-        else {
-            break;
-        }
-    }
-
-    return fronts;
-}
-
-std::vector<std::vector<std::vector<int>>>
-SatelliteSchedulerMultiObjective::crowdingSelection(
-    const std::vector<std::vector<std::vector<int>>>& solutions,
-    int select_num) {
-
-    if (solutions.size() <= select_num) {
-        return solutions;
-    }
-
-    // нĿֵ
-    std::vector<SolutionWithObjectives> sols_with_obj;
-    for (const auto& sol : solutions) {
-        SolutionWithObjectives sol_obj;
-        sol_obj.solution = sol;
-        sol_obj.objectives = solutionToObjectives(sol);
-        sols_with_obj.push_back(sol_obj);
-    }
-
-    // ӵ
-    for (int m = 0; m < 3; ++m) {
-        // Ŀm
-        std::sort(sols_with_obj.begin(), sols_with_obj.end(),
-            [m](const SolutionWithObjectives& a, const SolutionWithObjectives& b) {
-                return a.objectives[m] < b.objectives[m];
-            });
-
-        // ñ߽ӵΪ
-        sols_with_obj.front().crowding_distance = std::numeric_limits<double>::infinity();
-        sols_with_obj.back().crowding_distance = std::numeric_limits<double>::infinity();
-
-        // мӵ
-        double min_obj = sols_with_obj.front().objectives[m];
-        double max_obj = sols_with_obj.back().objectives[m];
-        double range = max_obj - min_obj;
-
-        if (range > 0) {
-            for (size_t i = 1; i < sols_with_obj.size() - 1; ++i) {
-                double distance = (sols_with_obj[i + 1].objectives[m] - sols_with_obj[i - 1].objectives[m]) / range;
-                sols_with_obj[i].crowding_distance += distance;
-            }
-        }
-    }
-
-    // ӵ򣨽
-    std::sort(sols_with_obj.begin(), sols_with_obj.end(),
-        [](const SolutionWithObjectives& a, const SolutionWithObjectives& b) {
-            return a.crowding_distance > b.crowding_distance;
-        });
-
-    // ѡǰselect_num
-    std::vector<std::vector<std::vector<int>>> selected;
-    for (int i = 0; i < select_num && i < sols_with_obj.size(); ++i) {
-        selected.push_back(sols_with_obj[i].solution);
-    }
-
-    return selected;
-}
-
-bool SatelliteSchedulerMultiObjective::dominates(
-    const std::vector<double>& obj_a, const std::vector<double>& obj_b) {
-
-    // Ŀ궼bĿ궼С
-    bool cond1 = (obj_a[0] <= obj_b[0]) && (obj_a[1] <= obj_b[1]) && (obj_a[2] <= obj_b[2]);
-
-    // һĿϸb
-    bool cond2 = (obj_a[0] < obj_b[0]) || (obj_a[1] < obj_b[1]) || (obj_a[2] < obj_b[2]);
-
-    return cond1 && cond2;
-}
-
-std::pair<std::vector<std::vector<std::vector<int>>>,
-    std::vector<std::vector<std::vector<int>>>>
-    SatelliteSchedulerMultiObjective::optimize(int max_iter, int num_fireworks, int max_changes) {
-
-    // ʼ̻Ⱥ
-    std::vector<std::vector<std::vector<int>>> fireworks;
-    for (int i = 0; i < num_fireworks; ++i) {
-        fireworks.push_back(initializeSolution());
-    }
-
-    std::vector<std::vector<std::vector<int>>> all_candidates;
-
-    std::cout << "ʼ̻㷨Ż: " << max_iter
-        << ", ̻: " << num_fireworks << std::endl;
-
-    for (int iter = 0; iter < max_iter; ++iter) {
-        std::vector<std::vector<std::vector<int>>> sparks;
-
-        // ӦͳϢ
-        double value_sum = 0.0;
-        double value_min = std::numeric_limits<double>::max();
-        double value_max = std::numeric_limits<double>::lowest();
-        int size = fireworks.size();
-
-        for (const auto& fw : fireworks) {
-            auto eval_result = evaluate(fw, true);
-            double value = weights_[0] * -eval_result.satellite_count +
-                weights_[1] * eval_result.coverage +
-                weights_[2] * -eval_result.load_variance;
-
-            value_min = std::min(value_min, value);
-            value_max = std::max(value_max, value);
-            value_sum += value;
-        }
-
-        // Ϊÿ̻
-        for (const auto& fw : fireworks) {
-            auto eval_result = evaluate(fw, true);
-            double value = weights_[0] * -eval_result.satellite_count +
-                weights_[1] * eval_result.coverage +
-                weights_[2] * -eval_result.load_variance;
-
-            // Ļ
-            int num = static_cast<int>(std::round(
-                max_sparks_ * (value - value_min + std::numeric_limits<double>::epsilon()) /
-                (value_sum - size * value_min + std::numeric_limits<double>::epsilon())));
-
-            // ȷٲһ
-            num = std::max(1, num);
-
-            // ѡ޸ĵ
-            int max_changes_for_firework = randomInt(1, max_changes);
-
-            // 
-            auto new_sparks = explode(fw, num, max_changes_for_firework,
-                value_max, value_sum, size,
-                std::numeric_limits<double>::epsilon());
-
-            sparks.insert(sparks.end(), new_sparks.begin(), new_sparks.end());
-        }
-
-        // ϲѡ
-        auto candidates = fireworks;
-        candidates.insert(candidates.end(), sparks.begin(), sparks.end());
-        all_candidates = candidates; // кѡ
-
-        // лƵԼ
-        std::vector<std::vector<std::vector<int>>> valid_candidates;
-        for (const auto& candidate : candidates) {
-            if (checkSwitches(candidate)) {
-                valid_candidates.push_back(candidate);
-            }
-        }
-
-        // ٷ֧
-        auto ranked = fastNonDominatedSort(valid_candidates);
-
-        // ѡһ
-        std::vector<std::vector<std::vector<int>>> selected;
-        int current_rank = 1;
-
-        while (selected.size() < num_fireworks + max_sparks_ &&
-            ranked.find(current_rank) != ranked.end()) {
-
-            int needed = num_fireworks + max_sparks_ - selected.size();
-            auto& available = ranked[current_rank];
-
-            if (available.size() > needed) {
-                auto selected_from_rank = crowdingSelection(available, needed);
-                selected.insert(selected.end(), selected_from_rank.begin(), selected_from_rank.end());
-            }
-            else {
-                selected.insert(selected.end(), available.begin(), available.end());
-            }
-
-            current_rank++;
-        }
-
-        fireworks = selected;
-
-        // Ϣ
-        if (iter % 1 == 0) {
-            std::cout << " " << iter << "/" << max_iter;
-            if (ranked.find(1) != ranked.end() && !ranked[1].empty()) {
-                auto best = ranked[1][0];
-                auto best_eval = evaluate(best, false);
-                std::cout << " - ѽ: =" << best_eval.satellite_count
-                    << ", =" << best_eval.coverage / 100 << "%"
-                    << ", ƽÿʱƬ=" << best_eval.coverage / bounds_.size()
-                    << ", =" << best_eval.load_variance;
-            }
-            std::cout << std::endl;
-        }
-    }
-
-    // 
-    auto final_ranking = fastNonDominatedSort(fireworks);
-    auto all_ranking = fastNonDominatedSort(all_candidates);
-
-    std::vector<std::vector<std::vector<int>>> best_solutions;
-    if (final_ranking.find(1) != final_ranking.end()) {
-        best_solutions = final_ranking[1];
-    }
-
-    std::vector<std::vector<std::vector<int>>> all_solutions;
-    if (all_ranking.find(1) != all_ranking.end()) {
-        all_solutions = all_ranking[1];
-    }
-
-    std::cout << "Żɣҵ " << best_solutions.size() << " Ž" << std::endl;
-
-    return { best_solutions, all_solutions };
-}
-
-std::vector<double> SatelliteSchedulerMultiObjective::solutionToObjectives(
-    const std::vector<std::vector<int>>& solution) {
-
-    auto eval_result = evaluate(solution, false);
-    return {
-        eval_result.satellite_count,    // f1: С
-        -eval_result.coverage,          // f2:  -> ȡС  
-        eval_result.load_variance       // f3: С
-    };
-}
-
-double SatelliteSchedulerMultiObjective::calculateCrowdingDistance(
-    const std::vector<SolutionWithObjectives>& solutions,
-    int solution_idx, int objective_idx) {
-
-    if (solution_idx == 0 || solution_idx == solutions.size() - 1) {
-        return std::numeric_limits<double>::infinity();
-    }
-
-    double prev_obj = solutions[solution_idx - 1].objectives[objective_idx];
-    double next_obj = solutions[solution_idx + 1].objectives[objective_idx];
-
-    return next_obj - prev_obj;
+// satellite_scheduler_multiobjective.cpp
+#include "satellite_scheduler_multiobjective.h"
+#include "thread_cpu_timer.h"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <iostream>
+#include <unordered_set>
+
+SatelliteSchedulerMultiObjective::SatelliteSchedulerMultiObjective() {
+    // 构造函数
+}
+
+std::unordered_map<int, std::vector<std::vector<std::vector<int>>>>
+SatelliteSchedulerMultiObjective::fastNonDominatedSort(
+    const std::vector<std::vector<std::vector<int>>>& solutions) {
+
+    std::unordered_map<int, std::vector<std::vector<std::vector<int>>>> fronts;
+    fronts[1] = {};
+
+    std::vector<int> domination_count(solutions.size(), 0);
+    std::vector<std::vector<int>> dominated_set(solutions.size());
+
+    // 计算所有解的目标值
+    std::vector<ObjectiveVector> objectives;
+    objectives.reserve(solutions.size());
+    for (const auto& sol : solutions) {
+        objectives.push_back(solutionToObjectives(sol));
+    }
+
+    // 计算支配关系
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        for (size_t j = 0; j < solutions.size(); ++j) {
+            if (i == j) continue;
+
+            if (dominates(objectives[i], objectives[j])) {
+                dominated_set[i].push_back(j);
+            }
+            else if (dominates(objectives[j], objectives[i])) {
+                domination_count[i]++;
+            }
+        }
+
+        if (domination_count[i] == 0) {
+            fronts[1].push_back(solutions[i]);
+        }
+    }
+
+    // 构建后续前沿
+    int current_rank = 1;
+    while (!fronts[current_rank].empty()) {
+        std::vector<std::vector<std::vector<int>>> next_front;
+
+        for (const auto& sol : fronts[current_rank]) {
+            // 找到当前解在原始列表中的索引
+            auto it = std::find(solutions.begin(), solutions.end(), sol);
+            if (it != solutions.end()) {
+                int i = std::distance(solutions.begin(), it);
+
+                for (int j : dominated_set[i]) {
+                    domination_count[j]--;
+                    if (domination_count[j] == 0) {
+                        next_front.push_back(solutions[j]);
+                    }
+                }
+            }
+        }
+
+        current_rank++;
+        if (!next_front.empty()) {
+            fronts[current_rank] = next_front;
+        }
+        else {
+            break;
+        }
+    }
+
+    return fronts;
+}
+
+std::vector<std::vector<std::vector<int>>>
+SatelliteSchedulerMultiObjective::crowdingSelection(
+    const std::vector<std::vector<std::vector<int>>>& solutions,
+    int select_num) {
+
+    if (solutions.size() <= select_num) {
+        return solutions;
+    }
+
+    // 计算所有解的目标值
+    std::vector<SolutionWithObjectives> sols_with_obj;
+    for (const auto& sol : solutions) {
+        SolutionWithObjectives sol_obj;
+        sol_obj.solution = sol;
+        sol_obj.objectives = solutionToObjectives(sol);
+        sols_with_obj.push_back(sol_obj);
+    }
+
+    // 计算拥挤距离
+    for (int m = 0; m < ActiveObjectives::N; ++m) {
+        // 按目标m排序
+        std::sort(sols_with_obj.begin(), sols_with_obj.end(),
+            [m](const SolutionWithObjectives& a, const SolutionWithObjectives& b) {
+                return a.objectives[m] < b.objectives[m];
+            });
+
+        // 设置边界解的拥挤距离为无穷大
+        sols_with_obj.front().crowding_distance = std::numeric_limits<double>::infinity();
+        sols_with_obj.back().crowding_distance = std::numeric_limits<double>::infinity();
+
+        // 计算中间解的拥挤距离
+        double min_obj = sols_with_obj.front().objectives[m];
+        double max_obj = sols_with_obj.back().objectives[m];
+        double range = max_obj - min_obj;
+
+        if (range > 0) {
+            for (size_t i = 1; i < sols_with_obj.size() - 1; ++i) {
+                double distance = (sols_with_obj[i + 1].objectives[m] - sols_with_obj[i - 1].objectives[m]) / range;
+                sols_with_obj[i].crowding_distance += distance;
+            }
+        }
+    }
+
+    // 按拥挤距离排序（降序）
+    std::sort(sols_with_obj.begin(), sols_with_obj.end(),
+        [](const SolutionWithObjectives& a, const SolutionWithObjectives& b) {
+            return a.crowding_distance > b.crowding_distance;
+        });
+
+    // 选择前select_num个解
+    std::vector<std::vector<std::vector<int>>> selected;
+    for (int i = 0; i < select_num && i < sols_with_obj.size(); ++i) {
+        selected.push_back(sols_with_obj[i].solution);
+    }
+
+    return selected;
+}
+
+bool SatelliteSchedulerMultiObjective::dominates(
+    const ObjectiveVector& obj_a, const ObjectiveVector& obj_b) {
+
+    // 所有目标都不差于b且至少一个目标严格优于b（均已转为最小化）
+    return ActiveObjectives::dominates(obj_a, obj_b);
+}
+
+namespace {
+    // 每列代价相对平均正增益的倍数：0 只追求覆盖率，越大越倾向于减少开机列
+    const double kColumnCostFactors[] = { 0.0, 0.5, 1.5 };
+}
+
+std::vector<size_t> SatelliteSchedulerMultiObjective::screenCandidates(
+    const std::vector<std::vector<std::vector<int>>>& candidates, const std::vector<uint64_t>& hashes,
+    const std::vector<size_t>& indices, size_t keep) {
+
+    size_t n = indices.size();
+    std::vector<ObjectiveVector> optimistic(n);
+    std::vector<ObjectiveVector> pessimistic(n);
+    for (size_t i = 0; i < n; ++i) {
+        double error = 0.0;
+        auto result = evaluateSurrogate(candidates[indices[i]], hashes[indices[i]], &error);
+        optimistic[i] = objectiveBound(result, error);
+        pessimistic[i] = objectiveBound(result, -error);
+    }
+
+    // 被支配次数：有多少候选即使取悲观界也支配该候选的乐观界；为 0 的候选可能进入第一前沿
+    std::vector<int> dominated_by(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            if (i != j && dominates(pessimistic[j], optimistic[i])) {
+                dominated_by[i]++;
+            }
+        }
+    }
+
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&dominated_by](size_t a, size_t b) { return dominated_by[a] < dominated_by[b]; });
+
+    std::vector<bool> kept(n, false);
+    size_t count = 0;
+    for (size_t i : order) {
+        if (dominated_by[i] > 0 && count >= keep) break;
+        kept[i] = true;
+        count++;
+    }
+
+    std::vector<size_t> result;
+    result.reserve(count);
+    for (size_t i = 0; i < n; ++i) {
+        if (kept[i]) {
+            result.push_back(indices[i]);
+        }
+    }
+    screened_out_ += n - count;
+    return result;
+}
+
+std::vector<std::vector<std::vector<int>>> SatelliteSchedulerMultiObjective::refineElites(
+    const std::vector<std::vector<std::vector<int>>>& pool, int count,
+    std::vector<uint64_t>& hashes, std::vector<EvaluationResult>& results) {
+
+    std::vector<std::vector<std::vector<int>>> refined;
+    hashes.clear();
+    results.clear();
+    if (pool.empty() || count <= 0) {
+        return refined;
+    }
+
+    std::vector<int> order(pool.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), gen_);
+    order.resize(std::min<size_t>(order.size(), count));
+
+    std::unordered_set<uint64_t> seen;
+    for (int index : order) {
+        const auto& elite = pool[index];
+        uint64_t elite_hash = hashSolution(elite);
+        seen.insert(elite_hash);
+
+        int sat = randomSatellite();
+        if (problem_->layout().segments(sat).empty()) {
+            continue;
+        }
+
+        auto gains = refinementGains(elite, sat);
+        double positive_sum = 0.0;
+        int positive_count = 0;
+        for (double g : gains) {
+            if (g > 0.0) {
+                positive_sum += g;
+                positive_count++;
+            }
+        }
+        double mean_gain = positive_count > 0 ? positive_sum / positive_count : 0.0;
+
+        for (double factor : kColumnCostFactors) {
+            auto candidate = elite;
+            uint64_t hash = elite_hash;
+            if (!refineSatellite(candidate, sat, gains, factor * mean_gain, &hash)) {
+                continue;
+            }
+            if (!seen.insert(hash).second || !checkSwitches(candidate)) {
+                continue;
+            }
+
+            auto result = evaluateHashed(candidate, hash, false);
+            archive_.insert(candidate, objectiveVector(result));
+            refined.push_back(std::move(candidate));
+            hashes.push_back(hash);
+            results.push_back(result);
+        }
+    }
+
+    return refined;
+}
+
+std::vector<std::vector<std::vector<int>>> SatelliteSchedulerMultiObjective::initialPopulation(
+    int num_fireworks, int& start_iter) {
+
+    std::vector<std::vector<std::vector<int>>> fireworks;
+    start_iter = 0;
+
+    if (resume_pending_) {
+        fireworks = std::move(resume_population_);
+        start_iter = resume_iteration_;
+        resume_pending_ = false;
+        std::cout << "从断点恢复，继续第 " << start_iter << " 次迭代" << std::endl;
+    }
+    else {
+        // 热启动种子优先（过多时按拥挤距离挑选），其余随机初始化
+        if (static_cast<int>(warm_seeds_.size()) > num_fireworks) {
+            warm_seeds_ = crowdingSelection(warm_seeds_, num_fireworks);
+        }
+        for (auto& seed : warm_seeds_) {
+            if (static_cast<int>(fireworks.size()) >= num_fireworks) break;
+            fireworks.push_back(std::move(seed));
+        }
+        if (!warm_seeds_.empty()) {
+            std::cout << "热启动: 使用 " << fireworks.size() << " 个上一轮解作为种子" << std::endl;
+        }
+        warm_seeds_.clear();
+        resetOperatorStats();
+
+        // 启发式播种：三种构造规则轮流使用，重复时加入扰动以保持差异
+        int num_seeded = static_cast<int>(std::round(seed_fraction_ * num_fireworks));
+        for (int i = 0; i < num_seeded && static_cast<int>(fireworks.size()) < num_fireworks; ++i) {
+            auto heuristic = static_cast<SeedHeuristic>(i % 3);
+            double perturbation = 0.05 * (i / 3);
+            fireworks.push_back(buildHeuristicSolution(heuristic, perturbation));
+        }
+
+        while (static_cast<int>(fireworks.size()) < num_fireworks) {
+            fireworks.push_back(initializeSolution());
+        }
+        archive_.clear();
+    }
+
+    return fireworks;
+}
+
+std::pair<std::vector<std::vector<std::vector<int>>>,
+    std::vector<std::vector<std::vector<int>>>>
+    SatelliteSchedulerMultiObjective::optimize(int max_iter, int num_fireworks, int max_changes) {
+
+    // 初始化烟花种群（或从断点恢复）
+    int start_iter = 0;
+    std::vector<std::vector<std::vector<int>>> fireworks = initialPopulation(num_fireworks, start_iter);
+
+    std::vector<uint64_t> firework_hashes;
+    for (const auto& fw : fireworks) {
+        firework_hashes.push_back(hashSolution(fw));
+    }
+
+    std::cout << "开始烟花算法优化，迭代次数: " << max_iter
+        << ", 烟花数量: " << num_fireworks << std::endl;
+
+    ThreadCpuTimer cpu_timer;
+    completed_iterations_ = 0;
+    screened_out_ = 0;
+
+    for (int iter = start_iter; iter < max_iter; ++iter) {
+        std::vector<std::vector<std::vector<int>>> sparks;
+
+        // 计算适应度统计信息
+        double value_sum = 0.0;
+        double value_min = std::numeric_limits<double>::max();
+        double value_max = std::numeric_limits<double>::lowest();
+        int size = fireworks.size();
+
+        for (int i = 0; i < size; ++i) {
+            auto eval_result = evaluateHashed(fireworks[i], firework_hashes[i], true);
+            double value = fitnessValue(eval_result);
+
+            value_min = std::min(value_min, value);
+            value_max = std::max(value_max, value);
+            value_sum += value;
+        }
+
+        // 为每个烟花产生火花
+        std::vector<SparkInfo> spark_info;
+        for (int i = 0; i < size; ++i) {
+            const auto& fw = fireworks[i];
+            auto eval_result = evaluateHashed(fw, firework_hashes[i], true);
+            double value = fitnessValue(eval_result);
+
+            // 计算产生的火花数量
+            int num = static_cast<int>(std::round(
+                max_sparks_ * (value - value_min + std::numeric_limits<double>::epsilon()) /
+                (value_sum - size * value_min + std::numeric_limits<double>::epsilon())));
+
+            // 确保至少产生一个火花
+            num = std::max(1, num);
+
+            // 随机选择修改的卫星数量
+            int max_changes_for_firework = randomInt(1, max_changes);
+
+            // 产生火花
+            setSparkStream(iter, i);
+            auto new_sparks = explode(fw, num, max_changes_for_firework,
+                value_max, value_sum, size,
+                std::numeric_limits<double>::epsilon(), &spark_info);
+
+            sparks.insert(sparks.end(),
+                std::make_move_iterator(new_sparks.begin()), std::make_move_iterator(new_sparks.end()));
+        }
+
+        // 合并候选解
+        auto candidates = fireworks;
+        candidates.insert(candidates.end(),
+            std::make_move_iterator(sparks.begin()), std::make_move_iterator(sparks.end()));
+
+        std::vector<uint64_t> candidate_hashes = firework_hashes;
+        for (const auto& info : spark_info) {
+            candidate_hashes.push_back(info.hash);
+        }
+
+        // 火花的位平面随 explode 同步维护，烟花（前 size 个候选）没有
+        auto candidate_bits = [&](size_t c) -> const BitPlaneSchedule* {
+            return c >= static_cast<size_t>(size) ? &spark_info[c - size].bits : nullptr;
+        };
+
+        // 克隆过滤：相同调度只保留一份；再检查切换频率约束，可行解同时送入外部档案
+        std::unordered_set<uint64_t> seen_hashes;
+        std::vector<size_t> feasible;
+        std::vector<bool> is_clone(candidates.size(), false);
+        int clone_count = 0;
+        for (size_t c = 0; c < candidates.size(); ++c) {
+            if (!seen_hashes.insert(candidate_hashes[c]).second) {
+                is_clone[c] = true;
+                clone_count++;
+                continue;
+            }
+            const BitPlaneSchedule* bits = candidate_bits(c);
+            if (bits ? checkSwitches(*bits) : checkSwitches(candidates[c])) {
+                feasible.push_back(c);
+            }
+        }
+
+        // 多保真模式下只有通过代理筛选的候选做精确评估，种群与档案中只有精确值
+        if (surrogateEnabled()) {
+            feasible = screenCandidates(candidates, candidate_hashes, feasible, num_fireworks + max_sparks_);
+        }
+
+        std::vector<std::vector<std::vector<int>>> valid_candidates;
+        for (size_t c : feasible) {
+            auto eval_result = evaluateHashed(candidates[c], candidate_hashes[c], false, candidate_bits(c));
+            archive_.insert(candidates[c], objectiveVector(eval_result));
+            valid_candidates.push_back(std::move(candidates[c]));
+        }
+
+        // 快速非支配排序
+        auto ranked = fastNonDominatedSort(valid_candidates);
+
+        // 选择下一代
+        std::vector<std::vector<std::vector<int>>> selected;
+        int current_rank = 1;
+
+        while (selected.size() < num_fireworks + max_sparks_ &&
+            ranked.find(current_rank) != ranked.end()) {
+
+            int needed = num_fireworks + max_sparks_ - selected.size();
+            auto& available = ranked[current_rank];
+
+            if (available.size() > needed) {
+                auto selected_from_rank = crowdingSelection(available, needed);
+                selected.insert(selected.end(), selected_from_rank.begin(), selected_from_rank.end());
+            }
+            else {
+                selected.insert(selected.end(), available.begin(), available.end());
+            }
+
+            current_rank++;
+        }
+
+        fireworks = selected;
+        firework_hashes.clear();
+        for (const auto& fw : fireworks) {
+            firework_hashes.push_back(hashSolution(fw));
+        }
+
+        // 算子统计：火花进入下一代记为存活，进入第一前沿另计；克隆、不可行和被代理筛掉的火花回报为 0
+        std::unordered_set<uint64_t> survivor_hashes(firework_hashes.begin(), firework_hashes.end());
+        std::unordered_set<uint64_t> front_hashes;
+        if (ranked.find(1) != ranked.end()) {
+            for (const auto& sol : ranked[1]) {
+                front_hashes.insert(hashSolution(sol));
+            }
+        }
+        for (size_t s = 0; s < spark_info.size(); ++s) {
+            uint64_t hash = spark_info[s].hash;
+            bool survived = !is_clone[size + s] && survivor_hashes.count(hash) > 0;
+            creditSpark(spark_info[s], survived, survived && front_hashes.count(hash) > 0);
+        }
+        endOperatorGeneration();
+
+        // 精英局部搜索：重排得到的解加入下一代种群，由下一轮选择决定去留
+        if (refinementDue(iter) && ranked.find(1) != ranked.end()) {
+            std::vector<uint64_t> refined_hashes;
+            std::vector<EvaluationResult> refined_results;
+            auto refined = refineElites(ranked[1], refine_elites_, refined_hashes, refined_results);
+            fireworks.insert(fireworks.end(),
+                std::make_move_iterator(refined.begin()), std::make_move_iterator(refined.end()));
+            firework_hashes.insert(firework_hashes.end(), refined_hashes.begin(), refined_hashes.end());
+        }
+
+        // 输出进度信息
+        if (iter % 1 == 0) {
+            std::cout << "迭代 " << iter << "/" << max_iter;
+            if (ranked.find(1) != ranked.end() && !ranked[1].empty()) {
+                auto best = ranked[1][0];
+                auto best_eval = evaluate(best, false);
+                std::cout << " - 最佳解: 卫星=" << best_eval.satellite_count
+                    << ", 覆盖率=" << best_eval.coverage / 100 << "%"
+                    << ", 平均每时间片覆盖率=" << best_eval.coverage / problem_->bounds().size()
+                    << ", 方差=" << best_eval.load_variance;
+            }
+            std::cout << ", 克隆=" << clone_count;
+            std::cout << std::endl;
+        }
+
+        if (progress_callback_ && progress_interval_ > 0 && (iter + 1) % progress_interval_ == 0 &&
+            ranked.find(1) != ranked.end()) {
+            progress_callback_(iter, ranked[1]);
+        }
+
+        if (checkpoint_interval_ > 0 && (iter + 1) % checkpoint_interval_ == 0) {
+            saveCheckpoint(fireworks, iter + 1, num_fireworks, max_changes);
+        }
+
+        completed_iterations_++;
+        if (time_budget_ms_ > 0.0 && cpu_timer.elapsedMs() >= time_budget_ms_) {
+            std::cout << "达到 CPU 时间预算 " << time_budget_ms_ << " ms，第 " << iter + 1 << " 次迭代后结束" << std::endl;
+            break;
+        }
+        if (cancel_check_ && cancel_check_()) {
+            std::cout << "优化已取消，第 " << iter + 1 << " 次迭代后结束" << std::endl;
+            break;
+        }
+    }
+
+    // 最终排序
+    auto final_ranking = fastNonDominatedSort(fireworks);
+
+    std::vector<std::vector<std::vector<int>>> best_solutions;
+    if (final_ranking.find(1) != final_ranking.end()) {
+        best_solutions = final_ranking[1];
+    }
+
+    // 历代最优前沿取自外部档案
+    std::vector<std::vector<std::vector<int>>> all_solutions = archive_.solutions();
+
+    std::cout << "优化完成，找到 " << best_solutions.size() << " 个最优解，档案中保存 "
+        << all_solutions.size() << " 个历代非支配解" << std::endl;
+    std::cout << "评估缓存命中 " << getCacheHits() << " 次，实际评估 " << getCacheMisses() << " 次" << std::endl;
+    if (surrogateEnabled()) {
+        std::cout << "代理评估 " << getSurrogateEvaluations() << " 次，其中 " << screened_out_
+            << " 个候选未做精确评估" << std::endl;
+    }
+    printOperatorStats();
+
+    return { best_solutions, all_solutions };
+}
+
+void SatelliteSchedulerMultiObjective::enableCheckpoint(const std::string& path, int interval) {
+    checkpoint_path_ = path;
+    checkpoint_interval_ = interval;
+}
+
+bool SatelliteSchedulerMultiObjective::saveCheckpoint(
+    const std::vector<std::vector<std::vector<int>>>& population,
+    int next_iteration, int num_fireworks, int max_changes) {
+
+    SchedulerCheckpoint ckpt;
+    ckpt.iteration = next_iteration;
+    ckpt.num_fireworks = num_fireworks;
+    ckpt.max_changes = max_changes;
+    ckpt.rows = m_;
+    ckpt.cols = problem_->cols();
+    ckpt.population = population;
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        ckpt.norm_bounds[2 * k] = objective_bounds_[k].min_val;
+        ckpt.norm_bounds[2 * k + 1] = objective_bounds_[k].max_val;
+    }
+    ckpt.archive_gridded = archive_.gridded();
+    ckpt.archive_epsilon = archive_.epsilon();
+    ckpt.archive_entries = archive_.entries();
+    ckpt.rng_state = saveRngState();
+    ckpt.operator_state = saveOperatorState();
+    ckpt.frozen_cols = frozen_cols_;
+    ckpt.frozen_plan = frozen_plan_;
+
+    return ckpt.save(checkpoint_path_);
+}
+
+bool SatelliteSchedulerMultiObjective::resumeFromCheckpoint(const std::string& path) {
+    SchedulerCheckpoint ckpt;
+    if (!ckpt.load(path)) {
+        return false;
+    }
+
+    int cols = problem_->cols();
+    if (ckpt.rows != m_ || ckpt.cols != cols) {
+        std::cerr << "断点与当前问题规模不一致: " << ckpt.rows << "x" << ckpt.cols
+            << " vs " << m_ << "x" << cols << std::endl;
+        return false;
+    }
+
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        objective_bounds_[k] = { ckpt.norm_bounds[2 * k], ckpt.norm_bounds[2 * k + 1] };
+    }
+
+    archive_.restore(ckpt.rows, ckpt.cols, ckpt.archive_gridded, ckpt.archive_epsilon,
+        std::move(ckpt.archive_entries));
+    if (!restoreRngState(ckpt.rng_state)) {
+        std::cerr << "断点中的随机数状态无法识别，沿用当前随机数序列: " << path << std::endl;
+    }
+    if (!restoreOperatorState(ckpt.operator_state)) {
+        std::cerr << "断点中的算子选择状态无法识别，算子概率重新开始学习: " << path << std::endl;
+        resetOperatorStats();
+    }
+    frozen_cols_ = ckpt.frozen_cols;
+    frozen_plan_ = std::move(ckpt.frozen_plan);
+
+    resume_population_ = std::move(ckpt.population);
+    resume_iteration_ = ckpt.iteration;
+    resume_pending_ = true;
+
+    std::cout << "已加载断点: 第 " << ckpt.iteration << " 次迭代, 种群 " << resume_population_.size()
+        << ", 档案 " << archive_.size() << " (烟花数量 " << ckpt.num_fireworks
+        << ", 最大修改数 " << ckpt.max_changes << ")" << std::endl;
+    return true;
+}
+
+void SatelliteSchedulerMultiObjective::setWarmStart(
+    const std::vector<std::vector<std::vector<int>>>& previous_front,
+    const std::vector<int>& previous_bounds, int executed_until, int executed_index) {
+
+    clearFrozenColumns();
+    warm_seeds_.clear();
+
+    if (previous_front.empty()) {
+        return;
+    }
+
+    // 先迁移实际执行的计划并据此冻结已执行列，再迁移其余种子
+    if (executed_until >= 0 && executed_index >= 0 &&
+        executed_index < static_cast<int>(previous_front.size())) {
+        auto executed_plan = migrateSolution(previous_front[executed_index], previous_bounds);
+        setFrozenColumns(executed_until, executed_plan);
+    }
+
+    for (const auto& sol : previous_front) {
+        warm_seeds_.push_back(migrateSolution(sol, previous_bounds));
+    }
+
+    std::cout << "滚动时域热启动: " << warm_seeds_.size() << " 个种子, 冻结 "
+        << getFrozenColumnCount() << " 列" << std::endl;
+}
+
+void SatelliteSchedulerMultiObjective::shiftHorizon(const std::vector<std::vector<int>>& compressed,
+    const std::vector<int>& bounds, const std::vector<std::vector<std::vector<int>>>& previous_front,
+    int executed_until, int executed_index) {
+
+    std::vector<int> previous_bounds = problem_->bounds();
+    setCompressedData(compressed, bounds);
+    setWarmStart(previous_front, previous_bounds, executed_until, executed_index);
+}
+
+void SatelliteSchedulerMultiObjective::applyWindowUpdate(const SatelliteDataLoader& loader,
+    const SatelliteDataLoader::ColumnRemap& remap, const std::vector<std::vector<std::vector<int>>>& previous_front) {
+
+    std::vector<int> previous_bounds = problem_->bounds();
+    attachProblem(problem_->withWindowUpdate(loader, remap));
+    setWarmStart(previous_front, previous_bounds);
+}
+
+ObjectiveVector SatelliteSchedulerMultiObjective::solutionToObjectives(
+    const std::vector<std::vector<int>>& solution) {
+
+    // 最大化目标取负，统一按最小化比较
+    return objectiveVector(evaluate(solution, false));
+}
+
+double SatelliteSchedulerMultiObjective::calculateCrowdingDistance(
+    const std::vector<SolutionWithObjectives>& solutions,
+    int solution_idx, int objective_idx) {
+
+    if (solution_idx == 0 || solution_idx == solutions.size() - 1) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double prev_obj = solutions[solution_idx - 1].objectives[objective_idx];
+    double next_obj = solutions[solution_idx + 1].objectives[objective_idx];
+
+    return next_obj - prev_obj;
 }
\ No newline at end of file
@@ -1,36 +1,123 @@
-#pragma once
-// satellite_scheduler_multiobjective.h
-#pragma once
-#include "satellite_scheduler_fireworks.h"
-
-class SatelliteSchedulerMultiObjective : public SatelliteSchedulerFireworks {
-public:
-    SatelliteSchedulerMultiObjective();
-
-    // ĿŻ
-    std::unordered_map<int, std::vector<std::vector<std::vector<int>>>>
-        fastNonDominatedSort(const std::vector<std::vector<std::vector<int>>>& solutions);
-
-    std::vector<std::vector<std::vector<int>>>
-        crowdingSelection(const std::vector<std::vector<std::vector<int>>>& solutions,
-            int select_num);
-
-    // ֧ϵж
-    bool dominates(const std::vector<double>& obj_a, const std::vector<double>& obj_b);
-
-    // Ż
-    std::pair<std::vector<std::vector<std::vector<int>>>,
-        std::vector<std::vector<std::vector<int>>>>
-        optimize(int max_iter = 100, int num_fireworks = 20, int max_changes = 10);
-
-private:
-    struct SolutionWithObjectives {
-        std::vector<std::vector<int>> solution;
-        std::vector<double> objectives;
-        double crowding_distance = 0.0;
-    };
-
-    std::vector<double> solutionToObjectives(const std::vector<std::vector<int>>& solution);
-    double calculateCrowdingDistance(const std::vector<SolutionWithObjectives>& solutions,
-        int solution_idx, int objective_idx);
+#pragma once
+// satellite_scheduler_multiobjective.h
+#pragma once
+#include "satellite_scheduler_fireworks.h"
+#include "pareto_archive.h"
+#include "scheduler_checkpoint.h"
+#include <functional>
+
+class SatelliteSchedulerMultiObjective : public SatelliteSchedulerFireworks {
+public:
+    SatelliteSchedulerMultiObjective();
+
+    // 多目标优化
+    std::unordered_map<int, std::vector<std::vector<std::vector<int>>>>
+        fastNonDominatedSort(const std::vector<std::vector<std::vector<int>>>& solutions);
+
+    std::vector<std::vector<std::vector<int>>>
+        crowdingSelection(const std::vector<std::vector<std::vector<int>>>& solutions,
+            int select_num);
+
+    // 支配关系判断
+    bool dominates(const ObjectiveVector& obj_a, const ObjectiveVector& obj_b);
+
+    // 完整的优化流程：返回（最终第一前沿, 外部档案中的历代非支配解）
+    // 本类为全局非支配排序 + 拥挤距离选择，其他引擎见 scheduler_factory.h
+    virtual std::pair<std::vector<std::vector<std::vector<int>>>,
+        std::vector<std::vector<std::vector<int>>>>
+        optimize(int max_iter = 100, int num_fireworks = 20, int max_changes = 10);
+
+    // 进度回调：每 interval 次迭代以当代第一前沿调用一次（用于流式返回中间结果）
+    using ProgressCallback = std::function<void(int iteration,
+        const std::vector<std::vector<std::vector<int>>>& front)>;
+    void setProgressCallback(ProgressCallback callback, int interval = 1) {
+        progress_callback_ = std::move(callback);
+        progress_interval_ = interval;
+    }
+
+    // CPU 时间预算（毫秒，按运行 optimize 的线程计）：每次迭代结束后检查，超出即提前结束；0 表示不限制
+    void setTimeBudget(double budget_ms) { time_budget_ms_ = budget_ms; }
+    // 取消检查：每次迭代结束后调用，返回 true 时提前结束（例如结果的接收方已断开）；为空表示不检查
+    void setCancelCheck(std::function<bool()> cancelled) { cancel_check_ = std::move(cancelled); }
+    // 最近一次 optimize 实际完成的迭代次数
+    int getCompletedIterations() const { return completed_iterations_; }
+
+    // 精英局部搜索：每 interval 代取 elites 个第一前沿解，随机选一颗卫星做精确单星重排；elites 为 0 时关闭
+    void setLocalRefinement(int elites, int interval = 1) {
+        refine_elites_ = elites;
+        refine_interval_ = interval;
+    }
+
+    // 外部精英档案（跨代保存所有可行候选中的非支配解）
+    const ParetoArchive& getArchive() const { return archive_; }
+    void setArchiveCapacity(size_t capacity) { archive_.setCapacity(capacity); }
+
+    // 断点续算：每 interval 次迭代保存一次；恢复后下一次 optimize 从断点继续
+    void enableCheckpoint(const std::string& path, int interval = 10);
+    bool resumeFromCheckpoint(const std::string& path);
+
+    // 滚动时域重规划：以上一轮前沿作为种子热启动
+    // previous_bounds 为上一轮的时间轴；原始时间早于 executed_until 的列按 previous_front[executed_index] 冻结
+    void setWarmStart(const std::vector<std::vector<std::vector<int>>>& previous_front,
+        const std::vector<int>& previous_bounds, int executed_until = -1, int executed_index = 0);
+    // 切换到新的时间窗口并保留重叠部分的前沿作为种子
+    void shiftHorizon(const std::vector<std::vector<int>>& compressed, const std::vector<int>& bounds,
+        const std::vector<std::vector<std::vector<int>>>& previous_front, int executed_until = -1,
+        int executed_index = 0);
+    // 增量窗口更新：换用 loader 经 ingestPass 更新后的问题（未变化列的覆盖率模型沿用），
+    // previous_front 迁移为热启动种子
+    void applyWindowUpdate(const SatelliteDataLoader& loader, const SatelliteDataLoader::ColumnRemap& remap,
+        const std::vector<std::vector<std::vector<int>>>& previous_front);
+
+protected:
+    ParetoArchive archive_;
+
+    std::string checkpoint_path_;
+    int checkpoint_interval_ = 0;
+    bool resume_pending_ = false;
+    int resume_iteration_ = 0;
+    std::vector<std::vector<std::vector<int>>> resume_population_;
+    std::vector<std::vector<std::vector<int>>> warm_seeds_;
+
+    ProgressCallback progress_callback_;
+    int progress_interval_ = 1;
+
+    double time_budget_ms_ = 0.0;
+    std::function<bool()> cancel_check_;
+    int completed_iterations_ = 0;
+
+    int refine_elites_ = 4;
+    int refine_interval_ = 1;
+
+    bool saveCheckpoint(const std::vector<std::vector<std::vector<int>>>& population,
+        int next_iteration, int num_fireworks, int max_changes);
+
+    bool refinementDue(int iter) const {
+        return refine_elites_ > 0 && refine_interval_ > 0 && (iter + 1) % refine_interval_ == 0;
+    }
+    // 从 pool 中随机取至多 count 个（可行）解做单星重排，返回与原解不同的可行结果，
+    // 结果已评估并送入外部档案，hashes / results 与返回值一一对应
+    std::vector<std::vector<std::vector<int>>> refineElites(
+        const std::vector<std::vector<std::vector<int>>>& pool, int count,
+        std::vector<uint64_t>& hashes, std::vector<EvaluationResult>& results);
+
+    // 多保真筛选（setSurrogateEvaluation 开启时）：indices 指向的候选先做代理评估，
+    // 保留乐观界不被任何其他候选悲观界支配的候选，即可能进入第一前沿或落在其误差带内的候选；
+    // 不足 keep 个时按被支配次数从少到多补足，保证下一代仍能选满。返回 indices 的子集，顺序不变
+    std::vector<size_t> screenCandidates(const std::vector<std::vector<std::vector<int>>>& candidates,
+        const std::vector<uint64_t>& hashes, const std::vector<size_t>& indices, size_t keep);
+    size_t screened_out_ = 0;   // 最近一次 optimize 中被代理评估筛掉、未做精确评估的候选数
+
+    // 初始种群：断点恢复时取回保存的种群，否则依次使用热启动种子、启发式播种和随机解
+    std::vector<std::vector<std::vector<int>>> initialPopulation(int num_fireworks, int& start_iter);
+
+    struct SolutionWithObjectives {
+        std::vector<std::vector<int>> solution;
+        ObjectiveVector objectives{};
+        double crowding_distance = 0.0;
+    };
+
+    ObjectiveVector solutionToObjectives(const std::vector<std::vector<int>>& solution);
+    double calculateCrowdingDistance(const std::vector<SolutionWithObjectives>& solutions,
+        int solution_idx, int objective_idx);
 };
\ No newline at end of file
@@ -1,247 +1,716 @@
-// satellite_scheduler_solution.cpp
-#include "satellite_scheduler_solution.h"
-#include <numeric>
-#include <algorithm>
-#include <cmath>
-#include <iostream>
-
-std::vector<std::vector<int>> SatelliteSchedulerSolution::initializeSolution() {
-    std::vector<std::vector<int>> solution;
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-
-    for (const auto& sat_schedule : compressed_) {
-        std::vector<int> new_schedule = sat_schedule;
-
-        for (size_t j = 0; j < new_schedule.size(); ++j) {
-            if (new_schedule[j] == 1 && dist(gen_) < 0.3) {
-                new_schedule[j] = 0; // رһЩʱ䴰
-            }
-        }
-
-        solution.push_back(new_schedule);
-    }
-
-    std::cout << "ʼ: " << solution.size() << " " << std::endl;
-    return solution;
-}
-
-std::vector<std::vector<int>> SatelliteSchedulerSolution::copySolution(
-    const std::vector<std::vector<int>>& solution) {
-
-    std::vector<std::vector<int>> copy;
-    for (const auto& sat_schedule : solution) {
-        copy.push_back(sat_schedule);
-    }
-    return copy;
-}
-
-SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::evaluate(
-    const std::vector<std::vector<int>>& solution, bool return_norm) {
-
-    auto raw_result = evaluateRaw(solution);
-
-    if (update_bounds_) {
-        updateBounds(raw_result);
-    }
-
-    if (return_norm) {
-        return normalizeResult(raw_result);
-    }
-
-    return raw_result;
-}
-
-SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::evaluateRaw(
-    const std::vector<std::vector<int>>& solution) {
-
-    EvaluationResult result;
-
-    // Ծ
-    result.satellite_count = 0.0;
-    for (const auto& sat_sched : solution) {
-        bool has_active = std::any_of(sat_sched.begin(), sat_sched.end(),
-            [](int val) { return val == 1; });
-        if (has_active) {
-            result.satellite_count += 1.0;
-        }
-    }
-
-    // ܸ
-    result.coverage = 0.0;
-    for (int j_original : bounds_) {
-        result.coverage += calculateCoverage(solution, j_original);
-    }
-
-    // 㸺ط
-    std::vector<double> active_times;
-    for (const auto& sat_sched : solution) {
-        double active_count = std::count(sat_sched.begin(), sat_sched.end(), 1);
-        active_times.push_back(active_count);
-    }
-    result.load_variance = calculateVariance(active_times);
-
-    return result;
-}
-
-
-
-SatelliteSchedulerSolution::SatelliteSchedulerSolution() {
-    // ʼ߽
-    f1_bounds_ = { std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
-    f2_bounds_ = { std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
-    f3_bounds_ = { std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() };
-}
-
-void SatelliteSchedulerSolution::setCoverageData(const std::map<int, std::vector<double>>& coverage_data) {
-    coverage_data_ = coverage_data;
-    std::cout << "ø: " << coverage_data_.size() << " " << std::endl;
-}
-
-void SatelliteSchedulerSolution::setTimeIndices(const std::vector<std::vector<int>>& time_indices) {
-    idx_ = time_indices;
-    std::cout << "ʱ: " << idx_.size() << " " << std::endl;
-}
-
-double SatelliteSchedulerSolution::calculateCoverage(
-    const std::vector<std::vector<int>>& solution, int j_original) {
-
-    std::vector<bool> combined(q_, false);
-    std::vector<int> active_sats;
-
-    // ҵǰʱԾ
-    auto bounds_it = std::find(bounds_.begin(), bounds_.end(), j_original);
-    if (bounds_it != bounds_.end()) {
-        int comp_idx = std::distance(bounds_.begin(), bounds_it);
-
-        for (int sat = 0; sat < m_; ++sat) {
-            if (solution[sat][comp_idx] == 1) {
-                active_sats.push_back(sat);
-            }
-        }
-    }
-
-    // ǰʱûǵ
-    if (active_sats.empty()) {
-        return 0.0;
-    }
-
-    // ǰʱ1ǵ
-    else if (active_sats.size() == 1) {
-        int sat = active_sats[0];
-
-        // ʱidx_еλ
-        if (sat < idx_.size()) {
-            const auto& sat_indices = idx_[sat];
-            auto time_it = std::find(sat_indices.begin(), sat_indices.end(), j_original);
-
-            if (time_it != sat_indices.end()) {
-                int index = std::distance(sat_indices.begin(), time_it);
-
-                // coverage_data_лȡ
-                auto coverage_it = coverage_data_.find(sat);
-                if (coverage_it != coverage_data_.end() &&
-                    index < coverage_it->second.size()) {
-                    return coverage_it->second[index];
-                }
-            }
-        }
-
-        // ҲӦĸݣ0
-        return 0.0;
-    }
-
-    // ǰʱ2ǵ
-    else {
-        for (int sat : active_sats) {
-            // ʹøʼȡ
-            auto mesh_array = coverage_loader_->getMeshData(
-                sat + 1,  // ǱתΪ1-based
-                j_original,
-                q_);
-
-            // ֵȡ
-            for (int i = 0; i < q_; ++i) {
-                combined[i] = combined[i] || mesh_array[i];
-            }
-        }
-
-        // 㸲ʣtrueռı
-        int coverage_count = 0;
-        for (bool covered : combined) {
-            if (covered) coverage_count++;
-        }
-
-        return static_cast<double>(coverage_count) / q_;
-    }
-}
-
-double SatelliteSchedulerSolution::calculateVariance(const std::vector<double>& data) {
-    if (data.empty()) return 0.0;
-
-    double mean = std::accumulate(data.begin(), data.end(), 0.0) / data.size();
-
-    double variance = 0.0;
-    for (double val : data) {
-        variance += (val - mean) * (val - mean);
-    }
-
-    return variance / data.size();
-}
-
-bool SatelliteSchedulerSolution::checkSwitches(const std::vector<std::vector<int>>& solution) {
-    for (int sat = 0; sat < m_; ++sat) {
-        int switches = 0;
-        const auto& sat_schedule = solution[sat];
-
-        for (size_t j = 1; j < sat_schedule.size(); ++j) {
-            // Чʱ䴰
-            if (sat_schedule[j] == -1 || sat_schedule[j - 1] == -1) {
-                switches = 0;
-                continue;
-            }
-
-            // ״̬л
-            if (sat_schedule[j] != sat_schedule[j - 1]) {
-                switches++;
-                if (switches > max_switches_) {
-                    return false;
-                }
-            }
-        }
-    }
-
-    return true;
-}
-
-void SatelliteSchedulerSolution::updateBounds(const EvaluationResult& result) {
-    f1_bounds_.min_val = std::min(f1_bounds_.min_val, result.satellite_count);
-    f1_bounds_.max_val = std::max(f1_bounds_.max_val, result.satellite_count);
-
-    f2_bounds_.min_val = std::min(f2_bounds_.min_val, result.coverage);
-    f2_bounds_.max_val = std::max(f2_bounds_.max_val, result.coverage);
-
-    f3_bounds_.min_val = std::min(f3_bounds_.min_val, result.load_variance);
-    f3_bounds_.max_val = std::max(f3_bounds_.max_val, result.load_variance);
-}
-
-SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::normalizeResult(
-    const EvaluationResult& result) {
-
-    EvaluationResult norm_result;
-
-    const double epsilon = 1e-10;
-
-    // һС
-    double f1_range = f1_bounds_.max_val - f1_bounds_.min_val + epsilon;
-    norm_result.satellite_count = (result.satellite_count - f1_bounds_.min_val) / f1_range;
-
-    // һʣ󻯣
-    double f2_range = f2_bounds_.max_val - f2_bounds_.min_val + epsilon;
-    norm_result.coverage = (result.coverage - f2_bounds_.min_val) / f2_range;
-
-    // һطС
-    double f3_range = f3_bounds_.max_val - f3_bounds_.min_val + epsilon;
-    norm_result.load_variance = (result.load_variance - f3_bounds_.min_val) / f3_range;
-
-    return norm_result;
+// satellite_scheduler_solution.cpp
+#include "satellite_scheduler_solution.h"
+#include "point_revisit.h"
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+std::vector<std::vector<int>> SatelliteSchedulerSolution::initializeSolution() {
+    std::vector<std::vector<int>> solution;
+
+    for (const auto& sat_schedule : problem_->compressed()) {
+        std::vector<int> new_schedule = sat_schedule;
+
+        for (size_t j = 0; j < new_schedule.size(); ++j) {
+            if (new_schedule[j] == 1 && gen_.bernoulli(0.3)) {
+                new_schedule[j] = 0; // 随机关闭一些时间窗口
+            }
+        }
+
+        solution.push_back(new_schedule);
+    }
+
+    applyFrozenColumns(solution);
+
+    std::cout << "初始化解生成完成: " << solution.size() << " 颗卫星" << std::endl;
+    return solution;
+}
+
+std::vector<std::vector<int>> SatelliteSchedulerSolution::buildHeuristicSolution(
+    SeedHeuristic heuristic, double perturbation) {
+
+    const auto& compressed = problem_->compressed();
+    const auto& bounds = problem_->bounds();
+    int cols = static_cast<int>(bounds.size());
+
+    // 所有可见窗口先置为关闭，并计算单星覆盖率得分
+    std::vector<std::vector<int>> solution(m_);
+    std::vector<std::vector<double>> score(m_, std::vector<double>(cols, 0.0));
+    for (int sat = 0; sat < m_; ++sat) {
+        solution[sat] = compressed[sat];
+        for (int j = 0; j < cols; ++j) {
+            if (solution[sat][j] != -1) {
+                solution[sat][j] = 0;
+                score[sat][j] = singleCoverage(sat, bounds[j]);
+            }
+        }
+    }
+
+    switch (heuristic) {
+    case SeedHeuristic::GreedyCoverageRate: {
+        // 按得分从高到低开启，直到得分低于所有可见窗口的平均值
+        std::vector<std::pair<double, std::pair<int, int>>> cells;
+        double total = 0.0;
+        for (int sat = 0; sat < m_; ++sat) {
+            for (int j = 0; j < cols; ++j) {
+                if (solution[sat][j] != -1) {
+                    cells.push_back({ score[sat][j], { sat, j } });
+                    total += score[sat][j];
+                }
+            }
+        }
+        if (cells.empty()) break;
+
+        double mean = total / cells.size();
+        std::sort(cells.begin(), cells.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (const auto& cell : cells) {
+            if (cell.first < mean) break;
+            solution[cell.second.first][cell.second.second] = 1;
+        }
+        break;
+    }
+
+    case SeedHeuristic::MinSatellites: {
+        // 按总覆盖率从高到低逐颗全开，达到全开覆盖率的 seed_coverage_ratio_ 即停止
+        std::vector<std::pair<double, int>> totals;
+        double grand_total = 0.0;
+        for (int sat = 0; sat < m_; ++sat) {
+            double t = std::accumulate(score[sat].begin(), score[sat].end(), 0.0);
+            totals.push_back({ t, sat });
+            grand_total += t;
+        }
+        std::sort(totals.begin(), totals.end(), std::greater<>());
+
+        double covered = 0.0;
+        for (const auto& entry : totals) {
+            if (covered >= seed_coverage_ratio_ * grand_total || entry.first <= 0.0) break;
+            for (int j = 0; j < cols; ++j) {
+                if (solution[entry.second][j] == 0) {
+                    solution[entry.second][j] = 1;
+                }
+            }
+            covered += entry.first;
+        }
+        break;
+    }
+
+    case SeedHeuristic::BalancedRoundRobin: {
+        // 每颗卫星的开机预算取各卫星可见窗口数的最小值，轮流开启得分最高的剩余窗口
+        std::vector<std::vector<int>> ranked(m_);
+        int budget = std::numeric_limits<int>::max();
+        for (int sat = 0; sat < m_; ++sat) {
+            for (int j = 0; j < cols; ++j) {
+                if (solution[sat][j] != -1) ranked[sat].push_back(j);
+            }
+            std::sort(ranked[sat].begin(), ranked[sat].end(),
+                [&](int a, int b) { return score[sat][a] > score[sat][b]; });
+            if (!ranked[sat].empty()) {
+                budget = std::min(budget, static_cast<int>(ranked[sat].size()));
+            }
+        }
+        if (budget == std::numeric_limits<int>::max()) break;
+
+        for (int round = 0; round < budget; ++round) {
+            for (int sat = 0; sat < m_; ++sat) {
+                if (round < static_cast<int>(ranked[sat].size())) {
+                    solution[sat][ranked[sat][round]] = 1;
+                }
+            }
+        }
+        break;
+    }
+    }
+
+    // 扰动：随机关闭部分已开启窗口，使同一启发式产生的个体互不相同
+    if (perturbation > 0.0) {
+        for (auto& row : solution) {
+            for (auto& cell : row) {
+                if (cell == 1 && gen_.bernoulli(perturbation)) {
+                    cell = 0;
+                }
+            }
+        }
+    }
+
+    // 先恢复冻结列再修复，使冻结前缀与新尾部的衔接处也满足切换约束
+    applyFrozenColumns(solution);
+    repairSwitches(solution);
+    return solution;
+}
+
+void SatelliteSchedulerSolution::repairSwitches(std::vector<std::vector<int>>& solution) {
+    const int limit = std::max(0, max_switches_);
+
+    for (int sat = 0; sat < m_; ++sat) {
+        auto& row = solution[sat];
+        // 冻结列是已执行的前缀，含冻结列的游程不能翻转
+        auto frozen = [&](size_t col) {
+            return static_cast<int>(col) < frozen_cols_ && sat < static_cast<int>(frozen_plan_.size()) &&
+                col < frozen_plan_[sat].size();
+        };
+        size_t j = 0;
+
+        while (j < row.size()) {
+            if (row[j] == -1) {
+                j++;
+                continue;
+            }
+
+            // 与 checkSwitches 一致：切换次数按连续可见段分别计数
+            size_t seg_start = j;
+            while (j < row.size() && row[j] != -1) j++;
+            size_t seg_end = j;
+
+            while (true) {
+                std::vector<std::pair<size_t, size_t>> runs;   // [first, last)
+                for (size_t k = seg_start; k < seg_end; ++k) {
+                    if (k == seg_start || row[k] != row[k - 1]) {
+                        runs.push_back({ k, k + 1 });
+                    }
+                    else {
+                        runs.back().second = k + 1;
+                    }
+                }
+
+                if (static_cast<int>(runs.size()) - 1 <= limit) break;
+
+                // 翻转最短的非冻结游程；同长度时优先内部游程（一次减少两次切换）
+                size_t best = runs.size();
+                for (size_t r = 0; r < runs.size(); ++r) {
+                    if (frozen(runs[r].first)) continue;
+                    if (best == runs.size()) {
+                        best = r;
+                        continue;
+                    }
+                    size_t len = runs[r].second - runs[r].first;
+                    size_t best_len = runs[best].second - runs[best].first;
+                    bool interior = r > 0 && r + 1 < runs.size();
+                    bool best_interior = best > 0 && best + 1 < runs.size();
+                    if (len < best_len || (len == best_len && interior && !best_interior)) {
+                        best = r;
+                    }
+                }
+                // 只剩冻结前缀内的切换，无法继续减少
+                if (best == runs.size()) break;
+
+                int flipped = row[runs[best].first] == 1 ? 0 : 1;
+                for (size_t k = runs[best].first; k < runs[best].second; ++k) {
+                    row[k] = flipped;
+                }
+            }
+        }
+    }
+}
+
+std::vector<std::vector<int>> SatelliteSchedulerSolution::copySolution(
+    const std::vector<std::vector<int>>& solution) {
+
+    std::vector<std::vector<int>> copy;
+    for (const auto& sat_schedule : solution) {
+        copy.push_back(sat_schedule);
+    }
+    return copy;
+}
+
+SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::evaluate(
+    const std::vector<std::vector<int>>& solution, bool return_norm) {
+
+    return evaluateHashed(solution, hashSolution(solution), return_norm);
+}
+
+SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::evaluateHashed(
+    const std::vector<std::vector<int>>& solution, uint64_t hash, bool return_norm, const BitPlaneSchedule* bits) {
+
+    EvaluationResult raw_result;
+
+    // 相同调度只计算一次原始目标值
+    auto cached = eval_cache_.find(hash);
+    if (cached != eval_cache_.end()) {
+        raw_result = cached->second;
+        cache_hits_++;
+    }
+    else {
+        raw_result = evaluateRaw(solution, problem_->packedCoverage(), nullptr, bits);
+        cache_misses_++;
+
+        if (eval_cache_.size() >= eval_cache_capacity_) {
+            eval_cache_.clear();
+        }
+        eval_cache_.emplace(hash, raw_result);
+    }
+
+    if (update_bounds_) {
+        updateBounds(raw_result);
+    }
+
+    if (return_norm) {
+        return normalizeResult(raw_result);
+    }
+
+    return raw_result;
+}
+
+SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::evaluateSurrogate(
+    const std::vector<std::vector<int>>& solution, uint64_t hash, double* coverage_error) {
+
+    auto exact = eval_cache_.find(hash);
+    if (!surrogateEnabled() || exact != eval_cache_.end()) {
+        *coverage_error = 0.0;
+        return evaluateHashed(solution, hash, false);
+    }
+
+    auto cached = surrogate_cache_.find(hash);
+    if (cached != surrogate_cache_.end()) {
+        *coverage_error = cached->second.second;
+        return cached->second.first;
+    }
+
+    // 只有多星列是估计值；各列使用同一组抽样点，误差可能同号，按最坏情况逐列累加
+    const PackedCoverage& model = problem_->surrogateCoverage(surrogate_samples_);
+    int overlap_columns = 0;
+    EvaluationResult result = evaluateRaw(solution, model, &overlap_columns);
+    *coverage_error = surrogate_z_ * model.columnErrorStd() * overlap_columns;
+    surrogate_evaluations_++;
+
+    if (surrogate_cache_.size() >= eval_cache_capacity_) {
+        surrogate_cache_.clear();
+    }
+    surrogate_cache_.emplace(hash, std::make_pair(result, *coverage_error));
+    return result;
+}
+
+SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::evaluateRaw(
+    const std::vector<std::vector<int>>& solution, const PackedCoverage& model, int* overlap_columns,
+    const BitPlaneSchedule* bits) {
+
+    EvaluationResult result;
+
+    // 各卫星开机列数：有位平面时逐字计数，否则扫描整数矩阵
+    std::vector<double> active_times;
+    active_times.reserve(solution.size());
+    for (size_t sat = 0; sat < solution.size(); ++sat) {
+        double active_count = bits ? bits->activeCount(static_cast<int>(sat))
+            : std::count(solution[sat].begin(), solution[sat].end(), 1);
+        active_times.push_back(active_count);
+    }
+
+    // 计算活跃卫星数量
+    result.satellite_count = 0.0;
+    for (double active_count : active_times) {
+        if (active_count > 0.0) {
+            result.satellite_count += 1.0;
+        }
+    }
+
+    // 计算总覆盖率（逐压缩列查表或调用网格并集内核）
+    result.coverage = model.total(solution, overlap_columns);
+
+    // 计算负载方差
+    result.load_variance = calculateVariance(active_times);
+
+    // 其余目标由各自的策略计算，未启用的目标不产生开销
+    const UniqueCoverage* unique = nullptr;
+    if constexpr (ActiveObjectives::kNeedsCellMeshes) {
+        unique = &problem_->uniqueCoverage();
+    }
+    if constexpr (ActiveObjectives::kNeedsBitPlane) {
+        if (bits) {
+            ActiveObjectives::measure({ solution, problem_->layout(), bits, problem_->bounds(), unique }, result);
+        }
+        else {
+            BitPlaneSchedule encoded = BitPlaneSchedule::encode(problem_->layout(), solution);
+            ActiveObjectives::measure({ solution, problem_->layout(), &encoded, problem_->bounds(), unique }, result);
+        }
+    }
+    else {
+        ActiveObjectives::measure({ solution, problem_->layout(), nullptr, problem_->bounds(), unique }, result);
+    }
+
+    return result;
+}
+
+
+
+SatelliteSchedulerSolution::SatelliteSchedulerSolution() {
+    // 初始化边界；新增目标的权重默认为 0（只参与支配排序）
+    resetBounds();
+    weights_.resize(ActiveObjectives::N, 0.0);
+}
+
+void SatelliteSchedulerSolution::resetBounds() {
+    objective_bounds_.fill({ std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest() });
+}
+
+void SatelliteSchedulerSolution::setCoverageData(const std::map<int, std::vector<double>>& coverage_data) {
+    problem_ = problem_->withCoverageData(coverage_data);
+    clearEvaluationCache();
+    std::cout << "设置覆盖率数据: " << coverage_data.size() << " 颗卫星" << std::endl;
+}
+
+void SatelliteSchedulerSolution::setTimeIndices(const std::vector<std::vector<int>>& time_indices) {
+    problem_ = problem_->withTimeIndices(time_indices);
+    clearEvaluationCache();
+    std::cout << "设置时间索引: " << time_indices.size() << " 颗卫星" << std::endl;
+}
+
+void SatelliteSchedulerSolution::loadProblem(const SatelliteDataLoader& loader) {
+    // 直接使用内存中的压缩数据，不再从文件读回
+    attachProblem(SchedulingProblem::create(loader.getCompressedMatrix(), loader.getBounds(),
+        loader.getCoverageData(), loader.getTimeIndices()));
+    initializeCoverageLoader();
+}
+
+uint64_t SatelliteSchedulerSolution::hashSolution(const std::vector<std::vector<int>>& solution) {
+    int cols = problem_->cols();
+    if (!hasher_.matches(m_, cols)) {
+        hasher_.initialize(m_, cols);
+        eval_cache_.clear();
+        surrogate_cache_.clear();
+    }
+
+    return hasher_.hash(solution);
+}
+
+void SatelliteSchedulerSolution::clearEvaluationCache() {
+    eval_cache_.clear();
+    surrogate_cache_.clear();
+    surrogate_evaluations_ = 0;
+    cache_hits_ = 0;
+    cache_misses_ = 0;
+}
+
+void SatelliteSchedulerSolution::onProblemChanged() {
+    // 时间轴变化后旧的缓存、归一化边界和冻结列均失效
+    clearEvaluationCache();
+    resetBounds();
+    clearFrozenColumns();
+}
+
+void SatelliteSchedulerSolution::onCoverageLoaderChanged() {
+    // 网格数据来源变化，已缓存的覆盖率失效（打包模型随新问题重建）
+    clearEvaluationCache();
+}
+
+std::vector<std::vector<int>> SatelliteSchedulerSolution::migrateSolution(
+    const std::vector<std::vector<int>>& solution, const std::vector<int>& old_bounds) {
+
+    std::vector<std::vector<int>> migrated(m_);
+    const auto& bounds = problem_->bounds();
+
+    for (int sat = 0; sat < m_; ++sat) {
+        const auto& visible = problem_->compressed()[sat];
+        auto& row = migrated[sat];
+        row.assign(visible.size(), -1);
+
+        // bounds 均按时间升序排列，双指针对齐重叠部分
+        size_t k = 0;
+        for (size_t j = 0; j < bounds.size(); ++j) {
+            if (visible[j] == -1) {
+                continue;
+            }
+
+            while (k < old_bounds.size() && old_bounds[k] < bounds[j]) {
+                k++;
+            }
+
+            bool overlapped = k < old_bounds.size() && old_bounds[k] == bounds[j] &&
+                sat < static_cast<int>(solution.size()) && solution[sat][k] != -1;
+
+            if (overlapped) {
+                row[j] = solution[sat][k];
+            }
+            else {
+                // 新增尾部与 initializeSolution 相同：随机关闭 30% 的可见窗口
+                row[j] = gen_.bernoulli(0.3) ? 0 : 1;
+            }
+        }
+    }
+
+    applyFrozenColumns(migrated);
+    return migrated;
+}
+
+void SatelliteSchedulerSolution::setFrozenColumns(int executed_until,
+    const std::vector<std::vector<int>>& executed_plan) {
+
+    const auto& bounds = problem_->bounds();
+    frozen_cols_ = static_cast<int>(std::lower_bound(bounds.begin(), bounds.end(), executed_until) - bounds.begin());
+    frozen_plan_.assign(m_, std::vector<int>());
+
+    for (int sat = 0; sat < m_ && sat < static_cast<int>(executed_plan.size()); ++sat) {
+        frozen_plan_[sat].assign(executed_plan[sat].begin(), executed_plan[sat].begin() + frozen_cols_);
+    }
+}
+
+void SatelliteSchedulerSolution::clearFrozenColumns() {
+    frozen_cols_ = 0;
+    frozen_plan_.clear();
+}
+
+void SatelliteSchedulerSolution::applyFrozenColumns(std::vector<std::vector<int>>& solution, uint64_t* hash,
+    BitPlaneSchedule* bits) {
+    if (frozen_cols_ == 0) {
+        return;
+    }
+
+    for (int sat = 0; sat < m_; ++sat) {
+        const auto& plan = frozen_plan_[sat];
+        for (int j = 0; j < frozen_cols_ && j < static_cast<int>(plan.size()); ++j) {
+            if (solution[sat][j] != plan[j]) {
+                setCell(solution, hash, sat, j, plan[j], bits);
+            }
+        }
+    }
+}
+
+double SatelliteSchedulerSolution::calculateCoverage(
+    const std::vector<std::vector<int>>& solution, int j_original) {
+
+    const auto& bounds = problem_->bounds();
+    auto bounds_it = std::find(bounds.begin(), bounds.end(), j_original);
+    if (bounds_it == bounds.end()) {
+        return 0.0;
+    }
+
+    return problem_->packedCoverage().column(solution, static_cast<int>(std::distance(bounds.begin(), bounds_it)));
+}
+
+double SatelliteSchedulerSolution::calculateVariance(const std::vector<double>& data) {
+    if (data.empty()) return 0.0;
+
+    double mean = std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+
+    double variance = 0.0;
+    for (double val : data) {
+        variance += (val - mean) * (val - mean);
+    }
+
+    return variance / data.size();
+}
+
+std::vector<double> SatelliteSchedulerSolution::marginalCoverage(
+    const std::vector<std::vector<int>>& solution, int sat) {
+
+    const auto& model = problem_->packedCoverage();
+    std::vector<double> gains(solution[sat].size(), 0.0);
+    auto scratch = solution;
+    auto& row = scratch[sat];
+
+    for (size_t j = 0; j < row.size(); ++j) {
+        if (row[j] == -1) {
+            continue;
+        }
+        int original = row[j];
+        row[j] = 1;
+        double with_sat = model.column(scratch, static_cast<int>(j));
+        row[j] = 0;
+        double without_sat = model.column(scratch, static_cast<int>(j));
+        row[j] = original;
+        gains[j] = with_sat - without_sat;
+    }
+    return gains;
+}
+
+std::vector<double> SatelliteSchedulerSolution::marginalUniqueCoverage(
+    const std::vector<std::vector<int>>& solution, int sat) {
+
+    const UniqueCoverage& model = problem_->uniqueCoverage();
+    UniqueCoverage::Counter counter(model);
+    counter.assign(solution);
+
+    std::vector<double> gains(solution[sat].size(), 0.0);
+    double scale = model.q() > 0 ? 1.0 / model.q() : 0.0;
+    for (size_t j = 0; j < gains.size(); ++j) {
+        int col = static_cast<int>(j);
+        if (solution[sat][j] == 1) {
+            gains[j] = counter.loss(sat, col) * scale;
+        }
+        else if (solution[sat][j] == 0) {
+            gains[j] = counter.gain(sat, col) * scale;
+        }
+    }
+    return gains;
+}
+
+std::vector<double> SatelliteSchedulerSolution::refinementGains(
+    const std::vector<std::vector<int>>& solution, int sat) {
+
+    if constexpr (!ActiveObjectives::contains<UniqueCoverageObjective>()) {
+        return marginalCoverage(solution, sat);
+    }
+    else {
+        auto unique = marginalUniqueCoverage(solution, sat);
+        if constexpr (!ActiveObjectives::contains<CoverageObjective>()) {
+            return unique;
+        }
+        else {
+            auto gains = marginalCoverage(solution, sat);
+            auto positiveMean = [](const std::vector<double>& values) {
+                double sum = 0.0;
+                int count = 0;
+                for (double v : values) {
+                    if (v > 0.0) {
+                        sum += v;
+                        count++;
+                    }
+                }
+                return count > 0 ? sum / count : 0.0;
+            };
+            double coverage_mean = positiveMean(gains);
+            double unique_mean = positiveMean(unique);
+            double scale = unique_mean > 0.0 && coverage_mean > 0.0 ? coverage_mean / unique_mean : 1.0;
+            for (size_t j = 0; j < gains.size(); ++j) {
+                gains[j] += scale * unique[j];
+            }
+            return gains;
+        }
+    }
+}
+
+void SatelliteSchedulerSolution::reportPointRevisit(const std::vector<std::vector<std::vector<int>>>& front,
+    std::ostream& out) {
+    PointRevisitGap::report(problem_->uniqueCoverage(), problem_->bounds(), front, out);
+}
+
+bool SatelliteSchedulerSolution::refineSatellite(std::vector<std::vector<int>>& solution, int sat,
+    const std::vector<double>& gains, double column_cost, uint64_t* hash) {
+
+    // checkSwitches 在不可见列处清零计数，因此各可见段相互独立，分别求解
+    const int limit = std::max(0, max_switches_);
+    const double unreachable = std::numeric_limits<double>::lowest();
+    bool changed = false;
+
+    for (const auto& segment : problem_->layout().segments(sat)) {
+        int first = segment.first;
+        int length = segment.second - segment.first + 1;
+
+        // best[j][k][v]: 段内前 j 列、已用 k 次开关、第 j 列状态为 v 时的最大收益
+        std::vector<double> best(static_cast<size_t>(length) * (limit + 1) * 2, unreachable);
+        std::vector<int8_t> from(best.size(), -1);
+        auto at = [limit](int j, int k, int v) { return (static_cast<size_t>(j) * (limit + 1) + k) * 2 + v; };
+        auto allowed = [&](int j, int v) {
+            int col = first + j;
+            if (col < frozen_cols_ && sat < static_cast<int>(frozen_plan_.size()) &&
+                col < static_cast<int>(frozen_plan_[sat].size())) {
+                return frozen_plan_[sat][col] == v;
+            }
+            return true;
+        };
+        auto reward = [&](int j, int v) { return v == 1 ? gains[first + j] - column_cost : 0.0; };
+
+        for (int v = 0; v < 2; ++v) {
+            if (allowed(0, v)) {
+                best[at(0, 0, v)] = reward(0, v);
+            }
+        }
+        for (int j = 1; j < length; ++j) {
+            for (int k = 0; k <= limit; ++k) {
+                for (int pv = 0; pv < 2; ++pv) {
+                    double prev = best[at(j - 1, k, pv)];
+                    if (prev == unreachable) continue;
+                    for (int v = 0; v < 2; ++v) {
+                        int nk = k + (v != pv);
+                        if (nk > limit || !allowed(j, v)) continue;
+                        double value = prev + reward(j, v);
+                        if (value > best[at(j, nk, v)]) {
+                            best[at(j, nk, v)] = value;
+                            from[at(j, nk, v)] = static_cast<int8_t>(pv);
+                        }
+                    }
+                }
+            }
+        }
+
+        int end_k = -1;
+        int end_v = 0;
+        for (int k = 0; k <= limit; ++k) {
+            for (int v = 0; v < 2; ++v) {
+                if (best[at(length - 1, k, v)] == unreachable) continue;
+                if (end_k < 0 || best[at(length - 1, k, v)] > best[at(length - 1, end_k, end_v)]) {
+                    end_k = k;
+                    end_v = v;
+                }
+            }
+        }
+        if (end_k < 0) {
+            continue;
+        }
+
+        // 回溯写回
+        int k = end_k;
+        int v = end_v;
+        for (int j = length - 1; j >= 0; --j) {
+            if (solution[sat][first + j] != v) {
+                setCell(solution, hash, sat, first + j, v);
+                changed = true;
+            }
+            if (j > 0) {
+                int pv = from[at(j, k, v)];
+                k -= (v != pv);
+                v = pv;
+            }
+        }
+    }
+
+    return changed;
+}
+
+bool SatelliteSchedulerSolution::checkSwitches(const std::vector<std::vector<int>>& solution) {
+    for (int sat = 0; sat < m_; ++sat) {
+        int switches = 0;
+        const auto& sat_schedule = solution[sat];
+
+        for (size_t j = 1; j < sat_schedule.size(); ++j) {
+            // 跳过无效时间窗口
+            if (sat_schedule[j] == -1 || sat_schedule[j - 1] == -1) {
+                switches = 0;
+                continue;
+            }
+
+            // 检查状态切换
+            if (sat_schedule[j] != sat_schedule[j - 1]) {
+                switches++;
+                if (switches > max_switches_) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SatelliteSchedulerSolution::checkSwitches(const BitPlaneSchedule& bits) {
+    return bits.withinSwitchLimit(problem_->layout(), max_switches_);
+}
+
+void SatelliteSchedulerSolution::updateBounds(const EvaluationResult& result) {
+    auto values = ActiveObjectives::raw(result);
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        objective_bounds_[k].min_val = std::min(objective_bounds_[k].min_val, values[k]);
+        objective_bounds_[k].max_val = std::max(objective_bounds_[k].max_val, values[k]);
+    }
+}
+
+SatelliteSchedulerSolution::EvaluationResult SatelliteSchedulerSolution::normalizeResult(
+    const EvaluationResult& result) {
+
+    EvaluationResult norm_result;
+
+    const double epsilon = 1e-10;
+
+    // 各目标按原始方向归一化，方向在计算适应度时处理
+    auto values = ActiveObjectives::raw(result);
+    for (int k = 0; k < ActiveObjectives::N; ++k) {
+        double range = objective_bounds_[k].max_val - objective_bounds_[k].min_val + epsilon;
+        values[k] = (values[k] - objective_bounds_[k].min_val) / range;
+    }
+    ActiveObjectives::assign(norm_result, values);
+
+    return norm_result;
 }
\ No newline at end of file
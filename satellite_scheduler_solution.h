@@ -1,53 +1,196 @@
-#pragma once
-// satellite_scheduler_solution.h
-#include "satellite_scheduler_base.h"
-#include <map>
-#include <vector>
-
-class SatelliteSchedulerSolution : public SatelliteSchedulerBase {
-public:
-    SatelliteSchedulerSolution();
-
-    // ݷ
-    void setCoverageData(const std::map<int, std::vector<double>>& coverage_data);
-    void setTimeIndices(const std::vector<std::vector<int>>& time_indices);
-
-    // 
-    std::vector<std::vector<int>> initializeSolution();
-    std::vector<std::vector<int>> copySolution(const std::vector<std::vector<int>>& solution);
-
-    // 
-    struct EvaluationResult {
-        double satellite_count;
-        double coverage;
-        double load_variance;
-    };
-
-    EvaluationResult evaluate(const std::vector<std::vector<int>>& solution, bool return_norm = true);
-
-    // Լ
-    bool checkSwitches(const std::vector<std::vector<int>>& solution);
-
-protected:
-    // ʼ - ޸Ϊ޲汾
-    double calculateCoverage(const std::vector<std::vector<int>>& solution, int j_original);
-
-    // 
-    EvaluationResult evaluateRaw(const std::vector<std::vector<int>>& solution);
-    double calculateVariance(const std::vector<double>& data);
-
-    // ݳԱ
-    std::map<int, std::vector<double>> coverage_data_;  // ÿǵĸ
-    std::vector<std::vector<int>> idx_;                 // ʱ
-
-    // һ߽
-    struct NormBounds {
-        double min_val = 0.0;
-        double max_val = 1.0;
-    };
-
-    NormBounds f1_bounds_, f2_bounds_, f3_bounds_;
-
-    void updateBounds(const EvaluationResult& result);
-    EvaluationResult normalizeResult(const EvaluationResult& result);
+#pragma once
+// satellite_scheduler_solution.h
+#include "satellite_scheduler_base.h"
+#include "solution_hash.h"
+#include "bitplane_schedule.h"
+#include "objective_policies.h"
+#include "satellite_data_loader.h"
+#include <array>
+#include <map>
+#include <ostream>
+#include <vector>
+#include <unordered_map>
+
+class SatelliteSchedulerSolution : public SatelliteSchedulerBase {
+public:
+    SatelliteSchedulerSolution();
+
+    // 设置数据方法
+    void setCoverageData(const std::map<int, std::vector<double>>& coverage_data);
+    void setTimeIndices(const std::vector<std::vector<int>>& time_indices);
+    // 从已加载的数据加载器中取出完整问题（压缩矩阵、覆盖率、时间索引）并初始化网格数据
+    void loadProblem(const SatelliteDataLoader& loader);
+
+    // 解决方案操作
+    std::vector<std::vector<int>> initializeSolution();
+    std::vector<std::vector<int>> copySolution(const std::vector<std::vector<int>>& solution);
+
+    // 启发式构造解（用于种群播种），均满足 max_switches_ 约束
+    enum class SeedHeuristic {
+        GreedyCoverageRate,     // 贪心：保留单位开机时间覆盖率高的窗口
+        MinSatellites,          // 覆盖率达到阈值所需的最少卫星
+        BalancedRoundRobin      // 轮转分配，各卫星开机时长均衡
+    };
+    std::vector<std::vector<int>> buildHeuristicSolution(SeedHeuristic heuristic, double perturbation = 0.0);
+    void repairSwitches(std::vector<std::vector<int>>& solution);
+    void setSeeding(double seed_fraction, double coverage_ratio = 0.8) {
+        seed_fraction_ = seed_fraction;
+        seed_coverage_ratio_ = coverage_ratio;
+    }
+
+    // 评估函数（目标集合见 objective_policies.h 中的 ActiveObjectives）
+    using EvaluationResult = ScheduleMetrics;
+
+    EvaluationResult evaluate(const std::vector<std::vector<int>>& solution, bool return_norm = true);
+    // 已知哈希时直接查询评估缓存，避免重复计算哈希；bits 为与 solution 同步的位平面时目标值直接在掩码上计算
+    EvaluationResult evaluateHashed(const std::vector<std::vector<int>>& solution, uint64_t hash,
+        bool return_norm = true, const BitPlaneSchedule* bits = nullptr);
+
+    // 原始评估结果 -> 最小化意义下的目标向量
+    ObjectiveVector objectiveVector(const EvaluationResult& result) const {
+        return ActiveObjectives::minimized(result);
+    }
+
+    // 多保真评估：覆盖率先在 samples 个分层抽样网格点上估计，误差界取 z 倍标准差上界；samples <= 0 关闭
+    void setSurrogateEvaluation(int samples, double z = 3.0) {
+        surrogate_samples_ = samples;
+        surrogate_z_ = z;
+        surrogate_cache_.clear();
+    }
+    bool surrogateEnabled() const { return surrogate_samples_ > 0 && surrogate_samples_ < problem_->q(); }
+    // 代理评估（原始值）：已有精确结果时直接返回，*coverage_error 为 0；
+    // 否则覆盖率为估计值，真实值以高概率落在 ±*coverage_error 之内。不更新归一化边界
+    EvaluationResult evaluateSurrogate(const std::vector<std::vector<int>>& solution, uint64_t hash,
+        double* coverage_error);
+    // 覆盖率改变 coverage_delta 后的目标向量：+误差为乐观界，-误差为悲观界
+    ObjectiveVector objectiveBound(EvaluationResult result, double coverage_delta) const {
+        result.coverage += coverage_delta;
+        return ActiveObjectives::minimized(result);
+    }
+    size_t getSurrogateEvaluations() const { return surrogate_evaluations_; }
+
+    // 解哈希与评估缓存
+    uint64_t hashSolution(const std::vector<std::vector<int>>& solution);
+    void clearEvaluationCache();
+    void setEvaluationCacheCapacity(size_t capacity) { eval_cache_capacity_ = capacity; }
+    size_t getCacheHits() const { return cache_hits_; }
+    size_t getCacheMisses() const { return cache_misses_; }
+
+    // 单星精确重排（局部搜索）
+    // 其他卫星固定时，卫星 sat 在各压缩列开机相对关机的覆盖率增量；不可见列为 0
+    std::vector<double> marginalCoverage(const std::vector<std::vector<int>>& solution, int sat);
+    // 同上，取去重覆盖率的增量：由 UniqueCoverage::Counter 一次建立计数后，每列只需查询一次（网格字数 x 计数平面数）
+    std::vector<double> marginalUniqueCoverage(const std::vector<std::vector<int>>& solution, int sat);
+    // 精修使用的列收益：目标集不含去重覆盖率时即 marginalCoverage；同时含两者时，
+    // 去重增量按两者正增量的均值之比缩放后与覆盖率增量相加
+    std::vector<double> refinementGains(const std::vector<std::vector<int>>& solution, int sat);
+
+    // 前沿的逐网格点重访间隔报告（见 PointRevisitGap::report）；不论是否启用相应目标都可调用，首次调用时加载逐单元网格
+    void reportPointRevisit(const std::vector<std::vector<std::vector<int>>>& front, std::ostream& out);
+    // 对卫星 sat 的每个连续可见段做动态规划（状态为已用开关次数与当前开关状态），
+    // 在不超过 max_switches_ 的前提下最大化 Σ(开机列的 gains - column_cost)；冻结列保持不变
+    // hash 非空时随修改增量更新；返回是否有列被改动
+    bool refineSatellite(std::vector<std::vector<int>>& solution, int sat, const std::vector<double>& gains,
+        double column_cost, uint64_t* hash = nullptr);
+
+    // 约束检查；位平面版本用于随 explode 同步维护的火花
+    bool checkSwitches(const std::vector<std::vector<int>>& solution);
+    bool checkSwitches(const BitPlaneSchedule& bits);
+
+    // 滚动时域：按原始时间点把旧时间轴上的解迁移到当前压缩列，新增列按初始化规则生成
+    std::vector<std::vector<int>> migrateSolution(const std::vector<std::vector<int>>& solution,
+        const std::vector<int>& old_bounds);
+
+    // 冻结原始时间早于 executed_until 的列（已执行部分），取值来自实际执行的计划
+    void setFrozenColumns(int executed_until, const std::vector<std::vector<int>>& executed_plan);
+    void clearFrozenColumns();
+    int getFrozenColumnCount() const { return frozen_cols_; }
+
+protected:
+    // 修改单元并同步更新哈希与位平面
+    void setCell(std::vector<std::vector<int>>& solution, uint64_t* hash, int sat, int col, int value,
+        BitPlaneSchedule* bits = nullptr) {
+        if (hash) {
+            hasher_.update(*hash, sat, col, solution[sat][col], value);
+        }
+        if (bits) {
+            bits->set(sat, col, value == 1);
+        }
+        solution[sat][col] = value;
+    }
+
+    // 将卫星 sat 的 [first, last] 列置为 value（0 或 1）；有位平面时按掩码找出取值改变的列，只改写这些列
+    void setRange(std::vector<std::vector<int>>& solution, uint64_t* hash, BitPlaneSchedule* bits,
+        int sat, int first, int last, int value) {
+        if (!bits) {
+            for (int k = first; k <= last; ++k) {
+                setCell(solution, hash, sat, k, value);
+            }
+            return;
+        }
+        bits->assignRange(sat, first, last, value == 1, [&](int col) {
+            if (hash) {
+                hasher_.update(*hash, sat, col, solution[sat][col], value);
+            }
+            solution[sat][col] = value;
+        });
+    }
+
+    // 将冻结列恢复为已执行计划
+    void applyFrozenColumns(std::vector<std::vector<int>>& solution, uint64_t* hash = nullptr,
+        BitPlaneSchedule* bits = nullptr);
+
+    // 覆盖率计算 - 修改为无参数版本
+    double calculateCoverage(const std::vector<std::vector<int>>& solution, int j_original);
+
+    // 单颗卫星在原始时间点 j_original 的覆盖率
+    double singleCoverage(int sat, int j_original) const {
+        return problem_->singleCoverage(sat, j_original);
+    }
+
+    // 评估辅助函数；overlap_columns 非空时返回多星列个数，bits 非空时不再从整数矩阵编码
+    EvaluationResult evaluateRaw(const std::vector<std::vector<int>>& solution,
+        const PackedCoverage& model, int* overlap_columns = nullptr, const BitPlaneSchedule* bits = nullptr);
+    double calculateVariance(const std::vector<double>& data);
+
+    // 归一化边界
+    struct NormBounds {
+        double min_val = 0.0;
+        double max_val = 1.0;
+    };
+
+    std::array<NormBounds, ActiveObjectives::N> objective_bounds_;
+
+    // Zobrist 哈希与按哈希索引的原始目标值缓存
+    ZobristHasher hasher_;
+    std::unordered_map<uint64_t, EvaluationResult> eval_cache_;
+    size_t eval_cache_capacity_ = 1 << 16;
+    size_t cache_hits_ = 0;
+    size_t cache_misses_ = 0;
+
+    // 代理评估：样本数、误差界倍数，以及按哈希缓存的 (代理结果, 覆盖率误差界)
+    int surrogate_samples_ = 0;
+    double surrogate_z_ = 3.0;
+    std::unordered_map<uint64_t, std::pair<EvaluationResult, double>> surrogate_cache_;
+    size_t surrogate_evaluations_ = 0;
+
+    // 种群播种参数：启发式个体占比、最少卫星启发式的覆盖率阈值（相对全开）
+    double seed_fraction_ = 0.3;
+    double seed_coverage_ratio_ = 0.8;
+
+    // 冻结的已执行列（压缩列前缀）
+    int frozen_cols_ = 0;
+    std::vector<std::vector<int>> frozen_plan_;
+
+    void onProblemChanged() override;
+    void onCoverageLoaderChanged() override;
+    void resetBounds();
+
+    void updateBounds(const EvaluationResult& result);
+    EvaluationResult normalizeResult(const EvaluationResult& result);
+
+    // 归一化评估结果的加权适应度（越大越好）
+    double fitnessValue(const EvaluationResult& normalized) const {
+        return ActiveObjectives::fitness(normalized, weights_.data());
+    }
 };
\ No newline at end of file
@@ -0,0 +1,188 @@
+// scenario_runner.cpp
+#include "scenario_runner.h"
+#include "thread_cpu_timer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+ScenarioRunner::ScenarioRunner(SchedulingProblem::Ptr problem, int threads)
+    : problem_(std::move(problem)) {
+
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threads_ = std::max(1, threads);
+}
+
+std::vector<ScenarioResult> ScenarioRunner::run(const std::vector<SchedulingScenario>& scenarios) const {
+    std::vector<ScenarioResult> results(scenarios.size());
+    if (scenarios.empty()) {
+        return results;
+    }
+
+    // 打包覆盖率模型在启动工作线程前构建，避免首个场景独占构建耗时
+    problem_->packedCoverage();
+
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]() {
+        for (size_t i = next++; i < scenarios.size(); i = next++) {
+            results[i] = runScenario(scenarios[i]);
+        }
+    };
+
+    int workers = std::min<int>(threads_, static_cast<int>(scenarios.size()));
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int t = 1; t < workers; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    return results;
+}
+
+ScenarioResult ScenarioRunner::runScenario(const SchedulingScenario& scenario) const {
+    ScenarioResult result;
+    result.name = scenario.name;
+
+    try {
+        auto engine = createScheduler(scenario.engine);
+        auto& scheduler = *engine;
+        if (configure_) {
+            configure_(scheduler);
+        }
+        if (!scenario.weights.empty()) {
+            scheduler.setWeights(scenario.weights);
+        }
+        if (scenario.max_switches >= 0) {
+            scheduler.setMaxSwitches(scenario.max_switches);
+        }
+        if (scenario.max_sparks >= 0) {
+            scheduler.setMaxSparks(scenario.max_sparks);
+        }
+        if (scenario.max_length >= 0) {
+            scheduler.setMaxLength(scenario.max_length);
+        }
+        if (scenario.max_variation >= 0) {
+            scheduler.setMaxVariation(scenario.max_variation);
+        }
+        scheduler.setTimeBudget(scenario.time_budget_ms);
+        if (scenario.seed >= 0) {
+            scheduler.setRandomSeed(static_cast<uint64_t>(scenario.seed));
+        }
+
+        // 屏蔽卫星只复制可见性矩阵，网格和打包模型仍与原问题共享
+        scheduler.attachProblem(scenario.unavailable_satellites.empty() ? problem_ :
+            problem_->withoutSatellites(scenario.unavailable_satellites));
+
+        PerfCounters counters;
+        counters.start();
+        auto start = std::chrono::steady_clock::now();
+        ThreadCpuTimer cpu_timer;
+        auto solutions = scheduler.optimize(scenario.max_iter, scenario.num_fireworks, scenario.max_changes);
+        result.elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        result.cpu_ms = cpu_timer.elapsedMs();
+        result.counts = counters.stop();
+        result.iterations = scheduler.getCompletedIterations();
+
+        result.front = std::move(solutions.first);
+        result.metrics.reserve(result.front.size());
+        for (const auto& sol : result.front) {
+            result.metrics.push_back(scheduler.evaluate(sol, false));
+        }
+        result.ok = true;
+    }
+    catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    return result;
+}
+
+namespace {
+    template <typename T>
+    std::vector<T> parseList(const std::string& text) {
+        std::vector<T> values;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (!item.empty()) {
+                std::stringstream is(item);
+                T value;
+                if (is >> value) values.push_back(value);
+            }
+        }
+        return values;
+    }
+}
+
+bool ScenarioRunner::loadScenarios(const std::string& path, std::vector<SchedulingScenario>& scenarios) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "无法打开场景文件: " << path << std::endl;
+        return false;
+    }
+
+    scenarios.clear();
+    std::string line;
+    int line_no = 0;
+    while (std::getline(file, line)) {
+        line_no++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        std::stringstream ss(line);
+        SchedulingScenario scenario;
+        if (!(ss >> scenario.name) || scenario.name[0] == '#') {
+            continue;
+        }
+
+        std::string token;
+        while (ss >> token) {
+            auto eq = token.find('=');
+            if (eq == std::string::npos) {
+                std::cerr << "场景文件第 " << line_no << " 行格式错误: " << token << std::endl;
+                return false;
+            }
+            std::string key = token.substr(0, eq);
+            std::string value = token.substr(eq + 1);
+
+            try {
+                if (key == "weights") scenario.weights = parseList<double>(value);
+                else if (key == "unavailable") scenario.unavailable_satellites = parseList<int>(value);
+                else if (key == "max_switches") scenario.max_switches = std::stoi(value);
+                else if (key == "max_iter") scenario.max_iter = std::stoi(value);
+                else if (key == "num_fireworks") scenario.num_fireworks = std::stoi(value);
+                else if (key == "max_changes") scenario.max_changes = std::stoi(value);
+                else if (key == "max_sparks") scenario.max_sparks = std::stoi(value);
+                else if (key == "max_length") scenario.max_length = std::stoi(value);
+                else if (key == "max_variation") scenario.max_variation = std::stoi(value);
+                else if (key == "time_budget_ms") scenario.time_budget_ms = std::stod(value);
+                else if (key == "seed") scenario.seed = std::stoll(value);
+                else if (key == "engine") {
+                    if (!parseOptimizerEngine(value, scenario.engine)) {
+                        std::cerr << "场景文件第 " << line_no << " 行未知引擎: " << value << std::endl;
+                        return false;
+                    }
+                }
+                else {
+                    std::cerr << "场景文件第 " << line_no << " 行未知参数: " << key << std::endl;
+                    return false;
+                }
+            }
+            catch (const std::exception&) {
+                std::cerr << "场景文件第 " << line_no << " 行参数值无效: " << token << std::endl;
+                return false;
+            }
+        }
+        scenarios.push_back(scenario);
+    }
+
+    return true;
+}
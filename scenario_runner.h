@@ -0,0 +1,69 @@
+#pragma once
+// scenario_runner.h
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "scheduler_factory.h"
+#include "perf_counters.h"
+
+// 一个调度场景：在同一问题上改变权重、开关机次数上限或可用卫星
+struct SchedulingScenario {
+    std::string name;
+    std::vector<double> weights;                // 空表示默认权重
+    int max_switches = -1;                      // 小于 0 表示默认值
+    std::vector<int> unavailable_satellites;    // 不可用的卫星（0-based），其窗口全部视为不可见
+    int max_iter = 100;
+    int num_fireworks = 20;
+    int max_changes = 10;
+
+    // 烟花算法参数，小于 0 表示默认值
+    int max_sparks = -1;
+    int max_length = -1;
+    int max_variation = -1;
+    double time_budget_ms = 0.0;                // CPU 时间预算，大于 0 时超出预算提前结束
+    int64_t seed = -1;                          // 随机种子，小于 0 表示不固定（覆盖 Configure 中的设置）
+    OptimizerEngine engine = OptimizerEngine::Pareto;
+};
+
+struct ScenarioResult {
+    std::string name;
+    bool ok = false;
+    std::string error;
+    std::vector<std::vector<std::vector<int>>> front;   // 第一前沿
+    std::vector<ScheduleMetrics> metrics;               // 与 front 一一对应的原始目标值
+    double elapsed_ms = 0.0;                            // 优化的墙钟耗时
+    double cpu_ms = 0.0;                                // 优化线程消耗的 CPU 时间
+    RegionCounts counts;                                // 优化线程的硬件计数与堆分配，不可用的项为 -1
+    int iterations = 0;
+};
+
+// 在线程池上并发执行多个场景
+// 所有调度器指向同一份只读问题数据（窗口、覆盖率、网格、打包覆盖率模型），
+// 每个场景只额外占用自己的种群、评估缓存，以及屏蔽卫星时的一份可见性矩阵
+class ScenarioRunner {
+public:
+    // threads 为 0 时使用硬件线程数
+    explicit ScenarioRunner(SchedulingProblem::Ptr problem, int threads = 0);
+
+    // 公共参数设置：每个场景的调度器先调用它，再应用场景自身的差异
+    using Configure = std::function<void(SatelliteSchedulerMultiObjective&)>;
+    void setConfigure(Configure configure) { configure_ = std::move(configure); }
+
+    // 阻塞执行全部场景，结果顺序与 scenarios 一致；单个场景失败不影响其他场景
+    std::vector<ScenarioResult> run(const std::vector<SchedulingScenario>& scenarios) const;
+
+    int threadCount() const { return threads_; }
+
+    // 场景文件：每行一个场景，"名称 key=value ..."，# 开头为注释
+    // 键: weights=a,b,c  max_switches=n  unavailable=i,j（0-based）  max_iter  num_fireworks  max_changes
+    //      max_sparks  max_length  max_variation  time_budget_ms  seed  engine=pareto|decomposition
+    static bool loadScenarios(const std::string& path, std::vector<SchedulingScenario>& scenarios);
+
+private:
+    ScenarioResult runScenario(const SchedulingScenario& scenario) const;
+
+    SchedulingProblem::Ptr problem_;
+    int threads_ = 1;
+    Configure configure_;
+};
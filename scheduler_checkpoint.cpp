@@ -0,0 +1,229 @@
+// scheduler_checkpoint.cpp
+#include "scheduler_checkpoint.h"
+#include <fstream>
+#include <iostream>
+#include <filesystem>
+
+namespace {
+    const uint32_t kCheckpointMagic = 0x4B435746;   // "FWCK"
+    const uint32_t kCheckpointVersion = 5;
+
+    template <typename T>
+    void writePod(std::ofstream& out, const T& value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readPod(std::ifstream& in, T& value) {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    // 文件中尚未读取的字节数
+    uint64_t remainingBytes(std::ifstream& in) {
+        std::streampos pos = in.tellg();
+        in.seekg(0, std::ios::end);
+        std::streampos end = in.tellg();
+        in.seekg(pos);
+        return end > pos ? static_cast<uint64_t>(end - pos) : 0;
+    }
+
+    // 分配前确认剩余数据足以容纳 count 条 item_bytes 字节的记录，
+    // 避免损坏或截断的文件中的计数触发巨大的分配
+    bool fitsRemaining(std::ifstream& in, uint64_t count, uint64_t item_bytes) {
+        return count == 0 || (item_bytes > 0 && count <= remainingBytes(in) / item_bytes);
+    }
+
+    // 三态矩阵按 int8 行优先写出
+    void writeSchedule(std::ofstream& out, const std::vector<std::vector<int>>& solution, int cols) {
+        std::vector<int8_t> cells(cols);
+        for (const auto& row : solution) {
+            for (int c = 0; c < cols; ++c) {
+                cells[c] = static_cast<int8_t>(row[c]);
+            }
+            out.write(reinterpret_cast<const char*>(cells.data()), cols);
+        }
+    }
+
+    bool readSchedule(std::ifstream& in, std::vector<std::vector<int>>& solution, int rows, int cols) {
+        std::vector<int8_t> cells(static_cast<size_t>(rows) * cols);
+        if (!in.read(reinterpret_cast<char*>(cells.data()), cells.size())) {
+            return false;
+        }
+
+        solution.assign(rows, std::vector<int>());
+        for (int r = 0; r < rows; ++r) {
+            auto first = cells.begin() + static_cast<size_t>(r) * cols;
+            solution[r].assign(first, first + cols);
+        }
+        return true;
+    }
+}
+
+bool SchedulerCheckpoint::save(const std::string& path) const {
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "无法写入断点文件: " << tmp_path << std::endl;
+            return false;
+        }
+
+        writePod(out, kCheckpointMagic);
+        writePod(out, kCheckpointVersion);
+        writePod(out, static_cast<uint32_t>(ParetoArchive::kObjectives));
+        writePod(out, static_cast<int32_t>(iteration));
+        writePod(out, static_cast<int32_t>(num_fireworks));
+        writePod(out, static_cast<int32_t>(max_changes));
+        writePod(out, static_cast<int32_t>(rows));
+        writePod(out, static_cast<int32_t>(cols));
+
+        out.write(reinterpret_cast<const char*>(norm_bounds.data()), sizeof(double) * norm_bounds.size());
+
+        writePod(out, static_cast<uint32_t>(population.size()));
+        for (const auto& sol : population) {
+            writeSchedule(out, sol, cols);
+        }
+
+        writePod(out, static_cast<uint8_t>(archive_gridded ? 1 : 0));
+        out.write(reinterpret_cast<const char*>(archive_epsilon.data()), sizeof(double) * archive_epsilon.size());
+        writePod(out, static_cast<uint32_t>(archive_entries.size()));
+        for (const auto& e : archive_entries) {
+            out.write(reinterpret_cast<const char*>(e.objectives.data()), sizeof(double) * e.objectives.size());
+            out.write(reinterpret_cast<const char*>(e.box.data()), sizeof(long long) * e.box.size());
+            out.write(reinterpret_cast<const char*>(e.schedule.data()), e.schedule.size());
+        }
+
+        writePod(out, static_cast<uint32_t>(rng_state.size()));
+        out.write(reinterpret_cast<const char*>(rng_state.data()), sizeof(uint32_t) * rng_state.size());
+        writePod(out, static_cast<uint32_t>(operator_state.size()));
+        out.write(reinterpret_cast<const char*>(operator_state.data()), sizeof(double) * operator_state.size());
+
+        writePod(out, static_cast<int32_t>(frozen_cols));
+        if (frozen_cols > 0) {
+            writeSchedule(out, frozen_plan, frozen_cols);
+        }
+
+        if (!out) {
+            std::cerr << "断点文件写入失败: " << tmp_path << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::cerr << "断点文件替换失败: " << path << " - " << ec.message() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool SchedulerCheckpoint::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "无法打开断点文件: " << path << std::endl;
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0, objective_count = 0;
+    if (!readPod(in, magic) || !readPod(in, version) ||
+        magic != kCheckpointMagic || version != kCheckpointVersion) {
+        std::cerr << "断点文件格式错误: " << path << std::endl;
+        return false;
+    }
+
+    // 目标个数随编译期目标集合变化，不一致的断点无法续算
+    if (!readPod(in, objective_count) || objective_count != ParetoArchive::kObjectives) {
+        std::cerr << "断点文件目标个数不一致: " << path << std::endl;
+        return false;
+    }
+
+    int32_t header[5];
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    iteration = header[0];
+    num_fireworks = header[1];
+    max_changes = header[2];
+    rows = header[3];
+    cols = header[4];
+    if (rows <= 0 || cols <= 0 || !fitsRemaining(in, 1, static_cast<uint64_t>(rows) * cols)) {
+        std::cerr << "断点文件矩阵尺寸无效: " << path << std::endl;
+        return false;
+    }
+    const uint64_t cells = static_cast<uint64_t>(rows) * cols;
+
+    if (!in.read(reinterpret_cast<char*>(norm_bounds.data()), sizeof(double) * norm_bounds.size())) {
+        return false;
+    }
+
+    uint32_t population_size = 0;
+    if (!readPod(in, population_size) || !fitsRemaining(in, population_size, cells)) {
+        std::cerr << "断点文件种群数据不完整: " << path << std::endl;
+        return false;
+    }
+    population.assign(population_size, {});
+    for (auto& sol : population) {
+        if (!readSchedule(in, sol, rows, cols)) {
+            std::cerr << "断点文件种群数据不完整: " << path << std::endl;
+            return false;
+        }
+    }
+
+    uint8_t gridded = 0;
+    uint32_t archive_size = 0;
+    if (!readPod(in, gridded) ||
+        !in.read(reinterpret_cast<char*>(archive_epsilon.data()), sizeof(double) * archive_epsilon.size()) ||
+        !readPod(in, archive_size)) {
+        return false;
+    }
+    const uint64_t entry_bytes = sizeof(double) * ParetoArchive::kObjectives +
+        sizeof(long long) * ParetoArchive::kObjectives + cells;
+    if (!fitsRemaining(in, archive_size, entry_bytes)) {
+        std::cerr << "断点文件档案数据不完整: " << path << std::endl;
+        return false;
+    }
+    archive_gridded = gridded != 0;
+    archive_entries.assign(archive_size, {});
+    for (auto& e : archive_entries) {
+        e.schedule.resize(static_cast<size_t>(rows) * cols);
+        if (!in.read(reinterpret_cast<char*>(e.objectives.data()), sizeof(double) * e.objectives.size()) ||
+            !in.read(reinterpret_cast<char*>(e.box.data()), sizeof(long long) * e.box.size()) ||
+            !in.read(reinterpret_cast<char*>(e.schedule.data()), e.schedule.size())) {
+            std::cerr << "断点文件档案数据不完整: " << path << std::endl;
+            return false;
+        }
+    }
+
+    uint32_t rng_size = 0;
+    if (!readPod(in, rng_size) || !fitsRemaining(in, rng_size, sizeof(uint32_t))) {
+        return false;
+    }
+    rng_state.resize(rng_size);
+    if (!in.read(reinterpret_cast<char*>(rng_state.data()), sizeof(uint32_t) * rng_size)) {
+        return false;
+    }
+
+    uint32_t operator_size = 0;
+    if (!readPod(in, operator_size) || !fitsRemaining(in, operator_size, sizeof(double))) {
+        return false;
+    }
+    operator_state.resize(operator_size);
+    if (!in.read(reinterpret_cast<char*>(operator_state.data()), sizeof(double) * operator_size)) {
+        return false;
+    }
+
+    int32_t frozen = 0;
+    if (!readPod(in, frozen) || frozen < 0 || frozen > cols ||
+        !fitsRemaining(in, frozen > 0 ? 1 : 0, static_cast<uint64_t>(rows) * frozen)) {
+        return false;
+    }
+    frozen_cols = frozen;
+    frozen_plan.clear();
+    if (frozen_cols > 0 && !readSchedule(in, frozen_plan, rows, frozen_cols)) {
+        return false;
+    }
+
+    return true;
+}
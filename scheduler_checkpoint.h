@@ -0,0 +1,34 @@
+#pragma once
+// scheduler_checkpoint.h
+#include <vector>
+#include <string>
+#include <array>
+#include <cstdint>
+#include "pareto_archive.h"
+
+// 优化过程断点：紧凑二进制格式，便于长时间运行的任务在崩溃或重新部署后续算
+struct SchedulerCheckpoint {
+    int iteration = 0;          // 下一次要执行的迭代编号
+    int num_fireworks = 0;
+    int max_changes = 0;
+    int rows = 0;
+    int cols = 0;
+
+    std::vector<std::vector<std::vector<int>>> population;
+    std::array<double, 2 * ParetoArchive::kObjectives> norm_bounds{};   // 各目标归一化边界的 min、max
+
+    bool archive_gridded = false;
+    ParetoArchive::Objectives archive_epsilon{};
+    std::vector<ParetoArchive::Entry> archive_entries;
+
+    std::vector<uint32_t> rng_state;        // RandomSource 状态字（引擎、种子、xoshiro 状态）
+    std::vector<double> operator_state;     // 自适应算子选择器的质量估计
+
+    // 滚动时域的冻结列
+    int frozen_cols = 0;
+    std::vector<std::vector<int>> frozen_plan;
+
+    // 先写临时文件再替换，避免写到一半时崩溃留下损坏的断点
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
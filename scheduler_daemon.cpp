@@ -0,0 +1,382 @@
+// scheduler_daemon.cpp
+#include "scheduler_daemon.h"
+#include <iostream>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+    bool writeAll(int fd, const void* data, size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = ::send(fd, p, size, MSG_NOSIGNAL);
+            if (n <= 0) return false;
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool readAll(int fd, void* data, size_t size) {
+        char* p = static_cast<char*>(data);
+        while (size > 0) {
+            ssize_t n = ::recv(fd, p, size, 0);
+            if (n <= 0) return false;
+            p += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    bool sendFrame(int fd, uint8_t type, const std::vector<uint8_t>& payload) {
+        uint32_t size = static_cast<uint32_t>(payload.size());
+        return writeAll(fd, &size, sizeof(size)) && writeAll(fd, &type, sizeof(type)) &&
+            (payload.empty() || writeAll(fd, payload.data(), payload.size()));
+    }
+
+    bool sendText(int fd, uint8_t type, const std::string& text) {
+        return sendFrame(fd, type, std::vector<uint8_t>(text.begin(), text.end()));
+    }
+
+    bool readFrame(int fd, uint8_t& type, std::vector<uint8_t>& payload) {
+        uint32_t size = 0;
+        if (!readAll(fd, &size, sizeof(size)) || !readAll(fd, &type, sizeof(type))) {
+            return false;
+        }
+        if (size > daemon_protocol::kMaxFrameSize) {
+            return false;
+        }
+        payload.resize(size);
+        return size == 0 || readAll(fd, payload.data(), size);
+    }
+
+    // 对端是否已关闭连接或连接出错；只看挂断标志，不读取数据，
+    // 只关闭写方向（半关闭）的客户端仍在等待结果，不视为断开
+    bool peerHungUp(int fd) {
+        pollfd pfd{ fd, 0, 0 };
+        return ::poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+    }
+
+    template <typename T>
+    void append(std::vector<uint8_t>& out, const T& value) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+
+    // 前沿按 FWAScheduleResult 相同的布局编码：目标值矩阵在前，int8 调度矩阵在后
+    std::vector<uint8_t> encodeFront(SatelliteSchedulerMultiObjective& scheduler, int iteration,
+        uint32_t version, const std::vector<std::vector<std::vector<int>>>& front) {
+
+        const auto& compressed = scheduler.getCompressed();
+        uint32_t rows = static_cast<uint32_t>(compressed.size());
+        uint32_t cols = compressed.empty() ? 0 : static_cast<uint32_t>(compressed[0].size());
+
+        std::vector<uint8_t> out;
+        out.reserve(24 + front.size() * (ActiveObjectives::N * sizeof(double) + rows * cols));
+        append(out, static_cast<int32_t>(iteration));
+        append(out, version);
+        append(out, static_cast<uint32_t>(front.size()));
+        append(out, static_cast<uint32_t>(ActiveObjectives::N));
+        append(out, rows);
+        append(out, cols);
+
+        for (const auto& sol : front) {
+            auto values = ActiveObjectives::raw(scheduler.evaluate(sol, false));
+            for (double v : values) {
+                append(out, v);
+            }
+        }
+        for (const auto& sol : front) {
+            for (const auto& row : sol) {
+                for (int value : row) {
+                    out.push_back(static_cast<uint8_t>(static_cast<int8_t>(value)));
+                }
+            }
+        }
+        return out;
+    }
+}
+
+SchedulerDaemon::SchedulerDaemon(const DaemonConfig& config) : config_(config) {
+    auto& files = input_files_;
+
+    std::error_code ec;
+    bool from_directory = !config_.directory_path.empty() &&
+        std::filesystem::is_directory(config_.directory_path, ec);
+    for (int i = 1; i <= config_.num_satellites; ++i) {
+        std::string filename = "satellite_" + std::to_string(i) + ".csv";
+        files.push_back(from_directory ?
+            (std::filesystem::path(config_.directory_path) / filename).string() : filename);
+    }
+
+    // 网格文件列表与调度器预加载的范围一致
+    SatelliteSchedulerMultiObjective defaults;
+    CoverageDataLoader mesh_paths(config_.mesh_dir);
+    for (int sat : defaults.getOverlapSatellites()) {
+        for (int time : defaults.getSpecialTimes()) {
+            files.push_back(mesh_paths.makeFilepath(sat, time));
+        }
+    }
+}
+
+SchedulerDaemon::~SchedulerDaemon() {
+    stop();
+    if (watcher_.joinable()) {
+        watcher_.join();
+    }
+
+    // 连接线程已分离，等待其全部退出
+    while (active_connections_ > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        ::unlink(config_.socket_path.c_str());
+    }
+}
+
+uint64_t SchedulerDaemon::inputFingerprint() const {
+    // 文件路径、大小和修改时间的组合哈希；缺失文件也参与计算
+    uint64_t h = 1469598103934665603ULL;
+    auto mix = [&h](uint64_t v) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    };
+
+    for (const auto& path : input_files_) {
+        mix(std::hash<std::string>()(path));
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        mix(ec ? ~0ULL : static_cast<uint64_t>(size));
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        mix(ec ? ~0ULL : static_cast<uint64_t>(mtime.time_since_epoch().count()));
+    }
+    return h;
+}
+
+std::shared_ptr<SchedulerDaemon::Dataset> SchedulerDaemon::loadDataset(uint64_t fingerprint) {
+    SatelliteDataLoader loader;
+    loader.setSatelliteCount(config_.num_satellites);
+    loader.loadDataFromExcel(config_.directory_path);
+    if (loader.getCompressedMatrix().empty() || loader.getBounds().empty()) {
+        std::cerr << "未读取到任何卫星时间窗口数据，保留当前数据集" << std::endl;
+        return nullptr;
+    }
+
+    // 打包覆盖率模型在加载时构建，任务不再承担
+    SatelliteSchedulerMultiObjective builder;
+    builder.setCoverageDataDir(config_.mesh_dir);
+    builder.loadProblem(loader);
+    builder.getProblem()->packedCoverage();
+
+    auto dataset = std::make_shared<Dataset>();
+    dataset->problem = builder.getProblem();
+    dataset->fingerprint = fingerprint;
+    return dataset;
+}
+
+bool SchedulerDaemon::reload(bool force) {
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+
+    uint64_t fingerprint = inputFingerprint();
+    auto current = std::atomic_load(&dataset_);
+    if (!force && current && current->fingerprint == fingerprint) {
+        return false;
+    }
+
+    // 新数据集完整加载成功后才替换，失败时继续使用旧数据集
+    auto dataset = loadDataset(fingerprint);
+    if (!dataset) {
+        return false;
+    }
+    dataset->version = next_version_++;
+    std::atomic_store(&dataset_, dataset);
+
+    std::cout << "数据集已加载: 版本 " << dataset->version << std::endl;
+    return true;
+}
+
+bool SchedulerDaemon::start() {
+    reload(true);
+    if (!std::atomic_load(&dataset_)) {
+        return false;
+    }
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        std::cerr << "无法创建套接字" << std::endl;
+        return false;
+    }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (config_.socket_path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "套接字路径过长: " << config_.socket_path << std::endl;
+        return false;
+    }
+    std::strncpy(addr.sun_path, config_.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+    ::unlink(config_.socket_path.c_str());
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        ::listen(listen_fd_, 16) < 0) {
+        std::cerr << "无法监听套接字: " << config_.socket_path << " - " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    running_ = true;
+    watcher_ = std::thread(&SchedulerDaemon::watchLoop, this);
+
+    std::cout << "调度服务已启动: " << config_.socket_path << std::endl;
+    return true;
+}
+
+void SchedulerDaemon::run() {
+    while (running_) {
+        pollfd pfd{ listen_fd_, POLLIN, 0 };
+        int ready = ::poll(&pfd, 1, 200);
+        if (ready <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+
+        int fd = ::accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(connections_mutex_);
+            open_connections_.insert(fd);
+        }
+        active_connections_++;
+        std::thread(&SchedulerDaemon::serveConnection, this, fd).detach();
+    }
+}
+
+void SchedulerDaemon::stop() {
+    running_ = false;
+
+    // 唤醒阻塞在读取上的连接线程
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (int fd : open_connections_) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void SchedulerDaemon::watchLoop() {
+    auto last_check = std::chrono::steady_clock::now();
+    while (running_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        auto now = std::chrono::steady_clock::now();
+        if (config_.poll_seconds <= 0 || now - last_check < std::chrono::seconds(config_.poll_seconds)) {
+            continue;
+        }
+        last_check = now;
+        reload(false);
+    }
+}
+
+void SchedulerDaemon::serveConnection(int fd) {
+    uint8_t type = 0;
+    std::vector<uint8_t> payload;
+
+    while (running_ && readFrame(fd, type, payload)) {
+        switch (type) {
+        case daemon_protocol::kJob:
+            handleJob(fd, payload);
+            break;
+        case daemon_protocol::kReload:
+            reload(true);
+            sendText(fd, daemon_protocol::kStatusReply, statusText());
+            break;
+        case daemon_protocol::kStatus:
+            sendText(fd, daemon_protocol::kStatusReply, statusText());
+            break;
+        case daemon_protocol::kShutdown:
+            sendText(fd, daemon_protocol::kStatusReply, "shutting down");
+            stop();
+            break;
+        default:
+            sendText(fd, daemon_protocol::kError, "unknown message type");
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        open_connections_.erase(fd);
+    }
+    ::close(fd);
+    active_connections_--;
+}
+
+void SchedulerDaemon::handleJob(int fd, const std::vector<uint8_t>& payload) {
+    int32_t params[4] = { 0, 0, 0, 0 };
+    if (payload.size() != sizeof(params)) {
+        sendText(fd, daemon_protocol::kError, "malformed job");
+        return;
+    }
+    std::memcpy(params, payload.data(), sizeof(params));
+    int max_iter = params[0], num_fireworks = params[1], max_changes = params[2], stream_interval = params[3];
+    if (max_iter < 0 || num_fireworks <= 0 || max_changes <= 0) {
+        sendText(fd, daemon_protocol::kError, "invalid job parameters");
+        return;
+    }
+
+    // 使用当前数据集，不在任务中检查输入文件；每个任务有自己的调度器，并发的任务互不等待
+    auto dataset = std::atomic_load(&dataset_);
+    SatelliteSchedulerMultiObjective scheduler;
+    scheduler.attachProblem(dataset->problem);
+
+    // 请求方断开（挂断或推送失败）或服务停止时，任务在当前迭代结束后取消，不再为无人接收的结果占用 CPU
+    bool client_alive = true;
+    scheduler.setCancelCheck([&]() {
+        if (client_alive && peerHungUp(fd)) {
+            client_alive = false;
+        }
+        return !client_alive || !running_;
+    });
+    if (stream_interval > 0) {
+        scheduler.setProgressCallback([&](int iteration, const std::vector<std::vector<std::vector<int>>>& front) {
+            if (client_alive) {
+                client_alive = sendFrame(fd, daemon_protocol::kFront,
+                    encodeFront(scheduler, iteration, dataset->version, front));
+            }
+        }, stream_interval);
+    }
+
+    try {
+        auto start = std::chrono::steady_clock::now();
+        auto result = scheduler.optimize(max_iter, num_fireworks, max_changes);
+        double elapsed_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        if (client_alive && running_) {
+            std::vector<uint8_t> done;
+            append(done, elapsed_ms);
+            sendFrame(fd, daemon_protocol::kFront, encodeFront(scheduler, -1, dataset->version, result.first)) &&
+                sendFrame(fd, daemon_protocol::kDone, done);
+        }
+    }
+    catch (const std::exception& e) {
+        sendText(fd, daemon_protocol::kError, e.what());
+    }
+}
+
+std::string SchedulerDaemon::statusText() const {
+    auto dataset = std::atomic_load(&dataset_);
+    std::ostringstream ss;
+    if (dataset) {
+        ss << "dataset_version=" << dataset->version
+            << " satellites=" << dataset->problem->rows()
+            << " columns=" << dataset->problem->bounds().size();
+    }
+    else {
+        ss << "no dataset";
+    }
+    return ss.str();
+}
@@ -0,0 +1,97 @@
+#pragma once
+// scheduler_daemon.h
+// 常驻调度服务：数据只加载一次，通过 Unix 域套接字接收优化任务（仅 POSIX）
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <set>
+#include <cstdint>
+#include "satellite_scheduler_multiobjective.h"
+
+// 二进制帧协议（本机字节序）：uint32 负载长度 + uint8 类型 + 负载
+//
+// 请求
+//   JOB      int32 max_iter, int32 num_fireworks, int32 max_changes, int32 stream_interval
+//            stream_interval > 0 时每隔该迭代数推送一次当代第一前沿
+//            客户端断开连接或服务停止时，任务在当前迭代结束后取消，不再返回结果
+//   RELOAD   无负载，强制重新加载数据（输入文件的变化由监视线程按 poll_seconds 检查，任务本身不触发加载）
+//   STATUS   无负载
+//   SHUTDOWN 无负载
+//
+// 响应
+//   FRONT    int32 iteration（-1 表示最终结果）, uint32 dataset_version,
+//            uint32 solution_count, uint32 objective_count, uint32 rows, uint32 cols,
+//            double objectives[solution_count * objective_count]（原始方向）,
+//            int8 schedules[solution_count * rows * cols]
+//   DONE     double elapsed_ms（仅优化耗时）
+//   STATUS   UTF-8 文本
+//   ERROR    UTF-8 文本
+namespace daemon_protocol {
+    enum MessageType : uint8_t {
+        kJob = 1,
+        kReload = 2,
+        kStatus = 3,
+        kShutdown = 4,
+
+        kFront = 0x81,
+        kDone = 0x82,
+        kStatusReply = 0x83,
+        kError = 0x84,
+    };
+
+    const uint32_t kMaxFrameSize = 64u << 20;
+}
+
+struct DaemonConfig {
+    std::string socket_path = "/tmp/fwa_scheduler.sock";
+    std::string directory_path;         // 时间窗口文件目录，空表示当前目录
+    std::string mesh_dir;               // 重叠时间点网格数据目录，空表示当前目录
+    int num_satellites = 10;
+    int poll_seconds = 5;               // 输入文件变化检查周期
+};
+
+class SchedulerDaemon {
+public:
+    explicit SchedulerDaemon(const DaemonConfig& config);
+    ~SchedulerDaemon();
+
+    // 加载数据并监听套接字
+    bool start();
+    // 阻塞处理连接，直到收到 SHUTDOWN 或调用 stop()
+    void run();
+    void stop();
+
+private:
+    // 一份已加载的数据集：只读的问题数据由各任务共享，每个任务构造自己的调度器
+    // 重新加载（监视线程或 RELOAD 消息）时整体替换，正在运行的任务继续持有旧数据集
+    struct Dataset {
+        SchedulingProblem::Ptr problem;
+        uint64_t fingerprint = 0;
+        uint32_t version = 0;
+    };
+
+    std::shared_ptr<Dataset> loadDataset(uint64_t fingerprint);
+    uint64_t inputFingerprint() const;
+    bool reload(bool force);
+
+    void watchLoop();
+    void serveConnection(int fd);
+    void handleJob(int fd, const std::vector<uint8_t>& payload);
+    std::string statusText() const;
+
+    DaemonConfig config_;
+    std::vector<std::string> input_files_;  // 参与变化检测的输入文件
+    std::shared_ptr<Dataset> dataset_;  // 通过 std::atomic_load / std::atomic_store 访问
+    std::mutex reload_mutex_;
+    uint32_t next_version_ = 1;
+
+    int listen_fd_ = -1;
+    std::atomic<bool> running_{ false };
+    std::thread watcher_;
+    std::mutex connections_mutex_;
+    std::set<int> open_connections_;
+    std::atomic<int> active_connections_{ 0 };
+};
@@ -0,0 +1,56 @@
+// scheduler_daemon_main.cpp
+// 用法: fwa_daemon [--socket 路径] [--dir 时间窗口目录] [--mesh-dir 网格目录]
+//                  [--satellites 卫星数] [--poll 秒] [--quiet]
+#include "scheduler_daemon.h"
+#include <iostream>
+#include <fstream>
+#include <csignal>
+#include <cstdlib>
+
+namespace {
+    SchedulerDaemon* g_daemon = nullptr;
+
+    void handleSignal(int) {
+        if (g_daemon) {
+            g_daemon->stop();
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    DaemonConfig config;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--socket" && has_value) config.socket_path = argv[++i];
+        else if (arg == "--dir" && has_value) config.directory_path = argv[++i];
+        else if (arg == "--mesh-dir" && has_value) config.mesh_dir = argv[++i];
+        else if (arg == "--satellites" && has_value) config.num_satellites = std::atoi(argv[++i]);
+        else if (arg == "--poll" && has_value) config.poll_seconds = std::atoi(argv[++i]);
+        else if (arg == "--quiet") quiet = true;
+        else {
+            std::cerr << "未知参数: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // 安静模式下丢弃优化过程的逐代输出，错误信息仍写到 stderr
+    std::ofstream null_stream;
+    if (quiet) {
+        std::cout.rdbuf(null_stream.rdbuf());
+    }
+
+    SchedulerDaemon daemon(config);
+    g_daemon = &daemon;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    if (!daemon.start()) {
+        std::cerr << "调度服务启动失败" << std::endl;
+        return 1;
+    }
+    daemon.run();
+    return 0;
+}
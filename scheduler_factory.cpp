@@ -0,0 +1,29 @@
+// scheduler_factory.cpp
+#include "scheduler_factory.h"
+#include "satellite_scheduler_decomposition.h"
+
+std::unique_ptr<SatelliteSchedulerMultiObjective> createScheduler(OptimizerEngine engine) {
+    switch (engine) {
+    case OptimizerEngine::Decomposition:
+        return std::make_unique<SatelliteSchedulerDecomposition>();
+    case OptimizerEngine::Pareto:
+    default:
+        return std::make_unique<SatelliteSchedulerMultiObjective>();
+    }
+}
+
+bool parseOptimizerEngine(const std::string& text, OptimizerEngine& engine) {
+    if (text == "pareto") {
+        engine = OptimizerEngine::Pareto;
+        return true;
+    }
+    if (text == "decomposition" || text == "moead") {
+        engine = OptimizerEngine::Decomposition;
+        return true;
+    }
+    return false;
+}
+
+const char* optimizerEngineName(OptimizerEngine engine) {
+    return engine == OptimizerEngine::Decomposition ? "decomposition" : "pareto";
+}
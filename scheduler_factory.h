@@ -0,0 +1,17 @@
+#pragma once
+// scheduler_factory.h
+#include <memory>
+#include <string>
+#include "satellite_scheduler_multiobjective.h"
+
+// 可在运行时选择的优化引擎
+enum class OptimizerEngine {
+    Pareto,         // 全局非支配排序 + 拥挤距离（SatelliteSchedulerMultiObjective）
+    Decomposition   // 权重向量分解 + 邻域替换（SatelliteSchedulerDecomposition）
+};
+
+std::unique_ptr<SatelliteSchedulerMultiObjective> createScheduler(OptimizerEngine engine);
+
+// "pareto" / "decomposition"（也接受 "moead"），无法识别时返回 false
+bool parseOptimizerEngine(const std::string& text, OptimizerEngine& engine);
+const char* optimizerEngineName(OptimizerEngine engine);
@@ -0,0 +1,255 @@
+// scheduling_problem.cpp
+#include "scheduling_problem.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+SchedulingProblem::Ptr SchedulingProblem::empty() {
+    auto problem = std::make_shared<SchedulingProblem>();
+    problem->packed_ = std::make_shared<PackedState>();
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::create(const std::vector<std::vector<int>>& compressed,
+    const std::vector<int>& bounds, const std::map<int, std::vector<double>>& coverage_data,
+    const std::vector<std::vector<int>>& time_indices) {
+
+    auto problem = std::make_shared<SchedulingProblem>();
+    problem->compressed_ = compressed;
+    problem->bounds_ = bounds;
+    problem->coverage_data_ = coverage_data;
+    problem->idx_ = time_indices;
+    problem->layout_.build(problem->compressed_);
+    problem->packed_ = std::make_shared<PackedState>();
+    return problem;
+}
+
+std::shared_ptr<SchedulingProblem> SchedulingProblem::clone() const {
+    auto problem = std::make_shared<SchedulingProblem>(*this);
+    // 默认认为派生数据失效，需要复用时由调用方替换
+    problem->packed_ = std::make_shared<PackedState>();
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::withWindows(const std::vector<std::vector<int>>& compressed,
+    const std::vector<int>& bounds) const {
+
+    auto problem = clone();
+    problem->compressed_ = compressed;
+    problem->bounds_ = bounds;
+    problem->layout_.build(problem->compressed_);
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::withCoverageData(
+    const std::map<int, std::vector<double>>& coverage_data) const {
+
+    auto problem = clone();
+    problem->coverage_data_ = coverage_data;
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::withTimeIndices(const std::vector<std::vector<int>>& time_indices) const {
+    auto problem = clone();
+    problem->idx_ = time_indices;
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::withMeshSource(std::shared_ptr<CoverageDataLoader> loader, int q) const {
+    auto problem = clone();
+    problem->mesh_source_ = std::make_shared<MeshSource>();
+    problem->mesh_source_->loader = std::move(loader);
+    problem->q_ = q;
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::withWindowUpdate(const SatelliteDataLoader& loader,
+    const SatelliteDataLoader::ColumnRemap& remap) const {
+
+    auto problem = clone();
+    problem->compressed_ = loader.getCompressedMatrix();
+    problem->bounds_ = loader.getBounds();
+    problem->coverage_data_ = loader.getCoverageData();
+    problem->idx_ = loader.getTimeIndices();
+    problem->layout_.build(problem->compressed_);
+
+    if (problem->rows() != rows() || static_cast<int>(remap.old_to_new.size()) != cols() ||
+        remap.new_cols != problem->cols()) {
+        // 卫星数或旧列数对不上（remap 不是针对本问题生成的），只能整体重建
+        return problem;
+    }
+
+    std::vector<int> reuse_from(remap.new_cols, -1);
+    for (size_t k = 0; k < remap.old_to_new.size(); ++k) {
+        if (remap.old_to_new[k] >= 0) {
+            reuse_from[remap.old_to_new[k]] = static_cast<int>(k);
+        }
+    }
+    for (int j : remap.changed) {
+        reuse_from[j] = -1;
+    }
+
+    const PackedCoverage& model = packedCoverage();
+    problem->packed_->model = problem->buildPackedCoverage(&model, &reuse_from);
+    return problem;
+}
+
+SchedulingProblem::Ptr SchedulingProblem::withoutSatellites(const std::vector<int>& satellites) const {
+    // 屏蔽后的解在被屏蔽卫星上只有 -1，原模型的单星表和网格仍然适用，先确保它已构建
+    const PackedCoverage& model = packedCoverage();
+    (void)model;
+
+    auto problem = clone();
+    problem->packed_->model = packed_->model;
+    problem->packed_->unique = packed_->unique;
+    for (int sat : satellites) {
+        if (sat >= 0 && sat < problem->rows()) {
+            std::fill(problem->compressed_[sat].begin(), problem->compressed_[sat].end(), -1);
+        }
+    }
+    problem->layout_.build(problem->compressed_);
+    return problem;
+}
+
+const PackedCoverage& SchedulingProblem::packedCoverage() const {
+    std::call_once(packed_->once, [this]() {
+        if (!packed_->model) {
+            packed_->model = buildPackedCoverage();
+        }
+    });
+    return *packed_->model;
+}
+
+const PackedCoverage& SchedulingProblem::surrogateCoverage(int samples) const {
+    const PackedCoverage& full = packedCoverage();
+    std::lock_guard<std::mutex> lock(packed_->surrogate_mutex);
+    auto& model = packed_->surrogates[samples];
+    if (!model) {
+        // 种子固定：同一问题上的代理值在各次运行之间可复现
+        model = full.subsample(samples, 20240601u);
+    }
+    return *model;
+}
+
+const UniqueCoverage& SchedulingProblem::uniqueCoverage() const {
+    std::call_once(packed_->unique_once, [this]() {
+        if (!packed_->unique) {
+            packed_->unique = buildUniqueCoverage();
+        }
+    });
+    return *packed_->unique;
+}
+
+std::shared_ptr<const UniqueCoverage> SchedulingProblem::buildUniqueCoverage() const {
+    int m = rows();
+    int cols = this->cols();
+    auto model = std::make_shared<UniqueCoverage>();
+    model->reset(m, cols, q_);
+    if (!mesh_source_) {
+        throw std::runtime_error("覆盖率加载器未初始化，无法计算去重覆盖率");
+    }
+
+    std::lock_guard<std::mutex> lock(mesh_source_->mutex);
+    for (int j = 0; j < cols; ++j) {
+        for (int sat = 0; sat < m; ++sat) {
+            if (compressed_[sat][j] != -1) {
+                model->setMesh(sat, j, mesh_source_->loader->getMesh(sat + 1, bounds_[j], q_));
+            }
+        }
+    }
+    model->finalize();
+
+    std::cout << "去重覆盖模型构建完成: " << model->meshCount() << " 个网格, 单点最多被覆盖 "
+        << model->maxDepth() << " 次";
+    if (model->compressed()) {
+        std::cout << ", 压缩存储 " << model->meshBytes() / 1024 << " KB";
+    }
+    std::cout << std::endl;
+    return model;
+}
+
+std::shared_ptr<const PackedCoverage> SchedulingProblem::buildPackedCoverage(const PackedCoverage* reuse,
+    const std::vector<int>* reuse_from) const {
+
+    int m = rows();
+    int cols = this->cols();
+    auto model = std::make_shared<PackedCoverage>();
+    model->reset(m, cols, q_);
+
+    int mesh_count = 0;
+    int reused = 0;
+    for (int j = 0; j < cols; ++j) {
+        if (reuse && (*reuse_from)[j] >= 0) {
+            model->copyColumn(*reuse, (*reuse_from)[j], j);
+            reused++;
+            continue;
+        }
+
+        int visible = 0;
+        for (int sat = 0; sat < m; ++sat) {
+            if (compressed_[sat][j] != -1) {
+                model->setSingle(sat, j, singleCoverage(sat, bounds_[j]));
+                visible++;
+            }
+        }
+
+        // 只有可能出现多星同时开机的列需要网格数据
+        if (visible < 2) continue;
+        if (!mesh_source_) {
+            throw std::runtime_error("覆盖率加载器未初始化，无法计算重叠时间点的覆盖率");
+        }
+        std::lock_guard<std::mutex> lock(mesh_source_->mutex);
+        for (int sat = 0; sat < m; ++sat) {
+            if (compressed_[sat][j] != -1) {
+                model->setMesh(sat, j, mesh_source_->loader->getMesh(sat + 1, bounds_[j], q_));
+                mesh_count++;
+            }
+        }
+    }
+
+    if (mesh_source_) {
+        model->setWeights(mesh_source_->loader->getGridWeights());
+    }
+    model->finalize();
+
+    int specialized = 0;
+    for (int active = 2; active <= m; ++active) {
+        specialized += model->kernels().specialized(active);
+    }
+    std::cout << "覆盖率模型构建完成: " << mesh_count << " 个网格, 每网格 "
+        << model->words() << " 字, 特化内核 " << specialized << " 个";
+    if (reuse) {
+        std::cout << ", 复用未变化列 " << reused << " 个";
+    }
+    if (model->compressed()) {
+        std::cout << ", 压缩存储 " << model->meshBytes() / 1024 << " KB";
+    }
+    if (model->weighted()) {
+        std::cout << ", 加权网格点（查表字 " << model->tableWords() << "/" << model->words() << "）";
+    }
+    std::cout << std::endl;
+
+    return model;
+}
+
+double SchedulingProblem::singleCoverage(int sat, int j_original) const {
+    // 查找时间点在idx_中的位置
+    if (sat < idx_.size()) {
+        const auto& sat_indices = idx_[sat];
+        auto time_it = std::find(sat_indices.begin(), sat_indices.end(), j_original);
+
+        if (time_it != sat_indices.end()) {
+            int index = std::distance(sat_indices.begin(), time_it);
+
+            // 从coverage_data_中获取覆盖率
+            auto coverage_it = coverage_data_.find(sat);
+            if (coverage_it != coverage_data_.end() &&
+                index < coverage_it->second.size()) {
+                return coverage_it->second[index];
+            }
+        }
+    }
+
+    // 如果找不到对应的覆盖率数据，返回0
+    return 0.0;
+}
@@ -0,0 +1,91 @@
+#pragma once
+// scheduling_problem.h
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "bitplane_schedule.h"
+#include "coverage_kernels.h"
+#include "coverage_loader.h"
+#include "unique_coverage.h"
+#include "satellite_data_loader.h"
+
+// 一个调度问题的只读数据：压缩时间窗口、单星覆盖率、时间索引、重叠时间点网格，
+// 以及由它们派生的位平面布局和打包覆盖率模型
+// 通过 std::shared_ptr<const SchedulingProblem> 被多个调度器（可以在不同线程中）共享；
+// 修改总是生成新对象（写时复制），已发布的对象不再变化
+class SchedulingProblem {
+public:
+    using Ptr = std::shared_ptr<const SchedulingProblem>;
+
+    static Ptr empty();
+    static Ptr create(const std::vector<std::vector<int>>& compressed, const std::vector<int>& bounds,
+        const std::map<int, std::vector<double>>& coverage_data, const std::vector<std::vector<int>>& time_indices);
+
+    // 返回替换了相应数据的新问题；未变化的部分（网格来源、可复用的打包模型）与原问题共享
+    Ptr withWindows(const std::vector<std::vector<int>>& compressed, const std::vector<int>& bounds) const;
+    Ptr withCoverageData(const std::map<int, std::vector<double>>& coverage_data) const;
+    Ptr withTimeIndices(const std::vector<std::vector<int>>& time_indices) const;
+    Ptr withMeshSource(std::shared_ptr<CoverageDataLoader> loader, int q) const;
+    // 增量窗口更新（见 SatelliteDataLoader::ingestPass）：未变化列的单星覆盖率和网格从原打包模型复制，
+    // 只为 remap.changed 中的列重新加载网格
+    Ptr withWindowUpdate(const SatelliteDataLoader& loader, const SatelliteDataLoader::ColumnRemap& remap) const;
+    // 屏蔽不可用的卫星（0-based）：其全部窗口置为 -1，打包覆盖率模型与原问题共享
+    Ptr withoutSatellites(const std::vector<int>& satellites) const;
+
+    const std::vector<std::vector<int>>& compressed() const { return compressed_; }
+    const std::vector<int>& bounds() const { return bounds_; }
+    const std::map<int, std::vector<double>>& coverageData() const { return coverage_data_; }
+    const std::vector<std::vector<int>>& timeIndices() const { return idx_; }
+    int rows() const { return static_cast<int>(compressed_.size()); }
+    int cols() const { return compressed_.empty() ? 0 : static_cast<int>(compressed_[0].size()); }
+    int q() const { return q_; }
+    bool hasMeshSource() const { return static_cast<bool>(mesh_source_); }
+
+    // 位平面布局（可见性掩码与连续可见段）
+    const BitPlaneLayout& layout() const { return layout_; }
+
+    // 单颗卫星在原始时间点 j_original 的覆盖率
+    double singleCoverage(int sat, int j_original) const;
+
+    // 打包覆盖率模型，首次调用时构建；多个线程同时调用时只构建一次
+    const PackedCoverage& packedCoverage() const;
+
+    // 在 samples 个分层抽样网格点上的代理覆盖率模型（见 PackedCoverage::subsample），按样本数缓存
+    const PackedCoverage& surrogateCoverage(int samples) const;
+
+    // 去重覆盖模型（每个可见单元一个网格），首次调用时经网格来源加载；只有启用 UniqueCoverageObjective 时才需要
+    const UniqueCoverage& uniqueCoverage() const;
+
+private:
+    // 网格来源：加载器的 getMesh 会修改内部随机数状态，共享时需要加锁
+    struct MeshSource {
+        std::shared_ptr<CoverageDataLoader> loader;
+        std::mutex mutex;
+    };
+
+    struct PackedState {
+        std::once_flag once;
+        std::shared_ptr<const PackedCoverage> model;
+        std::mutex surrogate_mutex;
+        std::map<int, std::shared_ptr<const PackedCoverage>> surrogates;
+        std::once_flag unique_once;
+        std::shared_ptr<const UniqueCoverage> unique;
+    };
+
+    std::shared_ptr<SchedulingProblem> clone() const;
+    // reuse_from[j] >= 0 时新模型的第 j 列直接复制 reuse 的第 reuse_from[j] 列
+    std::shared_ptr<const PackedCoverage> buildPackedCoverage(const PackedCoverage* reuse = nullptr,
+        const std::vector<int>* reuse_from = nullptr) const;
+    std::shared_ptr<const UniqueCoverage> buildUniqueCoverage() const;
+
+    std::vector<std::vector<int>> compressed_;  // 压缩时间窗口矩阵
+    std::vector<int> bounds_;                   // 原始时间索引
+    std::map<int, std::vector<double>> coverage_data_;  // 每个卫星的覆盖率数据
+    std::vector<std::vector<int>> idx_;         // 时间索引
+    int q_ = 6665;
+
+    BitPlaneLayout layout_;
+    std::shared_ptr<MeshSource> mesh_source_;
+    std::shared_ptr<PackedState> packed_;
+};
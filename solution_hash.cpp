@@ -0,0 +1,43 @@
+// solution_hash.cpp
+#include "solution_hash.h"
+#include <algorithm>
+
+namespace {
+    // splitmix64：由种子确定性地生成键表
+    uint64_t splitmix64(uint64_t& state) {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+}
+
+void ZobristHasher::initialize(int rows, int cols, uint64_t seed) {
+    rows_ = rows;
+    cols_ = cols;
+    keys_.resize(static_cast<size_t>(rows) * cols);
+
+    uint64_t state = seed;
+    for (auto& k : keys_) {
+        k = splitmix64(state);
+    }
+}
+
+uint64_t ZobristHasher::hash(const std::vector<std::vector<int>>& solution) const {
+    uint64_t h = 0;
+    int rows = std::min<int>(rows_, static_cast<int>(solution.size()));
+
+    for (int sat = 0; sat < rows; ++sat) {
+        const auto& row = solution[sat];
+        const uint64_t* row_keys = keys_.data() + static_cast<size_t>(sat) * cols_;
+        int cols = std::min<int>(cols_, static_cast<int>(row.size()));
+
+        for (int col = 0; col < cols; ++col) {
+            if (row[col] == 1) {
+                h ^= row_keys[col];
+            }
+        }
+    }
+
+    return h;
+}
@@ -0,0 +1,29 @@
+#pragma once
+// solution_hash.h
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Zobrist 哈希：每个 (卫星, 压缩列) 分配一个随机键，解的哈希为所有 "开" 单元键值的异或
+// 时间窗口可见性（-1）在所有解中一致，因此只需关心 0/1 状态
+class ZobristHasher {
+public:
+    void initialize(int rows, int cols, uint64_t seed = 0x9e3779b97f4a7c15ULL);
+    bool matches(int rows, int cols) const { return rows == rows_ && cols == cols_; }
+
+    uint64_t hash(const std::vector<std::vector<int>>& solution) const;
+
+    uint64_t key(int sat, int col) const { return keys_[static_cast<size_t>(sat) * cols_ + col]; }
+
+    // 单元从 old_value 变为 new_value 时的增量更新，O(1)
+    void update(uint64_t& h, int sat, int col, int old_value, int new_value) const {
+        if ((old_value == 1) != (new_value == 1)) {
+            h ^= key(sat, col);
+        }
+    }
+
+private:
+    std::vector<uint64_t> keys_;
+    int rows_ = 0;
+    int cols_ = 0;
+};
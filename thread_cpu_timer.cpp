@@ -0,0 +1,28 @@
+// thread_cpu_timer.cpp
+#include "thread_cpu_timer.h"
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+double ThreadCpuTimer::nowMs() {
+#if defined(_WIN32)
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    // FILETIME 以 100 纳秒为单位
+    auto toMs = [](const FILETIME& t) {
+        return ((static_cast<unsigned long long>(t.dwHighDateTime) << 32) | t.dwLowDateTime) / 10000.0;
+    };
+    return toMs(kernel) + toMs(user);
+#else
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+#endif
+}
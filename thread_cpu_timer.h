@@ -0,0 +1,18 @@
+#pragma once
+// thread_cpu_timer.h
+
+// 当前线程消耗的 CPU 时间（用户态 + 内核态）
+// 多个优化并发运行、线程数超过核数时，墙钟时间包含等待调度的时间，CPU 时间不受影响
+class ThreadCpuTimer {
+public:
+    ThreadCpuTimer() : start_ms_(nowMs()) {}
+
+    void reset() { start_ms_ = nowMs(); }
+    double elapsedMs() const { return nowMs() - start_ms_; }
+
+    // 当前线程自创建以来的 CPU 时间（毫秒）
+    static double nowMs();
+
+private:
+    double start_ms_;
+};
@@ -0,0 +1,218 @@
+// unique_coverage.cpp
+#include "unique_coverage.h"
+#include "bitplane_schedule.h"
+
+void UniqueCoverage::setMeshStorage(MeshStorage storage) {
+    storage_ = storage;
+    compressed_ = storage_ == MeshStorage::Compressed ||
+        (storage_ == MeshStorage::Auto && q_ >= MeshContainer::kChunkPoints);
+}
+
+void UniqueCoverage::reset(int rows, int cols, int q) {
+    rows_ = rows;
+    cols_ = cols;
+    q_ = q;
+    words_ = (q + 63) / 64;
+    max_depth_ = 0;
+    mesh_count_ = 0;
+    mesh_index_.assign(static_cast<size_t>(rows) * cols, -1);
+    mesh_pool_.clear();
+    mesh_sets_.clear();
+    setMeshStorage(storage_);
+}
+
+void UniqueCoverage::setMesh(int sat, int col, const MeshContainer& mesh) {
+    if (compressed_) {
+        mesh_sets_.push_back(mesh);
+    }
+    else {
+        size_t offset = mesh_pool_.size();
+        mesh_pool_.resize(offset + words_, 0);
+        mesh.orInto(mesh_pool_.data() + offset);
+    }
+    mesh_index_[cell(sat, col)] = mesh_count_++;
+}
+
+size_t UniqueCoverage::meshBytes() const {
+    size_t bytes = mesh_pool_.size() * sizeof(uint64_t);
+    for (const auto& mesh : mesh_sets_) {
+        bytes += mesh.bytes();
+    }
+    return bytes;
+}
+
+void UniqueCoverage::orMesh(int sat, int col, uint64_t* bits) const {
+    int index = mesh_index_[cell(sat, col)];
+    if (index < 0) {
+        return;
+    }
+    if (compressed_) {
+        mesh_sets_[index].orInto(bits);
+        return;
+    }
+    const uint64_t* mesh = mesh_pool_.data() + static_cast<size_t>(index) * words_;
+    for (int w = 0; w < words_; ++w) {
+        bits[w] |= mesh[w];
+    }
+}
+
+void UniqueCoverage::finalize() {
+    std::vector<int> depth(static_cast<size_t>(words_) * 64, 0);
+    for (int sat = 0; sat < rows_; ++sat) {
+        for (int col = 0; col < cols_; ++col) {
+            forEachWord(sat, col, [&depth](int w, uint64_t bits) {
+                for (; bits != 0; bits &= bits - 1) {
+                    depth[static_cast<size_t>(w) * 64 + popcount64((bits & (~bits + 1)) - 1)]++;
+                }
+            });
+        }
+    }
+    max_depth_ = depth.empty() ? 0 : *std::max_element(depth.begin(), depth.end());
+}
+
+int UniqueCoverage::covered(const std::vector<std::vector<int>>& solution) const {
+    if (compressed_) {
+        std::vector<const MeshContainer*> sets;
+        for (int sat = 0; sat < rows_; ++sat) {
+            const auto& row = solution[sat];
+            for (int col = 0; col < cols_; ++col) {
+                int index = row[col] == 1 ? mesh_index_[cell(sat, col)] : -1;
+                if (index >= 0) {
+                    sets.push_back(&mesh_sets_[index]);
+                }
+            }
+        }
+        return MeshContainer::unionCardinality(sets.data(), static_cast<int>(sets.size()));
+    }
+
+    std::vector<const uint64_t*> meshes;
+    meshes.reserve(mesh_count_);
+    for (int sat = 0; sat < rows_; ++sat) {
+        const auto& row = solution[sat];
+        for (int col = 0; col < cols_; ++col) {
+            int index = row[col] == 1 ? mesh_index_[cell(sat, col)] : -1;
+            if (index >= 0) {
+                meshes.push_back(mesh_pool_.data() + static_cast<size_t>(index) * words_);
+            }
+        }
+    }
+    if (meshes.empty()) {
+        return 0;
+    }
+
+    // 每次把 4 个网格并入累加位图，减少累加位图的读写次数
+    std::vector<uint64_t> any(words_, 0);
+    uint64_t* acc = any.data();
+    size_t k = 0;
+    for (; k + 4 <= meshes.size(); k += 4) {
+        const uint64_t* a = meshes[k];
+        const uint64_t* b = meshes[k + 1];
+        const uint64_t* c = meshes[k + 2];
+        const uint64_t* d = meshes[k + 3];
+        for (int w = 0; w < words_; ++w) {
+            acc[w] |= a[w] | b[w] | c[w] | d[w];
+        }
+    }
+    for (; k < meshes.size(); ++k) {
+        for (int w = 0; w < words_; ++w) {
+            acc[w] |= meshes[k][w];
+        }
+    }
+
+    int count = 0;
+    for (uint64_t bits : any) {
+        count += popcount64(bits);
+    }
+    return count;
+}
+
+UniqueCoverage::Counter::Counter(const UniqueCoverage& model) : model_(&model) {
+    // 计数最大为 maxDepth，需要能表示它的位数
+    planes_ = 1;
+    while ((1 << planes_) <= model.max_depth_) {
+        planes_++;
+    }
+    counts_.assign(static_cast<size_t>(model.words_) * planes_, 0);
+}
+
+void UniqueCoverage::Counter::clear() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    covered_ = 0;
+}
+
+void UniqueCoverage::Counter::assign(const std::vector<std::vector<int>>& solution) {
+    clear();
+    for (int col = 0; col < model_->cols_; ++col) {
+        for (int sat = 0; sat < model_->rows_; ++sat) {
+            if (solution[sat][col] == 1) {
+                add(sat, col);
+            }
+        }
+    }
+}
+
+void UniqueCoverage::Counter::add(int sat, int col) {
+    model_->forEachWord(sat, col, [this](int w, uint64_t carry) {
+        uint64_t* planes = counts_.data() + static_cast<size_t>(w) * planes_;
+
+        uint64_t nonzero = 0;
+        for (int b = 0; b < planes_; ++b) {
+            nonzero |= planes[b];
+        }
+        covered_ += popcount64(carry & ~nonzero);
+
+        // 逐平面进位加 1
+        for (int b = 0; b < planes_ && carry != 0; ++b) {
+            uint64_t next = planes[b] & carry;
+            planes[b] ^= carry;
+            carry = next;
+        }
+    });
+}
+
+void UniqueCoverage::Counter::remove(int sat, int col) {
+    model_->forEachWord(sat, col, [this](int w, uint64_t bits) {
+        uint64_t borrow = bits;
+        uint64_t* planes = counts_.data() + static_cast<size_t>(w) * planes_;
+
+        // 逐平面借位减 1
+        for (int b = 0; b < planes_ && borrow != 0; ++b) {
+            uint64_t next = ~planes[b] & borrow;
+            planes[b] ^= borrow;
+            borrow = next;
+        }
+
+        uint64_t nonzero = 0;
+        for (int b = 0; b < planes_; ++b) {
+            nonzero |= planes[b];
+        }
+        covered_ -= popcount64(bits & ~nonzero);
+    });
+}
+
+int UniqueCoverage::Counter::gain(int sat, int col) const {
+    int count = 0;
+    model_->forEachWord(sat, col, [&](int w, uint64_t bits) {
+        const uint64_t* planes = counts_.data() + static_cast<size_t>(w) * planes_;
+        uint64_t nonzero = 0;
+        for (int b = 0; b < planes_; ++b) {
+            nonzero |= planes[b];
+        }
+        count += popcount64(bits & ~nonzero);
+    });
+    return count;
+}
+
+int UniqueCoverage::Counter::loss(int sat, int col) const {
+    int count = 0;
+    model_->forEachWord(sat, col, [&](int w, uint64_t bits) {
+        const uint64_t* planes = counts_.data() + static_cast<size_t>(w) * planes_;
+        // 计数恰为 1：最低平面为 1，其余平面为 0
+        uint64_t high = 0;
+        for (int b = 1; b < planes_; ++b) {
+            high |= planes[b];
+        }
+        count += popcount64(bits & planes[0] & ~high);
+    });
+    return count;
+}
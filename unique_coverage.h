@@ -0,0 +1,107 @@
+#pragma once
+// unique_coverage.h
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include "mesh_container.h"
+
+// 整个时域的去重覆盖：方案中所有开机 (卫星, 列) 的网格取并集后覆盖的网格点占 q 的比例
+// 与逐列累加的覆盖率不同，同一网格点被不同时间、不同卫星重复观测只计一次
+// 需要每个可见 (卫星, 列) 的网格，每个问题构建一次
+// 稠密存储时每个网格占 words() 个字（100 万网格点、5000 个可见单元约 625 MB），
+// 因此网格点数不少于一个压缩块时默认保留 MeshContainer，计数与并集逐块进行
+class UniqueCoverage {
+public:
+    // 网格的存储方式，含义与 PackedCoverage::MeshStorage 相同：Auto 在网格点数不少于 65536 时选 Compressed
+    enum class MeshStorage { Dense, Compressed, Auto };
+
+    // 需在 reset 之前或第一个 setMesh 之前设置
+    void setMeshStorage(MeshStorage storage);
+    bool compressed() const { return compressed_; }
+
+    void reset(int rows, int cols, int q);
+    void setMesh(int sat, int col, const MeshContainer& mesh);
+    // 统计单个网格点最多被多少个单元覆盖，决定计数器的位平面数
+    void finalize();
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int q() const { return q_; }
+    int words() const { return words_; }
+    int meshCount() const { return mesh_count_; }
+    // 网格数据占用的字节数
+    size_t meshBytes() const;
+
+    bool hasMesh(int sat, int col) const { return mesh_index_[cell(sat, col)] >= 0; }
+    // 把单元的网格按位或到 words() 个字的位图上；没有网格时不做任何事
+    void orMesh(int sat, int col, uint64_t* bits) const;
+    // 按字号升序给出单元网格的非零字：visit(word, bits)；没有网格时不调用
+    template <typename Visit>
+    void forEachWord(int sat, int col, Visit&& visit) const {
+        int index = mesh_index_[cell(sat, col)];
+        if (index < 0) {
+            return;
+        }
+        if (compressed_) {
+            mesh_sets_[index].forEachWord(visit);
+            return;
+        }
+        const uint64_t* mesh = mesh_pool_.data() + static_cast<size_t>(index) * words_;
+        for (int w = 0; w < words_; ++w) {
+            if (mesh[w] != 0) visit(w, mesh[w]);
+        }
+    }
+    // 单个网格点被覆盖的最多次数（所有单元都开机时）
+    int maxDepth() const { return max_depth_; }
+
+    // 全量计算：开机单元的网格按位或后计数，稠密存储时代价为 开机单元数 x words()，压缩存储时逐块求并集
+    int covered(const std::vector<std::vector<int>>& solution) const;
+    double fraction(const std::vector<std::vector<int>>& solution) const {
+        return q_ > 0 ? static_cast<double>(covered(solution)) / q_ : 0.0;
+    }
+
+    // 增量维护：记录每个网格点被多少个开机单元覆盖，计数按位切片存放（每字 planes 个平面，第 b 个平面是计数的第 b 位），
+    // 开关一个单元只需对其网格的非零字做一次逐字的进位加 / 借位减，代价为 非零字数 x 平面数
+    class Counter {
+    public:
+        explicit Counter(const UniqueCoverage& model);
+
+        void clear();
+        // 从方案重建计数（所有开机且有网格的单元）
+        void assign(const std::vector<std::vector<int>>& solution);
+        // 单元开机 / 关机；没有网格的单元不影响计数
+        void add(int sat, int col);
+        void remove(int sat, int col);
+
+        int covered() const { return covered_; }
+        double fraction() const { return model_->q_ > 0 ? static_cast<double>(covered_) / model_->q_ : 0.0; }
+        // 单元（当前关机）开机后新增的覆盖点数
+        int gain(int sat, int col) const;
+        // 单元（当前开机）关机后失去的覆盖点数，即只被它覆盖的点
+        int loss(int sat, int col) const;
+
+    private:
+        const UniqueCoverage* model_;
+        int planes_;
+        std::vector<uint64_t> counts_;  // [字][平面]
+        int covered_ = 0;
+    };
+
+private:
+    size_t cell(int sat, int col) const { return static_cast<size_t>(col) * rows_ + sat; }
+
+    int rows_ = 0;
+    int cols_ = 0;
+    int q_ = 0;
+    int words_ = 0;
+    int max_depth_ = 0;
+    int mesh_count_ = 0;
+
+    MeshStorage storage_ = MeshStorage::Auto;
+    bool compressed_ = false;
+    // [列][卫星] 的网格序号，-1 表示无网格；稠密存储时网格在 mesh_pool_ 中从 序号 x words() 开始，压缩存储时为 mesh_sets_ 下标
+    std::vector<int> mesh_index_;
+    std::vector<uint64_t> mesh_pool_;
+    std::vector<MeshContainer> mesh_sets_;
+};